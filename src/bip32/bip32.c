@@ -0,0 +1,285 @@
+//
+//  bip32.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#include "bip32.h"
+
+#include "../hmac/hash.h"
+#include "../hmac/scalar.h"
+#include "../hmac/sha512.h"
+
+#include <string.h>
+
+int bip32_from_seed(bip32_node *node, const uint8_t *seed, size_t seed_size) {
+	static const uint8_t key[12] = {'B', 'i', 't', 'c', 'o', 'i', 'n', ' ', 's', 'e', 'e', 'd'};
+	secp256k1_hmac_sha512 hmac;
+	uint8_t I[64];
+	int ok;
+
+	if (seed_size < 16 || seed_size > 64) {
+		return 0;
+	}
+
+	secp256k1_hmac_sha512_initialize(&hmac, key, sizeof(key));
+	secp256k1_hmac_sha512_write(&hmac, seed, seed_size);
+	secp256k1_hmac_sha512_finalize(&hmac, I);
+
+	/* uECC_compute_public_key_batch() rejects a master key of 0 or >= n. */
+	ok = uECC_compute_public_key_batch(I, 1, 1, node->public_key, 0, uECC_secp256k1());
+	if (ok) {
+		memcpy(node->private_key, I, 32);
+		memcpy(node->chain_code, I + 32, 32);
+		node->has_private  = 1;
+		node->depth		   = 0;
+		node->child_number = 0;
+	}
+	secp256k1_memclear(I, sizeof(I));
+	secp256k1_memclear(&hmac, sizeof(hmac));
+	return ok;
+}
+
+void bip32_neuter(bip32_node *pub, const bip32_node *node) {
+	if (pub != node) {
+		memcpy(pub, node, sizeof(*pub));
+	}
+	secp256k1_memclear(pub->private_key, sizeof(pub->private_key));
+	pub->has_private = 0;
+}
+
+/* Computes I = HMAC-SHA512(chain code, data || index) from the parent's HMAC key schedule. */
+static void bip32_hmac_child(
+	uint8_t *I, const secp256k1_hmac_sha512 *key_schedule, const bip32_node *parent, uint32_t index
+) {
+	secp256k1_hmac_sha512 hmac = *key_schedule;
+	uint8_t data[37];
+
+	if (index & BIP32_HARDENED) {
+		data[0] = 0x00;
+		memcpy(data + 1, parent->private_key, 32);
+	} else {
+		memcpy(data, parent->public_key, 33);
+	}
+	data[33] = (uint8_t)(index >> 24);
+	data[34] = (uint8_t)(index >> 16);
+	data[35] = (uint8_t)(index >> 8);
+	data[36] = (uint8_t)index;
+
+	secp256k1_hmac_sha512_write(&hmac, data, sizeof(data));
+	secp256k1_hmac_sha512_finalize(&hmac, I);
+	secp256k1_memclear(data, sizeof(data));
+	secp256k1_memclear(&hmac, sizeof(hmac));
+}
+
+/* Computes the compressed public keys parent + tweaks[i] * G for count <= uECC_BATCH_SIZE tweaks,
+   clearing ok[i] for sums at infinity, and for every entry if parent_key is not a valid key. Both
+   the k * G and the final additions share one field inversion across all entries. */
+static void bip32_add_tweaks(
+	uint8_t (*public_keys)[33],
+	const uint8_t *parent_key,
+	uint8_t (*tweaks)[32],
+	uint8_t *ok,
+	unsigned count,
+	uECC_Curve curve
+) {
+	uECC_word_t points[uECC_BATCH_SIZE][uECC_MAX_WORDS * 2];
+	uECC_word_t z_num[uECC_BATCH_SIZE][uECC_MAX_WORDS];
+	uECC_word_t z_den[uECC_BATCH_SIZE][uECC_MAX_WORDS];
+	uECC_word_t parent[uECC_MAX_WORDS * 2];
+	uECC_word_t px[uECC_MAX_WORDS], py[uECC_MAX_WORDS];
+	uECC_word_t k[uECC_MAX_WORDS], tmp[uECC_MAX_WORDS];
+	uECC_word_t *p2[2] = {k, tmp};
+	uint8_t raw[64];
+	unsigned i;
+	wordcount_t num_words = curve->num_words;
+
+	if (!uECC_decompress(parent_key, raw, curve)) {
+		memset(ok, 0, count);
+		return;
+	}
+	uECC_vli_bytesToNative(parent, raw, 32);
+	uECC_vli_bytesToNative(parent + num_words, raw + 32, 32);
+
+	for (i = 0; i < count; ++i) {
+		uECC_word_t carry;
+
+		uECC_vli_bytesToNative(k, tweaks[i], 32);
+		if (!ok[i]) {
+			uECC_vli_clear(k, num_words);
+			k[0] = 2;
+		}
+		/* The ladder cannot produce G or -G itself. */
+		if (EccPoint_mult_G_edge(points[i], k, curve)) {
+			uECC_vli_clear(z_num[i], num_words);
+			uECC_vli_clear(z_den[i], num_words);
+			z_num[i][0] = 1;
+			z_den[i][0] = 1;
+			continue;
+		}
+		carry = regularize_k(k, k, tmp, curve);
+		EccPoint_mult_deferred(points[i], z_num[i], z_den[i], curve->G, p2[!carry], 0, curve->num_n_bits + 1, curve);
+	}
+	EccPoint_apply_z_batch(points, z_num, z_den, count, curve);
+
+	/* Both points are affine, so they already share Z = 1 and one co-Z addition gives the sum with
+	   Z = x2 - x1. tweak * G == parent is doubled instead, also in Jacobian coordinates. */
+	for (i = 0; i < count; ++i) {
+		uECC_vli_set(px, parent, num_words);
+		uECC_vli_set(py, parent + num_words, num_words);
+		uECC_vli_modSub(z_den[i], points[i], px, curve->p, num_words);
+		if (uECC_vli_isZero(z_den[i], num_words)) {
+			if (!uECC_vli_equal(points[i] + num_words, py, num_words)) {
+				ok[i] = 0; /* tweak * G == -parent: the sum is infinity */
+			}
+			z_den[i][0] = 1;
+			curve->double_jacobian(points[i], points[i] + num_words, z_den[i], curve);
+			continue;
+		}
+		XYcZ_add(px, py, points[i], points[i] + num_words, curve);
+	}
+	uECC_vli_modInv_batch_fast(z_den, count, curve);
+
+	for (i = 0; i < count; ++i) {
+		if (ok[i]) {
+			apply_z(points[i], points[i] + num_words, z_den[i], curve);
+			uECC_vli_nativeToBytes(raw, 32, points[i]);
+			uECC_vli_nativeToBytes(raw + 32, 32, points[i] + num_words);
+			uECC_compress(raw, public_keys[i], curve);
+		}
+	}
+}
+
+int bip32_derive_range(bip32_node *children, const bip32_node *parent, uint32_t first, unsigned count, uint8_t *valid) {
+	uECC_Curve curve = uECC_secp256k1();
+	secp256k1_hmac_sha512 key_schedule;
+	secp256k1_scalar t, k;
+	bip32_node par;
+	uint8_t I[64];
+	uint8_t keys[uECC_BATCH_SIZE][32];
+	uint8_t public_keys[uECC_BATCH_SIZE][33];
+	uint8_t ok[uECC_BATCH_SIZE];
+	uint64_t last = (uint64_t)first + count - 1;
+	unsigned done, i;
+	int overflow;
+	int ret = 1;
+
+	if (count == 0) {
+		return 1;
+	}
+	if (last > UINT32_MAX || ((first ^ (uint32_t)last) & BIP32_HARDENED)) {
+		return 0;
+	}
+	if ((first & BIP32_HARDENED) && !parent->has_private) {
+		return 0;
+	}
+
+	/* children may overlap parent. */
+	memcpy(&par, parent, sizeof(par));
+	secp256k1_hmac_sha512_initialize(&key_schedule, par.chain_code, sizeof(par.chain_code));
+	if (par.has_private) {
+		secp256k1_scalar_set_b32(&k, par.private_key, NULL);
+	}
+
+	for (done = 0; done < count; done += uECC_BATCH_SIZE) {
+		unsigned chunk = count - done < uECC_BATCH_SIZE ? count - done : uECC_BATCH_SIZE;
+
+		/* keys receives the child private keys, or the tweaks I_L for public derivation. */
+		for (i = 0; i < chunk; ++i) {
+			bip32_node *child = &children[done + i];
+			uint32_t index	  = first + done + i;
+
+			bip32_hmac_child(I, &key_schedule, &par, index);
+			secp256k1_scalar_set_b32(&t, I, &overflow);
+			ok[i] = !overflow;
+			if (par.has_private) {
+				secp256k1_scalar_add(&t, &t, &k);
+				ok[i] &= !secp256k1_scalar_is_zero(&t);
+			}
+			secp256k1_scalar_get_b32(keys[i], &t);
+
+			memcpy(child->chain_code, I + 32, 32);
+			child->has_private	= par.has_private;
+			child->depth		= (uint8_t)(par.depth + 1);
+			child->child_number = index;
+		}
+
+		if (par.has_private) {
+			uECC_compute_public_key_batch(keys[0], chunk, 1, public_keys[0], 0, curve);
+		} else {
+			bip32_add_tweaks(public_keys, par.public_key, keys, ok, chunk, curve);
+		}
+
+		for (i = 0; i < chunk; ++i) {
+			bip32_node *child = &children[done + i];
+			if (ok[i]) {
+				memcpy(child->public_key, public_keys[i], 33);
+				memcpy(child->private_key, par.has_private ? keys[i] : par.private_key, 32);
+			} else {
+				secp256k1_memclear(child->private_key, 32);
+				memset(child->public_key, 0, 33);
+			}
+			if (valid) {
+				valid[done + i] = ok[i];
+			}
+			ret &= ok[i];
+		}
+	}
+
+	secp256k1_memclear(&par, sizeof(par));
+	secp256k1_memclear(&key_schedule, sizeof(key_schedule));
+	secp256k1_memclear(I, sizeof(I));
+	secp256k1_memclear(keys, sizeof(keys));
+	secp256k1_scalar_clear(&t);
+	secp256k1_scalar_clear(&k);
+	return ret;
+}
+
+int bip32_derive_child(bip32_node *child, const bip32_node *parent, uint32_t index) {
+	return bip32_derive_range(child, parent, index, 1, 0);
+}
+
+int bip32_derive_path(bip32_node *node, const bip32_node *root, const char *path) {
+	bip32_node current;
+	const char *p = path;
+	int ok		  = 1;
+
+	memcpy(&current, root, sizeof(current));
+	if (*p == 'm' || *p == 'M') {
+		++p;
+		if (*p == '/') {
+			++p;
+			ok = *p != 0;
+		} else {
+			ok = *p == 0;
+		}
+	}
+
+	while (ok && *p) {
+		uint64_t index = 0;
+		int digits	   = 0;
+		while (ok && *p >= '0' && *p <= '9') {
+			index = index * 10 + (uint64_t)(*p++ - '0');
+			ok	  = index < BIP32_HARDENED;
+			++digits;
+		}
+		if (*p == '\'' || *p == 'h' || *p == 'H') {
+			index |= BIP32_HARDENED;
+			++p;
+		}
+		if (*p == '/') {
+			++p;
+			ok = ok && *p != 0;
+		} else if (*p) {
+			ok = 0;
+		}
+		ok = ok && digits > 0 && bip32_derive_child(&current, &current, (uint32_t)index);
+	}
+
+	if (ok) {
+		memcpy(node, &current, sizeof(current));
+	}
+	secp256k1_memclear(&current, sizeof(current));
+	return ok;
+}
@@ -0,0 +1,54 @@
+//
+//  bip32.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#ifndef bip32_h
+#define bip32_h
+
+#include "../ecc/core.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Child indexes at or above this value are hardened. */
+#define BIP32_HARDENED 0x80000000u
+
+/* A BIP32 extended key on secp256k1. */
+typedef struct {
+	uint8_t chain_code[32];
+	uint8_t private_key[32]; /* zero for public-only keys */
+	uint8_t public_key[33];	 /* compressed */
+	uint8_t has_private;
+	uint8_t depth;
+	uint32_t child_number;
+} bip32_node;
+
+/* Computes the master key from a seed of 16 to 64 bytes. Returns 1 on success, 0 if the seed has
+   the wrong size or produces an invalid key. */
+int bip32_from_seed(bip32_node *node, const uint8_t *seed, size_t seed_size);
+
+/* Copies node without its private key. */
+void bip32_neuter(bip32_node *pub, const bip32_node *node);
+
+/* Derives child index of parent: CKDpriv if parent has a private key, CKDpub otherwise, which
+   cannot derive hardened children. Returns 1 on success, 0 if the child is invalid (BIP32 then
+   skips to the next index) or cannot be derived. child may be parent. */
+int bip32_derive_child(bip32_node *child, const bip32_node *parent, uint32_t index);
+
+/* Derives the children first, first + 1, ..., first + count - 1 of parent, as
+   bip32_derive_child(). The HMAC-SHA512 key schedule of the parent chain code is computed once,
+   and the affine conversions of the child public keys share one field inversion per
+   uECC_BATCH_SIZE children. valid, if not NULL, receives 1 for every derived child and 0 for every
+   invalid one. Returns 1 if every child was derived, 0 otherwise. The range must not wrap past
+   index 2^32 - 1 or cross BIP32_HARDENED. */
+int bip32_derive_range(bip32_node *children, const bip32_node *parent, uint32_t first, unsigned count, uint8_t *valid);
+
+/* Derives the key at path, such as "m/44'/60'/0'/0/7", from root. Hardened levels are marked
+   with ', h or H. A path that does not start with "m" is relative to root. Returns 1 on success,
+   0 if the path is malformed or a level cannot be derived. */
+int bip32_derive_path(bip32_node *node, const bip32_node *root, const char *path);
+
+#endif /* bip32_h */
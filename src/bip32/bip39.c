@@ -0,0 +1,73 @@
+//
+//  bip39.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#include "bip39.h"
+#include "../hmac/hash.h"
+#include "../hmac/pbkdf2.h"
+
+#include <string.h>
+
+#define BIP39_ITERATIONS 2048
+#define BIP39_SALT_PREFIX "mnemonic"
+#define BIP39_SALT_MAX (sizeof(BIP39_SALT_PREFIX) - 1 + BIP39_PASSPHRASE_MAX)
+
+static int bip39_salt(uint8_t *salt, size_t *salt_size, const char *passphrase) {
+	size_t size = passphrase ? strlen(passphrase) : 0;
+	if (size > BIP39_PASSPHRASE_MAX) {
+		return 0;
+	}
+	memcpy(salt, BIP39_SALT_PREFIX, sizeof(BIP39_SALT_PREFIX) - 1);
+	if (size) {
+		memcpy(salt + sizeof(BIP39_SALT_PREFIX) - 1, passphrase, size);
+	}
+	*salt_size = sizeof(BIP39_SALT_PREFIX) - 1 + size;
+	return 1;
+}
+
+int bip39_mnemonic_to_seed(uint8_t *seed, const char *mnemonic, const char *passphrase) {
+	uint8_t salt[BIP39_SALT_MAX];
+	size_t salt_size;
+
+	if (!bip39_salt(salt, &salt_size, passphrase)) {
+		return 0;
+	}
+	pbkdf2_hmac_sha512((const uint8_t *)mnemonic, strlen(mnemonic), salt, salt_size, BIP39_ITERATIONS, seed, 64);
+	secp256k1_memclear(salt, sizeof(salt));
+	return 1;
+}
+
+int bip39_mnemonic_to_seed_multi(
+	uint8_t *seeds, const char *const *mnemonics, const char *const *passphrases, unsigned count
+) {
+	uint8_t salts[PBKDF2_LANES][BIP39_SALT_MAX];
+	const uint8_t *password_ptrs[PBKDF2_LANES];
+	const uint8_t *salt_ptrs[PBKDF2_LANES];
+	size_t password_sizes[PBKDF2_LANES];
+	size_t salt_sizes[PBKDF2_LANES];
+	unsigned done, lanes, l;
+
+	for (l = 0; l < count; ++l) {
+		if (passphrases && passphrases[l] && strlen(passphrases[l]) > BIP39_PASSPHRASE_MAX) {
+			return 0;
+		}
+	}
+
+	for (done = 0; done < count; done += lanes) {
+		lanes = count - done < PBKDF2_LANES ? count - done : PBKDF2_LANES;
+		for (l = 0; l < lanes; ++l) {
+			bip39_salt(salts[l], &salt_sizes[l], passphrases ? passphrases[done + l] : NULL);
+			salt_ptrs[l]	  = salts[l];
+			password_ptrs[l]  = (const uint8_t *)mnemonics[done + l];
+			password_sizes[l] = strlen(mnemonics[done + l]);
+		}
+		pbkdf2_hmac_sha512_multi(
+			password_ptrs, password_sizes, salt_ptrs, salt_sizes, lanes, BIP39_ITERATIONS, seeds + 64 * done, 64
+		);
+	}
+	secp256k1_memclear(salts, sizeof(salts));
+	return 1;
+}
@@ -0,0 +1,30 @@
+//
+//  bip39.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#ifndef bip39_h
+#define bip39_h
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Longest passphrase, in bytes, that the seed functions accept. */
+#define BIP39_PASSPHRASE_MAX 256
+
+/* Computes the 64-byte BIP39 seed of mnemonic and passphrase (NULL for none): 2048 iterations of
+   PBKDF2-HMAC-SHA512 salted with "mnemonic" || passphrase. Both strings must already be UTF-8 in
+   NFKD form; the mnemonic is not checked against a word list. Returns 1 on success, 0 if the
+   passphrase is longer than BIP39_PASSPHRASE_MAX. */
+int bip39_mnemonic_to_seed(uint8_t *seed, const char *mnemonic, const char *passphrase);
+
+/* Computes count seeds as bip39_mnemonic_to_seed(), PBKDF2_LANES at a time. seeds receives
+   64 * count bytes. passphrases may be NULL, as may any of its elements. Returns 1 on success, 0 if
+   any passphrase is too long, in which case no seed is computed. */
+int bip39_mnemonic_to_seed_multi(
+	uint8_t *seeds, const char *const *mnemonics, const char *const *passphrases, unsigned count
+);
+
+#endif /* bip39_h */
@@ -11,6 +11,7 @@
 #ifndef common_h
 #define common_h
 
+#include <stddef.h>
 #include <stdint.h>
 
 /* uECC_WORD_SIZE */
@@ -55,7 +56,7 @@ faster somewhat faster, but increases the code size. */
 #define uECC_SUPPORTS_secp224r1 0
 // #endif
 // #ifndef uECC_SUPPORTS_secp256r1
-#define uECC_SUPPORTS_secp256r1 0
+#define uECC_SUPPORTS_secp256r1 1
 // #endif
 // #ifndef uECC_SUPPORTS_secp256k1
 #define uECC_SUPPORTS_secp256k1 1
@@ -148,6 +149,10 @@ typedef struct {
 
 #define uECC_MAX_WORDS 4
 
+/* Number of independent operations the batch functions process together. Batched inversions keep
+   their intermediate products on the stack, so this bounds stack usage, not the length of a batch. */
+#define uECC_BATCH_SIZE 32
+
 #define BITS_TO_WORDS(num_bits) ((num_bits + ((uECC_WORD_SIZE * 8) - 1)) / (uECC_WORD_SIZE * 8))
 #define BITS_TO_BYTES(num_bits) ((num_bits + 7) / 8)
 
@@ -10,6 +10,10 @@
 
 #include "core.h"
 
+#include "../hmac/hash.h"
+
+#include <string.h>
+
 int uECC_curve_private_key_size(uECC_Curve curve) { return BITS_TO_BYTES(curve->num_n_bits); }
 
 int uECC_curve_public_key_size(uECC_Curve curve) { return 2 * curve->num_bytes; }
@@ -57,6 +61,168 @@ int uECC_shared_secret(const uint8_t *public_key, const uint8_t *private_key, ui
 	return !EccPoint_isZero(_public, curve);
 }
 
+/* Reads a peer key for uECC_ecdh_batch() into point, validating it. */
+static int ecdh_parse_public_key(uECC_word_t *point, const uint8_t *public_key, unsigned key_size, uECC_Curve curve) {
+	uint8_t compressed[1 + uECC_MAX_WORDS * uECC_WORD_SIZE];
+	uint8_t raw[uECC_MAX_WORDS * 2 * uECC_WORD_SIZE];
+	unsigned num_bytes = (unsigned)curve->num_bytes;
+
+	if (key_size == num_bytes) {
+		/* x(k * P) == x(k * -P), so either root will do. */
+		compressed[0] = 0x02;
+		memcpy(compressed + 1, public_key, num_bytes);
+		public_key = compressed;
+		key_size   = num_bytes + 1;
+	}
+	if (key_size == num_bytes + 1) {
+		if (!uECC_decompress(public_key, raw, curve)) {
+			return 0;
+		}
+		public_key = raw;
+	} else if (key_size != 2 * num_bytes) {
+		return 0;
+	}
+
+	uECC_vli_bytesToNative(point, public_key, num_bytes);
+	uECC_vli_bytesToNative(point + curve->num_words, public_key + num_bytes, num_bytes);
+	return public_key == raw || uECC_valid_point(point, curve);
+}
+
+/* Writes the secret for the affine point as selected by mode. */
+static void ecdh_finish(uint8_t *secret, const uECC_word_t *point, int mode, uECC_Curve curve) {
+	uint8_t encoded[1 + uECC_MAX_WORDS * uECC_WORD_SIZE];
+	secp256k1_sha256 sha;
+
+	encoded[0] = 0x02 | (uint8_t)(point[curve->num_words] & 0x01);
+	uECC_vli_nativeToBytes(encoded + 1, curve->num_bytes, point);
+	switch (mode) {
+	case uECC_ECDH_X:
+		memcpy(secret, encoded + 1, curve->num_bytes);
+		break;
+	case uECC_ECDH_SHA256_X:
+		secp256k1_sha256_initialize(&sha);
+		secp256k1_sha256_write(&sha, encoded + 1, curve->num_bytes);
+		secp256k1_sha256_finalize(&sha, secret);
+		break;
+	default: /* uECC_ECDH_SHA256_COMPRESSED */
+		secp256k1_sha256_initialize(&sha);
+		secp256k1_sha256_write(&sha, encoded, 1 + curve->num_bytes);
+		secp256k1_sha256_finalize(&sha, secret);
+		break;
+	}
+	memset(encoded, 0, sizeof(encoded));
+}
+
+int uECC_ecdh_batch(
+	const uint8_t *public_keys,
+	unsigned key_size,
+	unsigned count,
+	const uint8_t *private_key,
+	int mode,
+	uint8_t *secrets,
+	uint8_t *valid,
+	uECC_Curve curve
+) {
+	uECC_word_t points[uECC_BATCH_SIZE][uECC_MAX_WORDS * 2];
+	uECC_word_t z_num[uECC_BATCH_SIZE][uECC_MAX_WORDS];
+	uECC_word_t z_den[uECC_BATCH_SIZE][uECC_MAX_WORDS];
+	uECC_word_t _private[uECC_MAX_WORDS];
+	uECC_word_t tmp[uECC_MAX_WORDS];
+	uECC_word_t *p2[2] = {_private, tmp};
+	uECC_word_t *k;
+	uint8_t ok[uECC_BATCH_SIZE];
+	unsigned done, i;
+	unsigned secret_size;
+	int ret					= 1;
+	int xz					= mode & uECC_ECDH_XZ_LADDER;
+	wordcount_t num_words	= curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+	mode &= ~uECC_ECDH_XZ_LADDER;
+	if (mode != uECC_ECDH_X && mode != uECC_ECDH_SHA256_X && mode != uECC_ECDH_SHA256_COMPRESSED) {
+		return 0;
+	}
+	/* The x-only ladder has no y to encode. */
+	if (xz && mode == uECC_ECDH_SHA256_COMPRESSED) {
+		return 0;
+	}
+	secret_size = mode == uECC_ECDH_X ? (unsigned)curve->num_bytes : 32;
+	/* An x-only key fixes the point only up to sign, which the compressed encoding would expose. */
+	if (mode == uECC_ECDH_SHA256_COMPRESSED && key_size == (unsigned)curve->num_bytes) {
+		return 0;
+	}
+
+	_private[num_n_words - 1] = 0;
+	uECC_vli_bytesToNative(_private, private_key, BITS_TO_BYTES(curve->num_n_bits));
+	if (uECC_vli_isZero(_private, num_n_words) || uECC_vli_cmp(curve->n, _private, num_n_words) != 1) {
+		uECC_vli_clear(_private, num_n_words);
+		return 0;
+	}
+
+	/* Regularize the private key once for all peers. */
+	k = p2[!regularize_k(_private, _private, tmp, curve)];
+
+	for (done = 0; done < count; done += uECC_BATCH_SIZE) {
+		unsigned chunk = count - done < uECC_BATCH_SIZE ? count - done : uECC_BATCH_SIZE;
+
+		/* Invalid keys are replaced by G so that every entry joins the shared inversion. */
+		for (i = 0; i < chunk; ++i) {
+			const uint8_t *public_key = public_keys + (size_t)(done + i) * key_size;
+			ok[i]					  = (uint8_t)ecdh_parse_public_key(points[i], public_key, key_size, curve);
+			if (!ok[i]) {
+				uECC_vli_set(points[i], curve->G, num_words * 2);
+			}
+			if (xz) {
+				/* Never at infinity: valid points have order n and 0 < k mod n. */
+				EccPoint_mult_xz(points[i], z_den[i], points[i], k, curve->num_n_bits + 1, curve);
+				continue;
+			}
+			EccPoint_mult_deferred(points[i], z_num[i], z_den[i], points[i], k, 0, curve->num_n_bits + 1, curve);
+			if (uECC_vli_isZero(z_den[i], num_words)) {
+				ok[i]		= 0; /* k = +-1 mod the order of the point, which the ladder cannot handle */
+				z_den[i][0] = 1;
+			}
+		}
+		if (xz) {
+			uECC_vli_modInv_batch_fast(z_den, chunk, curve);
+			for (i = 0; i < chunk; ++i) {
+				uECC_vli_modMult_fast(points[i], points[i], z_den[i], curve); /* x = X / Z */
+			}
+		} else {
+			EccPoint_apply_z_batch(points, z_num, z_den, chunk, curve);
+		}
+
+		for (i = 0; i < chunk; ++i) {
+			uint8_t *secret = secrets + (size_t)(done + i) * secret_size;
+			if (ok[i]) {
+				ecdh_finish(secret, points[i], mode, curve);
+			} else {
+				memset(secret, 0, secret_size);
+			}
+			if (valid) {
+				valid[done + i] = ok[i];
+			}
+			ret &= ok[i];
+		}
+	}
+
+	uECC_vli_clear(_private, num_n_words);
+	uECC_vli_clear(tmp, num_n_words);
+	memset(points, 0, sizeof(points));
+	return ret;
+}
+
+int uECC_ecdh(
+	const uint8_t *public_key,
+	unsigned key_size,
+	const uint8_t *private_key,
+	int mode,
+	uint8_t *secret,
+	uECC_Curve curve
+) {
+	return uECC_ecdh_batch(public_key, key_size, 1, private_key, mode, secret, 0, curve);
+}
+
 void uECC_compress(const uint8_t *public_key, uint8_t *compressed, uECC_Curve curve) {
 	wordcount_t i;
 	for (i = 0; i < curve->num_bytes; ++i) {
@@ -66,18 +232,58 @@ void uECC_compress(const uint8_t *public_key, uint8_t *compressed, uECC_Curve cu
 	compressed[0] = 2 + (public_key[curve->num_bytes * 2 - 1] & 0x01);
 }
 
-void uECC_decompress(const uint8_t *compressed, uint8_t *public_key, uECC_Curve curve) {
+int uECC_decompress(const uint8_t *compressed, uint8_t *public_key, uECC_Curve curve) {
 	uECC_word_t point[uECC_MAX_WORDS * 2];
-	uECC_word_t *y = point + curve->num_words;
+	uECC_word_t rhs[uECC_MAX_WORDS];
+	uECC_word_t check[uECC_MAX_WORDS];
+	uECC_word_t *y		  = point + curve->num_words;
+	wordcount_t num_words = curve->num_words;
+
+	if (compressed[0] != 0x02 && compressed[0] != 0x03) {
+		return 0;
+	}
 
 	uECC_vli_bytesToNative(point, compressed + 1, curve->num_bytes);
+	if (uECC_vli_cmp_unsafe(curve->p, point, num_words) != 1) {
+		return 0; /* x must be smaller than p */
+	}
 
-	curve->x_side(y, point, curve);
+	curve->x_side(rhs, point, curve);
+	uECC_vli_set(y, rhs, num_words);
 	curve->mod_sqrt(y, curve);
 
+	/* mod_sqrt() returns garbage when x^3 + ax + b has no root, i.e. x is not on the curve. */
+	uECC_vli_modSquare_fast(check, y, curve);
+	if (!uECC_vli_equal(check, rhs, num_words)) {
+		return 0;
+	}
+
 	if ((y[0] & 0x01) != (compressed[0] & 0x01)) {
-		uECC_vli_sub(y, curve->p, y, curve->num_words);
+		uECC_vli_sub(y, curve->p, y, num_words);
+	}
+
+	uECC_vli_nativeToBytes(public_key, curve->num_bytes, point);
+	uECC_vli_nativeToBytes(public_key + curve->num_bytes, curve->num_bytes, y);
+	return 1;
+}
+
+int uECC_decompress_batch(
+	const uint8_t *compressed, unsigned count, uint8_t *public_keys, uint8_t *valid, uECC_Curve curve
+) {
+	unsigned i;
+	int ret = 1;
+	for (i = 0; i < count; ++i) {
+		uint8_t *public_key = public_keys + (size_t)i * 2 * curve->num_bytes;
+		int ok				= uECC_decompress(compressed + (size_t)i * (curve->num_bytes + 1), public_key, curve);
+		if (!ok) {
+			memset(public_key, 0, 2 * curve->num_bytes);
+		}
+		if (valid) {
+			valid[i] = (uint8_t)ok;
+		}
+		ret &= ok;
 	}
+	return ret;
 }
 
 int uECC_valid_point(const uECC_word_t *point, uECC_Curve curve) {
@@ -113,6 +319,19 @@ int uECC_valid_public_key(const uint8_t *public_key, uECC_Curve curve) {
 	return uECC_valid_point(_public, curve);
 }
 
+int uECC_valid_public_key_batch(const uint8_t *public_keys, unsigned count, uint8_t *valid, uECC_Curve curve) {
+	unsigned i;
+	int ret = 1;
+	for (i = 0; i < count; ++i) {
+		int ok = uECC_valid_public_key(public_keys + (size_t)i * 2 * curve->num_bytes, curve);
+		if (valid) {
+			valid[i] = (uint8_t)ok;
+		}
+		ret &= ok;
+	}
+	return ret;
+}
+
 int uECC_compute_public_key(const uint8_t *private_key, uint8_t *public_key, uECC_Curve curve) {
 	uECC_word_t _private[uECC_MAX_WORDS];
 	uECC_word_t _public[uECC_MAX_WORDS * 2];
@@ -142,6 +361,95 @@ int uECC_compute_public_key(const uint8_t *private_key, uint8_t *public_key, uEC
 	return 1;
 }
 
+int uECC_compute_public_key_batch(
+	const uint8_t *private_keys,
+	unsigned count,
+	int compressed,
+	uint8_t *public_keys,
+	uint8_t *valid,
+	uECC_Curve curve
+) {
+	uECC_word_t points[uECC_BATCH_SIZE][uECC_MAX_WORDS * 2];
+	uECC_word_t z_num[uECC_BATCH_SIZE][uECC_MAX_WORDS];
+	uECC_word_t z_den[uECC_BATCH_SIZE][uECC_MAX_WORDS];
+	uECC_word_t _private[uECC_MAX_WORDS];
+	uECC_word_t tmp[uECC_MAX_WORDS];
+	uECC_word_t *p2[2] = {_private, tmp};
+	uint8_t raw[uECC_MAX_WORDS * 2 * uECC_WORD_SIZE];
+	uint8_t ok[uECC_BATCH_SIZE];
+	unsigned done, i;
+	int ret					= 1;
+	wordcount_t num_words	= curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+	unsigned private_size	= (unsigned)BITS_TO_BYTES(curve->num_n_bits);
+	unsigned public_size	= compressed ? (unsigned)curve->num_bytes + 1 : 2 * (unsigned)curve->num_bytes;
+
+	for (done = 0; done < count; done += uECC_BATCH_SIZE) {
+		unsigned chunk = count - done < uECC_BATCH_SIZE ? count - done : uECC_BATCH_SIZE;
+
+		for (i = 0; i < chunk; ++i) {
+			_private[num_n_words - 1] = 0;
+			uECC_vli_bytesToNative(_private, private_keys + (size_t)(done + i) * private_size, private_size);
+
+			/* Keys outside [1, n-1] are replaced by 2 so that they still join the shared inversion. */
+			ok[i] = !uECC_vli_isZero(_private, num_n_words) && uECC_vli_cmp(curve->n, _private, num_n_words) == 1;
+			if (!ok[i]) {
+				uECC_vli_clear(_private, num_n_words);
+				_private[0] = 2;
+			} else if (EccPoint_mult_G_edge(points[i], _private, curve)) {
+				uECC_vli_clear(z_num[i], num_words);
+				uECC_vli_clear(z_den[i], num_words);
+				z_num[i][0] = 1;
+				z_den[i][0] = 1;
+				continue;
+			}
+
+			/* Regularize the bitcount as EccPoint_compute_public_key() does. */
+			EccPoint_mult_deferred(
+				points[i],
+				z_num[i],
+				z_den[i],
+				curve->G,
+				p2[!regularize_k(_private, _private, tmp, curve)],
+				0,
+				curve->num_n_bits + 1,
+				curve
+			);
+
+			/* Keys 1 and n - 1, which the ladder cannot handle, were taken care of above; a zero
+			   z_den would still spoil the shared inversion. */
+			if (uECC_vli_isZero(z_den[i], num_words)) {
+				ok[i]		= 0;
+				z_den[i][0] = 1;
+			}
+		}
+		EccPoint_apply_z_batch(points, z_num, z_den, chunk, curve);
+
+		for (i = 0; i < chunk; ++i) {
+			uint8_t *public_key = public_keys + (size_t)(done + i) * public_size;
+			if (ok[i]) {
+				uECC_vli_nativeToBytes(raw, curve->num_bytes, points[i]);
+				uECC_vli_nativeToBytes(raw + curve->num_bytes, curve->num_bytes, points[i] + num_words);
+				if (compressed) {
+					uECC_compress(raw, public_key, curve);
+				} else {
+					memcpy(public_key, raw, public_size);
+				}
+			} else {
+				memset(public_key, 0, public_size);
+			}
+			if (valid) {
+				valid[done + i] = ok[i];
+			}
+			ret &= ok[i];
+		}
+	}
+
+	uECC_vli_clear(_private, num_n_words);
+	uECC_vli_clear(tmp, num_n_words);
+	return ret;
+}
+
 /* -------- ECDSA code -------- */
 
 static void bits2int(uECC_word_t *native, const uint8_t *bits, unsigned bits_size, uECC_Curve curve) {
@@ -177,6 +485,69 @@ static void bits2int(uECC_word_t *native, const uint8_t *bits, unsigned bits_siz
 	}
 }
 
+/* Computes s = (e + r*d) / k from p = k*G and k_inv = 1/k, and stores r || s in signature. */
+static int sign_finish(
+	const uECC_word_t *d,
+	const uint8_t *message_hash,
+	unsigned hash_size,
+	const uECC_word_t *p,
+	const uECC_word_t *k_inv,
+	uint8_t *recid,
+	uint8_t *signature,
+	uECC_Curve curve
+) {
+	int high, overflow;
+	uECC_word_t tmp[uECC_MAX_WORDS];
+	uECC_word_t s[uECC_MAX_WORDS];
+	const wordcount_t num_words	  = curve->num_words;
+	const wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+	if (uECC_vli_isZero(p, num_words)) {
+		return 0;
+	}
+
+	/* r = p.x mod n. p.x >= n is negligible on secp256k1 but happens about once in 2^32
+	   signatures on secp256r1; recid then records the overflow for recovery. */
+	s[num_n_words - 1] = 0;
+	uECC_vli_set(s, p, num_words);
+	overflow = uECC_vli_cmp_unsafe(curve->n, s, num_n_words) != 1;
+	if (overflow) {
+		uECC_vli_sub(s, s, curve->n, num_n_words);
+		if (uECC_vli_isZero(s, num_n_words)) {
+			return 0;
+		}
+	}
+
+	if (recid) {
+		*recid = (uint8_t)(uECC_vli_testBit(p + num_words, 0) | (overflow << 1));
+	}
+
+	uECC_vli_nativeToBytes(signature, curve->num_bytes, s); /* store r */
+
+	uECC_vli_modMult(s, d, s, curve->n, num_n_words); /* s = r*d */
+
+	bits2int(tmp, message_hash, hash_size, curve);
+	uECC_vli_modAdd(s, tmp, s, curve->n, num_n_words);	  /* s = e + r*d */
+	uECC_vli_modMult(s, s, k_inv, curve->n, num_n_words); /* s = (e + r*d) / k */
+	if (uECC_vli_numBits(s, num_n_words) > (bitcount_t)curve->num_bytes * 8) {
+		return 0;
+	}
+
+	/* Only emit low s values; s and n - s are both valid, and n - s belongs to -R. */
+	high = uECC_vli_is_high(s, curve);
+	if (high) {
+		uECC_vli_negate(s, curve);
+	}
+
+	uECC_vli_nativeToBytes(signature + curve->num_bytes, curve->num_bytes, s);
+
+	if (recid) {
+		*recid ^= high;
+	}
+
+	return 1;
+}
+
 int uECC_sign_with_k(
 	const uint8_t *private_key,
 	const uint8_t *message_hash,
@@ -186,7 +557,6 @@ int uECC_sign_with_k(
 	uint8_t *signature,
 	uECC_Curve curve
 ) {
-	int high;
 	uECC_word_t tmp[uECC_MAX_WORDS];
 	uECC_word_t s[uECC_MAX_WORDS];
 	uECC_word_t *k2[2]	   = {tmp, s};
@@ -207,13 +577,6 @@ int uECC_sign_with_k(
 	carry = regularize_k(k, tmp, s, curve);
 
 	EccPoint_mult(p, curve->G, k2[!carry], initial_Z, num_n_bits + 1, curve);
-	if (uECC_vli_isZero(p, num_words)) {
-		return 0;
-	}
-
-	if (recid) {
-		*recid = uECC_vli_testBit(p + num_words, 0);
-	}
 
 	/* Prevent side channel analysis of uECC_vli_modInv() to determine
 	   bits of k / the private key by premultiplying by a random number */
@@ -221,56 +584,110 @@ int uECC_sign_with_k(
 	uECC_vli_modInv(k, k, curve->n, num_n_words);		/* k = 1 / k' */
 	uECC_vli_modMult(k, k, tmp, curve->n, num_n_words); /* k = 1 / k */
 
-	uECC_vli_nativeToBytes(signature, curve->num_bytes, p); /* store r = p.x */
-
 	uECC_vli_bytesToNative(tmp, private_key, BITS_TO_BYTES(curve->num_n_bits)); /* tmp = d */
 
-	s[num_n_words - 1] = 0;
-	uECC_vli_set(s, p, num_words);
-	uECC_vli_modMult(s, tmp, s, curve->n, num_n_words); /* s = r*d */
+	return sign_finish(tmp, message_hash, hash_size, p, k, recid, signature, curve);
+}
 
-	bits2int(tmp, message_hash, hash_size, curve);
-	uECC_vli_modAdd(s, tmp, s, curve->n, num_n_words); /* s = e + r*d */
-	uECC_vli_modMult(s, s, k, curve->n, num_n_words);  /* s = (e + r*d) / k */
-	if (uECC_vli_numBits(s, num_n_words) > (bitcount_t)curve->num_bytes * 8) {
-		return 0;
-	}
+int uECC_sign_with_k_batch(
+	const uint8_t *private_key,
+	const uint8_t *message_hashes,
+	unsigned hash_size,
+	uECC_word_t (*k)[uECC_MAX_WORDS],
+	unsigned count,
+	uint8_t *recids,
+	uint8_t *signatures,
+	uECC_Curve curve
+) {
+	uECC_word_t p[uECC_BATCH_SIZE][uECC_MAX_WORDS * 2];
+	uECC_word_t z_num[uECC_BATCH_SIZE][uECC_MAX_WORDS];
+	uECC_word_t z_den[uECC_BATCH_SIZE][uECC_MAX_WORDS];
+	uECC_word_t d[uECC_MAX_WORDS];
+	uECC_word_t blind[uECC_MAX_WORDS];
+	uECC_word_t tmp[uECC_MAX_WORDS];
+	uECC_word_t *k2[2]	   = {blind, tmp};
+	uECC_word_t *initial_Z = 0;
+	uECC_word_t carry;
+	unsigned done;
+	unsigned i;
+	int ret = 1;
+	const wordcount_t num_words	  = curve->num_words;
+	const wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+	const bitcount_t num_n_bits	  = curve->num_n_bits;
 
-	high = uECC_vli_is_high(s);
+	for (i = 0; i < count; ++i) {
+		/* Make sure 0 < k < curve_n */
+		if (uECC_vli_isZero(k[i], num_words) || uECC_vli_cmp(curve->n, k[i], num_n_words) != 1) {
+			return 0;
+		}
+	}
 
-	uECC_vli_negate(s);
+	uECC_vli_bytesToNative(d, private_key, BITS_TO_BYTES(curve->num_n_bits));
 
-	uECC_vli_nativeToBytes(signature + curve->num_bytes, curve->num_bytes, s);
+	for (done = 0; done < count; done += uECC_BATCH_SIZE) {
+		unsigned chunk = count - done < uECC_BATCH_SIZE ? count - done : uECC_BATCH_SIZE;
+		uECC_word_t(*kc)[uECC_MAX_WORDS] = k + done;
 
-	if (recid) {
-		*recid ^= high;
+		for (i = 0; i < chunk; ++i) {
+			carry = regularize_k(kc[i], blind, tmp, curve);
+			EccPoint_mult_deferred(p[i], z_num[i], z_den[i], curve->G, k2[!carry], initial_Z, num_n_bits + 1, curve);
+		}
+		EccPoint_apply_z_batch(p, z_num, z_den, chunk, curve);
+
+		/* Invert every k of the chunk at once. The product is blinded the same way as in
+		   uECC_sign_with_k(), with the regularized first nonce. */
+		regularize_k(kc[0], blind, tmp, curve);
+		uECC_vli_modMult(kc[0], kc[0], blind, curve->n, num_n_words); /* k0' = rand * k0 */
+		uECC_vli_modInv_batch(kc, chunk, curve->n, num_n_words);
+		uECC_vli_modMult(kc[0], kc[0], blind, curve->n, num_n_words); /* k0 = 1 / k0 */
+
+		for (i = 0; i < chunk; ++i) {
+			ret &= sign_finish(
+				d,
+				message_hashes + (size_t)(done + i) * hash_size,
+				hash_size,
+				p[i],
+				kc[i],
+				recids ? recids + done + i : 0,
+				signatures + (size_t)(done + i) * 2 * curve->num_bytes,
+				curve
+			);
+		}
 	}
 
-	return 1;
+	uECC_vli_clear(d, num_n_words);
+	uECC_vli_clear(blind, num_n_words);
+	uECC_vli_clear(tmp, num_n_words);
+	return ret;
 }
 
-static bitcount_t smax(bitcount_t a, bitcount_t b) { return (a > b ? a : b); }
-
 int uECC_verify(
 	const uint8_t *public_key,
 	const uint8_t *message_hash,
 	unsigned hash_size,
 	const uint8_t *signature,
 	uECC_Curve curve
+) {
+	uECC_word_t _public[uECC_MAX_WORDS * 2];
+
+	uECC_vli_bytesToNative(_public, public_key, curve->num_bytes);
+	uECC_vli_bytesToNative(_public + curve->num_words, public_key + curve->num_bytes, curve->num_bytes);
+	return uECC_verify_native(_public, 0, message_hash, hash_size, signature, curve);
+}
+
+int uECC_verify_native(
+	const uECC_word_t *_public,
+	const uECC_word_t *public_plus_G,
+	const uint8_t *message_hash,
+	unsigned hash_size,
+	const uint8_t *signature,
+	uECC_Curve curve
 ) {
 	uECC_word_t u1[uECC_MAX_WORDS], u2[uECC_MAX_WORDS];
 	uECC_word_t z[uECC_MAX_WORDS];
 	uECC_word_t sum[uECC_MAX_WORDS * 2];
 	uECC_word_t rx[uECC_MAX_WORDS];
 	uECC_word_t ry[uECC_MAX_WORDS];
-	uECC_word_t tx[uECC_MAX_WORDS];
-	uECC_word_t ty[uECC_MAX_WORDS];
-	uECC_word_t tz[uECC_MAX_WORDS];
-	const uECC_word_t *points[4];
-	const uECC_word_t *point;
-	bitcount_t num_bits;
-	bitcount_t i;
-	uECC_word_t _public[uECC_MAX_WORDS * 2];
 	uECC_word_t r[uECC_MAX_WORDS], s[uECC_MAX_WORDS];
 	wordcount_t num_words	= curve->num_words;
 	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
@@ -279,8 +696,6 @@ int uECC_verify(
 	r[num_n_words - 1]	= 0;
 	s[num_n_words - 1]	= 0;
 
-	uECC_vli_bytesToNative(_public, public_key, curve->num_bytes);
-	uECC_vli_bytesToNative(_public + num_words, public_key + curve->num_bytes, curve->num_bytes);
 	uECC_vli_bytesToNative(r, signature, curve->num_bytes);
 	uECC_vli_bytesToNative(s, signature + curve->num_bytes, curve->num_bytes);
 
@@ -301,44 +716,15 @@ int uECC_verify(
 	uECC_vli_modMult(u1, u1, z, curve->n, num_n_words); /* u1 = e/s */
 	uECC_vli_modMult(u2, r, z, curve->n, num_n_words);	/* u2 = r/s */
 
-	/* Calculate sum = G + Q. */
-	uECC_vli_set(sum, _public, num_words);
-	uECC_vli_set(sum + num_words, _public + num_words, num_words);
-	uECC_vli_set(tx, curve->G, num_words);
-	uECC_vli_set(ty, curve->G + num_words, num_words);
-	uECC_vli_modSub(z, sum, tx, curve->p, num_words); /* z = x2 - x1 */
-	XYcZ_add(tx, ty, sum, sum + num_words, curve);
-	uECC_vli_modInv(z, z, curve->p, num_words); /* z = 1/z */
-	apply_z(sum, sum + num_words, z, curve);
+	/* Calculate sum = G + Q, unless the caller already has it. */
+	if (public_plus_G) {
+		uECC_vli_set(sum, public_plus_G, num_words * 2);
+	} else {
+		EccPoint_add_G(sum, _public, curve);
+	}
 
 	/* Use Shamir's trick to calculate u1*G + u2*Q */
-	points[0] = 0;
-	points[1] = curve->G;
-	points[2] = _public;
-	points[3] = sum;
-	num_bits  = smax(uECC_vli_numBits(u1, num_n_words), uECC_vli_numBits(u2, num_n_words));
-
-	point = points[(!!uECC_vli_testBit(u1, num_bits - 1)) | ((!!uECC_vli_testBit(u2, num_bits - 1)) << 1)];
-	uECC_vli_set(rx, point, num_words);
-	uECC_vli_set(ry, point + num_words, num_words);
-	uECC_vli_clear(z, num_words);
-	z[0] = 1;
-
-	for (i = num_bits - 2; i >= 0; --i) {
-		uECC_word_t index;
-		curve->double_jacobian(rx, ry, z, curve);
-
-		index = (!!uECC_vli_testBit(u1, i)) | ((!!uECC_vli_testBit(u2, i)) << 1);
-		point = points[index];
-		if (point) {
-			uECC_vli_set(tx, point, num_words);
-			uECC_vli_set(ty, point + num_words, num_words);
-			apply_z(tx, ty, z, curve);
-			uECC_vli_modSub(tz, rx, tx, curve->p, num_words); /* Z = x2 - x1 */
-			XYcZ_add(tx, ty, rx, ry, curve);
-			uECC_vli_modMult_fast(z, z, tz, curve);
-		}
-	}
+	EccPoint_mult_shamir(rx, ry, z, u1, u2, _public, sum, curve);
 
 	uECC_vli_modInv(z, z, curve->p, num_words); /* Z = 1/Z */
 	apply_z(rx, ry, z, curve);
@@ -351,3 +737,296 @@ int uECC_verify(
 	/* Accept only if v == r. */
 	return (int)(uECC_vli_equal(rx, r, num_words));
 }
+
+/* Rebuilds R = k*G from r and recid and returns r and s, or returns 0 if they are invalid. */
+static int recover_R(
+	uECC_word_t *R,
+	uECC_word_t *r,
+	uECC_word_t *s,
+	const uint8_t *signature,
+	uint8_t recid,
+	uECC_Curve curve
+) {
+	uECC_word_t tmp1[uECC_MAX_WORDS];
+	uECC_word_t tmp2[uECC_MAX_WORDS];
+	wordcount_t num_words	= curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+	if (recid > 3) {
+		return 0;
+	}
+
+	r[num_n_words - 1] = 0;
+	s[num_n_words - 1] = 0;
+	uECC_vli_bytesToNative(r, signature, curve->num_bytes);
+	uECC_vli_bytesToNative(s, signature + curve->num_bytes, curve->num_bytes);
+
+	/* r, s must be in [1, n-1]. */
+	if (uECC_vli_isZero(r, num_words) || uECC_vli_isZero(s, num_words)) {
+		return 0;
+	}
+	if (uECC_vli_cmp_unsafe(curve->n, r, num_n_words) != 1 || uECC_vli_cmp_unsafe(curve->n, s, num_n_words) != 1) {
+		return 0;
+	}
+
+	/* R.x = r, or r + n if the x coordinate of k*G overflowed the group order. */
+	uECC_vli_set(R, r, num_words);
+	if (recid & 2) {
+		if (uECC_vli_add(R, R, curve->n, num_words) || uECC_vli_cmp_unsafe(curve->p, R, num_words) != 1) {
+			return 0;
+		}
+	}
+
+	/* R.y is the root of x^3 + ax + b with the parity given by recid. */
+	curve->x_side(tmp1, R, curve);
+	uECC_vli_set(R + num_words, tmp1, num_words);
+	curve->mod_sqrt(R + num_words, curve);
+	uECC_vli_modSquare_fast(tmp2, R + num_words, curve);
+	if (!uECC_vli_equal(tmp1, tmp2, num_words)) {
+		return 0; /* r is not the x coordinate of a point on the curve */
+	}
+	if ((R[num_words] & 0x01) != (recid & 0x01)) {
+		uECC_vli_sub(R + num_words, curve->p, R + num_words, num_words);
+	}
+	return 1;
+}
+
+/* Number of signatures folded into one multi-scalar check. Each contributes a Q and an R term. */
+#define uECC_VERIFY_GROUP (uECC_BATCH_SIZE / 2)
+
+int uECC_verify_batch(
+	const uint8_t *public_keys,
+	const uint8_t *message_hashes,
+	unsigned hash_size,
+	const uint8_t *signatures,
+	const uint8_t *recids,
+	unsigned count,
+	uint8_t *valid,
+	uECC_Curve curve
+) {
+	EccPoint_msm_term terms[2 * uECC_VERIFY_GROUP];
+	uECC_word_t scalars[2 * uECC_VERIFY_GROUP][uECC_MAX_WORDS];
+	uECC_word_t R0[uECC_MAX_WORDS * 2];
+	uECC_word_t r[uECC_MAX_WORDS], s[uECC_MAX_WORDS];
+	uECC_word_t e[uECC_MAX_WORDS], a[uECC_MAX_WORDS];
+	uECC_word_t X[uECC_MAX_WORDS], Y[uECC_MAX_WORDS], Z[uECC_MAX_WORDS];
+	uint8_t ok[uECC_VERIFY_GROUP];
+	uint8_t seed[32];
+	uint8_t weight[16];
+	secp256k1_sha256 sha;
+	unsigned done, i, t, used;
+	int batched;
+	int ret = 1;
+	wordcount_t num_words	= curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+	unsigned key_size		= 2 * curve->num_bytes;
+
+	for (done = 0; done < count; done += uECC_VERIFY_GROUP) {
+		unsigned chunk = count - done < uECC_VERIFY_GROUP ? count - done : uECC_VERIFY_GROUP;
+		const uint8_t *keys = public_keys + (size_t)done * key_size;
+		const uint8_t *sigs = signatures + (size_t)done * key_size;
+		const uint8_t *hashes = message_hashes + (size_t)done * hash_size;
+
+		batched = recids != 0;
+		memset(ok, 0, sizeof(ok));
+		if (batched) {
+			/* The weights are bound to every input of the group, so they cannot be chosen before
+			   the signatures they are meant to cancel. */
+			secp256k1_sha256_initialize(&sha);
+			secp256k1_sha256_write(&sha, keys, (size_t)chunk * key_size);
+			secp256k1_sha256_write(&sha, hashes, (size_t)chunk * hash_size);
+			secp256k1_sha256_write(&sha, sigs, (size_t)chunk * key_size);
+			secp256k1_sha256_write(&sha, recids + done, chunk);
+			secp256k1_sha256_finalize(&sha, seed);
+		}
+
+		/* Every signature satisfies s*R = e*G + r*Q. With weights a_i the group is accepted if
+		   (sum a_i*e_i)*G + sum a_i*r_i*Q_i - sum_{i>0} a_i*s_i*R_i == R_0, where a_0 = 1/s_0 and
+		   a_i for i > 0 is a 128-bit weight from the seed. terms[0] is G. */
+		uECC_vli_clear(scalars[0], num_n_words);
+		t	 = 1;
+		used = 0;
+		for (i = 0; batched && i < chunk; ++i) {
+			uECC_word_t *Q = terms[t].table[0];
+			uECC_word_t *R = used ? terms[t + 1].table[0] : R0;
+
+			uECC_vli_bytesToNative(Q, keys + (size_t)i * key_size, curve->num_bytes);
+			uECC_vli_bytesToNative(Q + num_words, keys + (size_t)i * key_size + curve->num_bytes, curve->num_bytes);
+			if (!uECC_valid_point(Q, curve) ||
+				!recover_R(R, r, s, sigs + (size_t)i * key_size, recids[done + i], curve)) {
+				continue; /* left to uECC_verify() */
+			}
+			ok[i] = 1;
+
+			if (used) {
+				secp256k1_sha256_batch_weight(weight, seed, i);
+				uECC_vli_clear(a, num_n_words);
+				uECC_vli_bytesToNative(a, weight, 16);
+			} else {
+				uECC_vli_modInv(a, s, curve->n, num_n_words);
+			}
+			e[num_n_words - 1] = 0;
+			bits2int(e, hashes + (size_t)i * hash_size, hash_size, curve);
+			uECC_vli_modMult(e, e, a, curve->n, num_n_words);
+			uECC_vli_modAdd(scalars[0], scalars[0], e, curve->n, num_n_words);
+			uECC_vli_modMult(scalars[t], r, a, curve->n, num_n_words);
+			if (used) {
+				uECC_vli_modMult(scalars[t + 1], s, a, curve->n, num_n_words);
+				if (!uECC_vli_isZero(scalars[t + 1], num_n_words)) {
+					uECC_vli_sub(scalars[t + 1], curve->n, scalars[t + 1], num_n_words);
+				}
+				t += 2;
+			} else {
+				t += 1;
+			}
+			++used;
+		}
+
+		batched = batched && used;
+		if (batched) {
+			uECC_vli_set(terms[0].table[0], curve->G, num_words * 2);
+			EccPoint_msm_init(terms, scalars, t, curve);
+			batched = EccPoint_msm(X, Y, Z, terms, t, curve);
+		}
+		if (batched) {
+			apply_z(R0, R0 + num_words, Z, curve);
+			batched = uECC_vli_equal(X, R0, num_words) && uECC_vli_equal(Y, R0 + num_words, num_words);
+		}
+
+		/* A failed group check only says that some signature is bad; find out which. */
+		for (i = 0; i < chunk; ++i) {
+			uint8_t v = batched && ok[i];
+			if (!v) {
+				v = (uint8_t)uECC_verify(
+					keys + (size_t)i * key_size,
+					hashes + (size_t)i * hash_size,
+					hash_size,
+					sigs + (size_t)i * key_size,
+					curve
+				);
+			}
+			if (valid) {
+				valid[done + i] = v;
+			}
+			ret &= v;
+		}
+	}
+	return ret;
+}
+
+int uECC_recover_batch(
+	const uint8_t *message_hashes,
+	unsigned hash_size,
+	const uint8_t *signatures,
+	const uint8_t *recids,
+	unsigned count,
+	uint8_t *public_keys,
+	uint8_t *valid,
+	uECC_Curve curve
+) {
+	uECC_word_t R[uECC_BATCH_SIZE][uECC_MAX_WORDS * 2];
+	uECC_word_t sum[uECC_BATCH_SIZE][uECC_MAX_WORDS * 2];
+	uECC_word_t Q[uECC_BATCH_SIZE][uECC_MAX_WORDS * 2];
+	uECC_word_t s[uECC_BATCH_SIZE][uECC_MAX_WORDS];
+	uECC_word_t z[uECC_BATCH_SIZE][uECC_MAX_WORDS];
+	uECC_word_t u1[uECC_MAX_WORDS], u2[uECC_MAX_WORDS];
+	uint8_t ok[uECC_BATCH_SIZE];
+	uint8_t direct[uECC_BATCH_SIZE];
+	unsigned done, i;
+	int ret = 1;
+	wordcount_t num_words	= curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+	unsigned sig_size		= 2 * curve->num_bytes;
+
+	for (done = 0; done < count; done += uECC_BATCH_SIZE) {
+		unsigned chunk = count - done < uECC_BATCH_SIZE ? count - done : uECC_BATCH_SIZE;
+
+		/* Rebuild every R. z holds r for the batched 1/r below; failed entries carry on with
+		   r = 1 so that they cannot spoil the shared inversion. */
+		for (i = 0; i < chunk; ++i) {
+			ok[i] = recover_R(R[i], z[i], s[i], signatures + (size_t)(done + i) * sig_size, recids[done + i], curve);
+			if (!ok[i]) {
+				uECC_vli_clear(z[i], num_n_words);
+				z[i][0] = 1;
+				uECC_vli_set(R[i], curve->G, num_words * 2);
+			}
+		}
+		uECC_vli_modInv_batch(z, chunk, curve->n, num_n_words);
+
+		/* Q = r^-1 * (s*R - e*G) = (-e/r) * G + (s/r) * R. Both scalars are kept in s, which is
+		   overwritten by u2, and Q, which holds u1 until the Shamir step needs it. */
+		for (i = 0; i < chunk; ++i) {
+			uECC_word_t *e = Q[i];
+			e[num_n_words - 1] = 0;
+			bits2int(e, message_hashes + (size_t)(done + i) * hash_size, hash_size, curve);
+			uECC_vli_modMult(e, e, z[i], curve->n, num_n_words); /* u1 = e/r */
+			if (!uECC_vli_isZero(e, num_n_words)) {
+				uECC_vli_sub(e, curve->n, e, num_n_words); /* u1 = -e/r */
+			}
+			uECC_vli_modMult(s[i], s[i], z[i], curve->n, num_n_words); /* u2 = s/r */
+
+			/* sum = G + R. The co-Z addition cannot form it for R == +-G, the valid signatures
+			   with k == +-1, whose key is Q = (u1 +- u2) * G instead. */
+			EccPoint_add_G_deferred(sum[i], z[i], R[i], curve);
+			direct[i] = 0;
+			if (uECC_vli_isZero(z[i], num_words)) {
+				if (ok[i]) {
+					if (uECC_vli_equal(R[i] + num_words, curve->G + num_words, num_words)) {
+						uECC_vli_modAdd(u1, e, s[i], curve->n, num_n_words);
+					} else {
+						uECC_vli_modSub(u1, e, s[i], curve->n, num_n_words);
+					}
+					ok[i]	  = !uECC_vli_isZero(u1, num_n_words) && EccPoint_compute_public_key(Q[i], u1, curve);
+					direct[i] = 1;
+				}
+				z[i][0] = 1;
+			}
+		}
+		uECC_vli_modInv_batch_fast(z, chunk, curve);
+
+		for (i = 0; i < chunk; ++i) {
+			if (direct[i]) {
+				uECC_vli_clear(z[i], num_words);
+				z[i][0] = 1; /* Q is already affine */
+				continue;
+			}
+			apply_z(sum[i], sum[i] + num_words, z[i], curve);
+
+			uECC_vli_set(u1, Q[i], num_n_words);
+			uECC_vli_set(u2, s[i], num_n_words);
+			EccPoint_mult_shamir(Q[i], Q[i] + num_words, z[i], u1, u2, R[i], sum[i], curve);
+			if (uECC_vli_isZero(z[i], num_words)) {
+				ok[i] = 0; /* Q is the point at infinity */
+				z[i][0] = 1;
+			}
+		}
+		uECC_vli_modInv_batch_fast(z, chunk, curve);
+
+		for (i = 0; i < chunk; ++i) {
+			uint8_t *public_key = public_keys + (size_t)(done + i) * sig_size;
+			if (ok[i]) {
+				apply_z(Q[i], Q[i] + num_words, z[i], curve);
+				uECC_vli_nativeToBytes(public_key, curve->num_bytes, Q[i]);
+				uECC_vli_nativeToBytes(public_key + curve->num_bytes, curve->num_bytes, Q[i] + num_words);
+			} else {
+				memset(public_key, 0, sig_size);
+			}
+			if (valid) {
+				valid[done + i] = ok[i];
+			}
+			ret &= ok[i];
+		}
+	}
+	return ret;
+}
+
+int uECC_recover(
+	const uint8_t *message_hash,
+	unsigned hash_size,
+	const uint8_t *signature,
+	uint8_t recid,
+	uint8_t *public_key,
+	uECC_Curve curve
+) {
+	return uECC_recover_batch(message_hash, hash_size, signature, &recid, 1, public_key, 0, curve);
+}
@@ -45,6 +45,70 @@ Returns 1 if the shared secret was generated successfully, 0 if an error occurre
 */
 int uECC_shared_secret(const uint8_t *public_key, const uint8_t *private_key, uint8_t *secret, uECC_Curve curve);
 
+/* Secrets produced by uECC_ecdh(). */
+#define uECC_ECDH_X					0 /* the x coordinate of the shared point, as uECC_shared_secret() */
+#define uECC_ECDH_SHA256_X			1 /* SHA-256 of x */
+#define uECC_ECDH_SHA256_COMPRESSED 2 /* SHA-256 of the compressed point, as bitcoin-core/secp256k1 */
+
+/* Option for uECC_ecdh(), or'ed into mode: compute x with a Montgomery ladder on (X : Z) alone
+   instead of the co-Z ladder on x and y. It also handles private keys 1 and n - 1, which the
+   co-Z ladder cannot, but cannot be used with uECC_ECDH_SHA256_COMPRESSED. */
+#define uECC_ECDH_XZ_LADDER 0x10
+
+/* uECC_ecdh() function.
+Compute a shared secret given your secret key and someone else's public key, hashing it as
+selected by mode. Unlike uECC_shared_secret(), the public key is always validated.
+
+Inputs:
+	public_key  - The public key of the remote party: raw x || y (2 * curve size bytes),
+				  compressed (curve size + 1 bytes) or x-only (curve size bytes). x-only keys
+				  cannot be used with uECC_ECDH_SHA256_COMPRESSED.
+	key_size    - The size of public_key in bytes.
+	private_key - Your private key.
+	mode        - uECC_ECDH_X, uECC_ECDH_SHA256_X or uECC_ECDH_SHA256_COMPRESSED, optionally or'ed
+				  with uECC_ECDH_XZ_LADDER.
+
+Outputs:
+	secret - Will be filled in with the shared secret: curve size bytes for uECC_ECDH_X, 32
+			 bytes otherwise.
+
+Returns 1 if the shared secret was generated successfully, 0 if an error occurred.
+*/
+int uECC_ecdh(
+	const uint8_t *public_key,
+	unsigned key_size,
+	const uint8_t *private_key,
+	int mode,
+	uint8_t *secret,
+	uECC_Curve curve
+);
+
+/* uECC_ecdh_batch() function.
+Compute the shared secrets of one private key with count public keys, as uECC_ecdh(). The private
+key is checked and regularized once and the final field inversions are shared across
+uECC_BATCH_SIZE keys.
+
+Inputs:
+	public_keys - count public keys of key_size bytes each, back to back.
+
+Outputs:
+	secrets - Filled in with count secrets, back to back. Secrets for invalid keys are zeroed.
+	valid   - If not NULL, filled in with 1 for every valid public key and 0 otherwise.
+
+Returns 1 if every secret was generated, 0 otherwise. Nothing is written if the private key or
+mode is invalid.
+*/
+int uECC_ecdh_batch(
+	const uint8_t *public_keys,
+	unsigned key_size,
+	unsigned count,
+	const uint8_t *private_key,
+	int mode,
+	uint8_t *secrets,
+	uint8_t *valid,
+	uECC_Curve curve
+);
+
 /* uECC_compress() function.
 Compress a public key.
 
@@ -62,12 +126,32 @@ void uECC_compress(const uint8_t *public_key, uint8_t *compressed, uECC_Curve cu
 Decompress a compressed public key.
 
 Inputs:
-	compressed - The compressed public key.
+	compressed - The compressed public key: 0x02 or 0x03 followed by the x coordinate.
 
 Outputs:
 	public_key - Will be filled in with the decompressed public key.
+
+Returns 1 if the key was decompressed, 0 if the prefix is wrong or x is not the x coordinate of a
+point on the curve. public_key is left untouched in that case.
 */
-void uECC_decompress(const uint8_t *compressed, uint8_t *public_key, uECC_Curve curve);
+int uECC_decompress(const uint8_t *compressed, uint8_t *public_key, uECC_Curve curve);
+
+/* uECC_decompress_batch() function.
+Decompress count compressed public keys, as uECC_decompress().
+
+Inputs:
+	compressed - count compressed keys of curve size + 1 bytes each, back to back.
+
+Outputs:
+	public_keys - Filled in with count public keys, back to back. Keys that could not be
+				  decompressed are zeroed.
+	valid       - If not NULL, filled in with 1 for every decompressed key and 0 otherwise.
+
+Returns 1 if every key was decompressed, 0 otherwise.
+*/
+int uECC_decompress_batch(
+	const uint8_t *compressed, unsigned count, uint8_t *public_keys, uint8_t *valid, uECC_Curve curve
+);
 
 /* uECC_valid_public_key() function.
 Check to see if a public key is valid.
@@ -83,6 +167,16 @@ Returns 1 if the public key is valid, 0 if it is invalid.
 */
 int uECC_valid_public_key(const uint8_t *public_key, uECC_Curve curve);
 
+/* uECC_valid_public_key_batch() function.
+Check count public keys, stored back to back, as uECC_valid_public_key().
+
+Outputs:
+	valid - If not NULL, filled in with 1 for every valid key and 0 otherwise.
+
+Returns 1 if every key is valid, 0 otherwise.
+*/
+int uECC_valid_public_key_batch(const uint8_t *public_keys, unsigned count, uint8_t *valid, uECC_Curve curve);
+
 /* uECC_compute_public_key() function.
 Compute the corresponding public key for a private key.
 
@@ -96,6 +190,31 @@ Returns 1 if the key was computed successfully, 0 if an error occurred.
 */
 int uECC_compute_public_key(const uint8_t *private_key, uint8_t *public_key, uECC_Curve curve);
 
+/* uECC_compute_public_key_batch() function.
+Compute the public keys for count private keys, as uECC_compute_public_key(). The conversions of
+the k*G results to affine coordinates share one field inversion per uECC_BATCH_SIZE keys.
+
+Inputs:
+	private_keys - count private keys, back to back.
+	compressed   - If non-zero, write compressed keys (curve size + 1 bytes) instead of raw
+				   x || y (2 * curve size bytes).
+
+Outputs:
+	public_keys - Filled in with count public keys, back to back. Keys for private keys outside
+				  [1, n-1] are zeroed.
+	valid       - If not NULL, filled in with 1 for every computed key and 0 otherwise.
+
+Returns 1 if every key was computed, 0 otherwise.
+*/
+int uECC_compute_public_key_batch(
+	const uint8_t *private_keys,
+	unsigned count,
+	int compressed,
+	uint8_t *public_keys,
+	uint8_t *valid,
+	uECC_Curve curve
+);
+
 /* uECC_sign_with_k() function.
 Generate an ECDSA signature for a given hash value.
 
@@ -123,6 +242,34 @@ int uECC_sign_with_k(
 	uECC_Curve curve
 );
 
+/* uECC_sign_with_k_batch() function.
+Generate ECDSA signatures for count hash values under one private key, as uECC_sign_with_k().
+The key is converted once, the k*G results share one field inversion per uECC_BATCH_SIZE
+signatures, and so do the 1/k inversions.
+
+Inputs:
+	private_key    - Your private key.
+	message_hashes - count hashes of hash_size bytes each, stored back to back.
+	hash_size      - The size of each message hash in bytes.
+	k              - count nonces; they are overwritten.
+
+Outputs:
+	recids     - If not NULL, filled in with count recovery ids.
+	signatures - Filled in with count signatures of 2 * curve size bytes each, back to back.
+
+Returns 1 if every signature was generated successfully, 0 if an error occurred.
+*/
+int uECC_sign_with_k_batch(
+	const uint8_t *private_key,
+	const uint8_t *message_hashes,
+	unsigned hash_size,
+	uECC_word_t (*k)[uECC_MAX_WORDS],
+	unsigned count,
+	uint8_t *recids,
+	uint8_t *signatures,
+	uECC_Curve curve
+);
+
 /* uECC_verify() function.
 Verify an ECDSA signature.
 
@@ -145,4 +292,114 @@ int uECC_verify(
 	uECC_Curve curve
 );
 
+/* uECC_verify_native() function.
+Verify an ECDSA signature against a public key that is already in native form, as uECC_verify().
+The key is not validated; use uECC_valid_point() first if it does not come from a trusted source.
+
+Inputs:
+	_public       - The signer's public key as a native point.
+	public_plus_G - The affine point _public + G as computed by EccPoint_add_G(), or NULL to
+					compute it here. Callers that verify many signatures under one key can keep it.
+	message_hash  - The hash of the signed data.
+	hash_size     - The size of message_hash in bytes.
+	signature     - The signature value.
+
+Returns 1 if the signature is valid, 0 if it is invalid.
+*/
+int uECC_verify_native(
+	const uECC_word_t *_public,
+	const uECC_word_t *public_plus_G,
+	const uint8_t *message_hash,
+	unsigned hash_size,
+	const uint8_t *signature,
+	uECC_Curve curve
+);
+
+/* uECC_recover() function.
+Recover the public key that produced an ECDSA signature, given the recovery id returned when the
+signature was generated.
+
+Inputs:
+	message_hash - The hash of the signed data.
+	hash_size    - The size of message_hash in bytes.
+	signature    - The signature value.
+	recid        - The recovery id, 0 to 3. Bit 0 is the parity of R.y; bit 1 is set if R.x
+				   is r + n.
+
+Outputs:
+	public_key - Will be filled in with the recovered public key.
+
+Returns 1 if a public key was recovered, 0 if the signature or recovery id is invalid.
+*/
+int uECC_recover(
+	const uint8_t *message_hash,
+	unsigned hash_size,
+	const uint8_t *signature,
+	uint8_t recid,
+	uint8_t *public_key,
+	uECC_Curve curve
+);
+
+/* uECC_recover_batch() function.
+Recover the public keys for count signatures, as uECC_recover(). The 1/r inversions, the G + R
+precomputations and the final conversions to affine coordinates each share one inversion per
+uECC_BATCH_SIZE signatures.
+
+Inputs:
+	message_hashes - count hashes of hash_size bytes each, stored back to back.
+	hash_size      - The size of each message hash in bytes.
+	signatures     - count signatures of 2 * curve size bytes each, back to back.
+	recids         - count recovery ids.
+
+Outputs:
+	public_keys - Filled in with count public keys, back to back. Keys that could not be
+				  recovered are zeroed.
+	valid       - If not NULL, filled in with 1 for every recovered key and 0 otherwise.
+
+Returns 1 if every public key was recovered, 0 otherwise.
+*/
+int uECC_recover_batch(
+	const uint8_t *message_hashes,
+	unsigned hash_size,
+	const uint8_t *signatures,
+	const uint8_t *recids,
+	unsigned count,
+	uint8_t *public_keys,
+	uint8_t *valid,
+	uECC_Curve curve
+);
+
+/* uECC_verify_batch() function.
+Verify count ECDSA signatures at once, as uECC_verify().
+
+When recids are given, the R point of every signature is rebuilt and up to uECC_BATCH_SIZE / 2
+signatures at a time are checked with a single multi-scalar multiplication, weighting each
+equation with a value hashed from all inputs of the group. If a group check fails, or a
+signature cannot take part in it, the signatures concerned are verified one at a time so that
+valid still names exactly the bad ones. A signature whose recid does not match its R is still
+accepted through that fallback, as uECC_verify() does not look at R.y.
+
+Inputs:
+	public_keys    - count public keys, back to back.
+	message_hashes - count hashes of hash_size bytes each, back to back.
+	hash_size      - The size of each message hash in bytes.
+	signatures     - count signatures, back to back.
+	recids         - count recovery ids, or NULL to verify every signature on its own.
+
+Outputs:
+	valid - If not NULL, filled in with 1 for every valid signature and 0 otherwise.
+
+Returns 1 if every signature is valid, 0 otherwise.
+*/
+int uECC_verify_batch(
+	const uint8_t *public_keys,
+	const uint8_t *message_hashes,
+	unsigned hash_size,
+	const uint8_t *signatures,
+	const uint8_t *recids,
+	unsigned count,
+	uint8_t *valid,
+	uECC_Curve curve
+);
+
 #endif /* micro_h */
@@ -28,6 +28,48 @@ void uECC_vli_mmod_fast(uECC_word_t *result, uECC_word_t *product, uECC_Curve cu
 	curve->mmod_fast(result, product);
 }
 
+void uECC_vli_modInv_batch_fast(uECC_word_t (*values)[uECC_MAX_WORDS], unsigned count, uECC_Curve curve) {
+	uECC_word_t prefix[uECC_BATCH_SIZE][uECC_MAX_WORDS];
+	uECC_word_t inv[uECC_MAX_WORDS];
+	uECC_word_t tmp[uECC_MAX_WORDS];
+	wordcount_t num_words = curve->num_words;
+	unsigned i;
+
+	if (count == 0) {
+		return;
+	}
+
+	uECC_vli_set(prefix[0], values[0], num_words);
+	for (i = 1; i < count; ++i) {
+		uECC_vli_modMult_fast(prefix[i], prefix[i - 1], values[i], curve);
+	}
+
+	uECC_vli_modInv(inv, prefix[count - 1], curve->p, num_words);
+
+	for (i = count - 1; i > 0; --i) {
+		uECC_vli_modMult_fast(tmp, inv, prefix[i - 1], curve); /* tmp = 1 / values[i] */
+		uECC_vli_modMult_fast(inv, inv, values[i], curve);	   /* inv = 1 / prefix[i - 1] */
+		uECC_vli_set(values[i], tmp, num_words);
+	}
+	uECC_vli_set(values[0], inv, num_words);
+}
+
+void uECC_vli_negate(uECC_word_t *vli, uECC_Curve curve) {
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+	if (!uECC_vli_isZero(vli, num_n_words)) {
+		uECC_vli_sub(vli, curve->n, vli, num_n_words);
+	}
+}
+
+int uECC_vli_is_high(const uECC_word_t *vli, uECC_Curve curve) {
+	uECC_word_t half[uECC_MAX_WORDS];
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+	uECC_vli_set(half, curve->n, num_n_words);
+	uECC_vli_rshift1(half, num_n_words); /* half = (n - 1) / 2, n being odd */
+	return uECC_vli_cmp_unsafe(vli, half, num_n_words) == 1;
+}
+
 void mod_sqrt_default(uECC_word_t *a, uECC_Curve curve) {
 	bitcount_t i;
 	uECC_word_t p1[uECC_MAX_WORDS]		 = {1};
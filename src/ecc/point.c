@@ -113,8 +113,10 @@ void XYcZ_addC(uECC_word_t *X1, uECC_word_t *Y1, uECC_word_t *X2, uECC_word_t *Y
 }
 
 /* result may overlap point. */
-void EccPoint_mult(
+void EccPoint_mult_deferred(
 	uECC_word_t *result,
+	uECC_word_t *z_num,
+	uECC_word_t *z_den,
 	const uECC_word_t *point,
 	const uECC_word_t *scalar,
 	const uECC_word_t *initial_Z,
@@ -124,7 +126,6 @@ void EccPoint_mult(
 	/* R0 and R1 */
 	uECC_word_t Rx[2][uECC_MAX_WORDS];
 	uECC_word_t Ry[2][uECC_MAX_WORDS];
-	uECC_word_t z[uECC_MAX_WORDS];
 	bitcount_t i;
 	uECC_word_t nb;
 	wordcount_t num_words = curve->num_words;
@@ -143,23 +144,361 @@ void EccPoint_mult(
 	nb = !uECC_vli_testBit(scalar, 0);
 	XYcZ_addC(Rx[1 - nb], Ry[1 - nb], Rx[nb], Ry[nb], curve);
 
-	/* Find final 1/Z value. */
-	uECC_vli_modSub(z, Rx[1], Rx[0], curve->p, num_words); /* X1 - X0 */
-	uECC_vli_modMult_fast(z, z, Ry[1 - nb], curve);		   /* Yb * (X1 - X0) */
-	uECC_vli_modMult_fast(z, z, point, curve);			   /* xP * Yb * (X1 - X0) */
-	uECC_vli_modInv(z, z, curve->p, num_words);			   /* 1 / (xP * Yb * (X1 - X0)) */
-	/* yP / (xP * Yb * (X1 - X0)) */
-	uECC_vli_modMult_fast(z, z, point + num_words, curve);
-	uECC_vli_modMult_fast(z, z, Rx[1 - nb], curve); /* Xb * yP / (xP * Yb * (X1 - X0)) */
-	/* End 1/Z calculation */
+	/* Final 1/Z value is z_num / z_den. */
+	uECC_vli_modSub(z_den, Rx[1], Rx[0], curve->p, num_words); /* X1 - X0 */
+	uECC_vli_modMult_fast(z_den, z_den, Ry[1 - nb], curve);	   /* Yb * (X1 - X0) */
+	uECC_vli_modMult_fast(z_den, z_den, point, curve);		   /* xP * Yb * (X1 - X0) */
+	/* Xb * yP */
+	uECC_vli_modMult_fast(z_num, Rx[1 - nb], point + num_words, curve);
 
 	XYcZ_add(Rx[nb], Ry[nb], Rx[1 - nb], Ry[1 - nb], curve);
-	apply_z(Rx[0], Ry[0], z, curve);
 
 	uECC_vli_set(result, Rx[0], num_words);
 	uECC_vli_set(result + num_words, Ry[0], num_words);
 }
 
+/* result may overlap point. */
+void EccPoint_mult(
+	uECC_word_t *result,
+	const uECC_word_t *point,
+	const uECC_word_t *scalar,
+	const uECC_word_t *initial_Z,
+	bitcount_t num_bits,
+	uECC_Curve curve
+) {
+	uECC_word_t z_num[uECC_MAX_WORDS];
+	uECC_word_t z_den[uECC_MAX_WORDS];
+	wordcount_t num_words = curve->num_words;
+
+	EccPoint_mult_deferred(result, z_num, z_den, point, scalar, initial_Z, num_bits, curve);
+
+	uECC_vli_modInv(z_den, z_den, curve->p, num_words); /* 1 / (xP * Yb * (X1 - X0)) */
+	uECC_vli_modMult_fast(z_num, z_num, z_den, curve);	/* Xb * yP / (xP * Yb * (X1 - X0)) */
+	apply_z(result, result + num_words, z_num, curve);
+}
+
+/* (X1 : Z1) => 2 * (X1 : Z1), in the x-only formulas of Brier and Joye for y^2 = x^3 + ax + b:
+   X' = (X^2 - aZ^2)^2 - 8bXZ^3, Z' = 4Z(X^3 + aXZ^2 + bZ^3). */
+static void XZ_double(uECC_word_t *X1, uECC_word_t *Z1, const uECC_word_t *a, uECC_Curve curve) {
+	uECC_word_t t1[uECC_MAX_WORDS];
+	uECC_word_t t2[uECC_MAX_WORDS];
+	uECC_word_t t3[uECC_MAX_WORDS];
+	uECC_word_t t4[uECC_MAX_WORDS];
+	wordcount_t num_words = curve->num_words;
+
+	uECC_vli_modSquare_fast(t1, X1, curve);				/* t1 = X^2 */
+	uECC_vli_modSquare_fast(t2, Z1, curve);				/* t2 = Z^2 */
+	uECC_vli_modMult_fast(t3, X1, Z1, curve);			/* t3 = XZ */
+	uECC_vli_modMult_fast(t4, a, t2, curve);			/* t4 = aZ^2 */
+	uECC_vli_modSub(X1, t1, t4, curve->p, num_words);	/* X1 = X^2 - aZ^2 */
+	uECC_vli_modSquare_fast(X1, X1, curve);				/* X1 = (X^2 - aZ^2)^2 */
+	uECC_vli_modAdd(t4, t4, t1, curve->p, num_words);	/* t4 = X^2 + aZ^2 */
+	uECC_vli_modMult_fast(t4, t4, t3, curve);			/* t4 = X^3 Z + aXZ^3 */
+	uECC_vli_modMult_fast(t1, curve->b, t2, curve);		/* t1 = bZ^2 */
+	uECC_vli_modMult_fast(t2, t1, t2, curve);			/* t2 = bZ^4 */
+	uECC_vli_modAdd(Z1, t4, t2, curve->p, num_words);	/* Z1 = X^3 Z + aXZ^3 + bZ^4 */
+	uECC_vli_modAdd(Z1, Z1, Z1, curve->p, num_words);
+	uECC_vli_modAdd(Z1, Z1, Z1, curve->p, num_words);	/* Z1 = 4Z(X^3 + aXZ^2 + bZ^3) */
+	uECC_vli_modMult_fast(t1, t1, t3, curve);			/* t1 = bXZ^3 */
+	uECC_vli_modAdd(t1, t1, t1, curve->p, num_words);
+	uECC_vli_modAdd(t1, t1, t1, curve->p, num_words);
+	uECC_vli_modAdd(t1, t1, t1, curve->p, num_words);	/* t1 = 8bXZ^3 */
+	uECC_vli_modSub(X1, X1, t1, curve->p, num_words);
+}
+
+/* (X1 : Z1) => (X1 : Z1) + (X2 : Z2), given the affine x of their difference:
+   X' = 2(X1Z2 + X2Z1)(X1X2 + aZ1Z2) + 4b(Z1Z2)^2 - x(X1Z2 - X2Z1)^2, Z' = (X1Z2 - X2Z1)^2.
+   The point at infinity comes out as Z' = 0 and goes in correctly. */
+static void XZ_add(
+	uECC_word_t *X1,
+	uECC_word_t *Z1,
+	const uECC_word_t *X2,
+	const uECC_word_t *Z2,
+	const uECC_word_t *x,
+	const uECC_word_t *a,
+	uECC_Curve curve
+) {
+	uECC_word_t t1[uECC_MAX_WORDS];
+	uECC_word_t t2[uECC_MAX_WORDS];
+	uECC_word_t t3[uECC_MAX_WORDS];
+	uECC_word_t t4[uECC_MAX_WORDS];
+	wordcount_t num_words = curve->num_words;
+
+	uECC_vli_modMult_fast(t1, X1, Z2, curve);			/* t1 = X1Z2 */
+	uECC_vli_modMult_fast(t2, X2, Z1, curve);			/* t2 = X2Z1 */
+	uECC_vli_modMult_fast(t3, X1, X2, curve);			/* t3 = X1X2 */
+	uECC_vli_modMult_fast(t4, Z1, Z2, curve);			/* t4 = Z1Z2 */
+	uECC_vli_modSub(Z1, t1, t2, curve->p, num_words);	/* Z1 = X1Z2 - X2Z1 */
+	uECC_vli_modSquare_fast(Z1, Z1, curve);				/* Z1 = (X1Z2 - X2Z1)^2 */
+	uECC_vli_modAdd(t1, t1, t2, curve->p, num_words);	/* t1 = X1Z2 + X2Z1 */
+	uECC_vli_modMult_fast(t2, a, t4, curve);			/* t2 = aZ1Z2 */
+	uECC_vli_modAdd(t3, t3, t2, curve->p, num_words);	/* t3 = X1X2 + aZ1Z2 */
+	uECC_vli_modMult_fast(t1, t1, t3, curve);
+	uECC_vli_modAdd(t1, t1, t1, curve->p, num_words);	/* t1 = 2(X1Z2 + X2Z1)(X1X2 + aZ1Z2) */
+	uECC_vli_modSquare_fast(t4, t4, curve);
+	uECC_vli_modMult_fast(t4, curve->b, t4, curve);
+	uECC_vli_modAdd(t4, t4, t4, curve->p, num_words);
+	uECC_vli_modAdd(t4, t4, t4, curve->p, num_words);	/* t4 = 4b(Z1Z2)^2 */
+	uECC_vli_modAdd(t1, t1, t4, curve->p, num_words);
+	uECC_vli_modMult_fast(t2, x, Z1, curve);			/* t2 = x(X1Z2 - X2Z1)^2 */
+	uECC_vli_modSub(X1, t1, t2, curve->p, num_words);
+}
+
+void EccPoint_mult_xz(
+	uECC_word_t *X,
+	uECC_word_t *Z,
+	const uECC_word_t *x,
+	const uECC_word_t *scalar,
+	bitcount_t num_bits,
+	uECC_Curve curve
+) {
+	/* R0 and R1, with R1 - R0 = P throughout */
+	uECC_word_t RX[2][uECC_MAX_WORDS];
+	uECC_word_t RZ[2][uECC_MAX_WORDS];
+	uECC_word_t a[uECC_MAX_WORDS];
+	uECC_word_t one[uECC_MAX_WORDS];
+	bitcount_t i;
+	uECC_word_t nb;
+	wordcount_t num_words = curve->num_words;
+
+	/* The curves only store b; x_side(1) = 1 + a + b gives a. */
+	uECC_vli_clear(one, num_words);
+	one[0] = 1;
+	curve->x_side(a, one, curve);
+	uECC_vli_modSub(a, a, one, curve->p, num_words);
+	uECC_vli_modSub(a, a, curve->b, curve->p, num_words);
+
+	uECC_vli_set(RX[0], x, num_words);
+	uECC_vli_set(RZ[0], one, num_words);
+	uECC_vli_set(RX[1], x, num_words);
+	uECC_vli_set(RZ[1], one, num_words);
+	XZ_double(RX[1], RZ[1], a, curve);
+
+	for (i = num_bits - 2; i >= 0; --i) {
+		nb = !uECC_vli_testBit(scalar, i);
+		XZ_add(RX[nb], RZ[nb], RX[1 - nb], RZ[1 - nb], x, a, curve);
+		XZ_double(RX[1 - nb], RZ[1 - nb], a, curve);
+	}
+
+	uECC_vli_set(X, RX[0], num_words);
+	uECC_vli_set(Z, RZ[0], num_words);
+}
+
+void EccPoint_apply_z_batch(
+	uECC_word_t (*points)[uECC_MAX_WORDS * 2],
+	uECC_word_t (*z_num)[uECC_MAX_WORDS],
+	uECC_word_t (*z_den)[uECC_MAX_WORDS],
+	unsigned count,
+	uECC_Curve curve
+) {
+	unsigned i;
+
+	uECC_vli_modInv_batch_fast(z_den, count, curve);
+	for (i = 0; i < count; ++i) {
+		uECC_vli_modMult_fast(z_num[i], z_num[i], z_den[i], curve);
+		apply_z(points[i], points[i] + curve->num_words, z_num[i], curve);
+	}
+}
+
+void EccPoint_add_G_deferred(uECC_word_t *sum, uECC_word_t *z_den, const uECC_word_t *point, uECC_Curve curve) {
+	uECC_word_t tx[uECC_MAX_WORDS];
+	uECC_word_t ty[uECC_MAX_WORDS];
+	wordcount_t num_words = curve->num_words;
+
+	uECC_vli_set(sum, point, num_words);
+	uECC_vli_set(sum + num_words, point + num_words, num_words);
+	uECC_vli_set(tx, curve->G, num_words);
+	uECC_vli_set(ty, curve->G + num_words, num_words);
+	uECC_vli_modSub(z_den, sum, tx, curve->p, num_words); /* z = x2 - x1 */
+	XYcZ_add(tx, ty, sum, sum + num_words, curve);
+}
+
+void EccPoint_add_G(uECC_word_t *sum, const uECC_word_t *point, uECC_Curve curve) {
+	uECC_word_t z[uECC_MAX_WORDS];
+
+	EccPoint_add_G_deferred(sum, z, point, curve);
+	uECC_vli_modInv(z, z, curve->p, curve->num_words); /* z = 1/z */
+	apply_z(sum, sum + curve->num_words, z, curve);
+}
+
+static bitcount_t smax(bitcount_t a, bitcount_t b) { return (a > b ? a : b); }
+
+void EccPoint_mult_shamir(
+	uECC_word_t *X,
+	uECC_word_t *Y,
+	uECC_word_t *Z,
+	const uECC_word_t *u1,
+	const uECC_word_t *u2,
+	const uECC_word_t *point,
+	const uECC_word_t *sum,
+	uECC_Curve curve
+) {
+	uECC_word_t tx[uECC_MAX_WORDS];
+	uECC_word_t ty[uECC_MAX_WORDS];
+	uECC_word_t tz[uECC_MAX_WORDS];
+	const uECC_word_t *points[4];
+	const uECC_word_t *p;
+	bitcount_t num_bits;
+	bitcount_t i;
+	wordcount_t num_words	= curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+	points[0] = 0;
+	points[1] = curve->G;
+	points[2] = point;
+	points[3] = sum;
+	num_bits  = smax(uECC_vli_numBits(u1, num_n_words), uECC_vli_numBits(u2, num_n_words));
+
+	uECC_vli_clear(Z, num_words);
+	if (num_bits == 0) {
+		/* u1 == u2 == 0, the result is the point at infinity. */
+		uECC_vli_clear(X, num_words);
+		uECC_vli_clear(Y, num_words);
+		return;
+	}
+
+	p = points[(!!uECC_vli_testBit(u1, num_bits - 1)) | ((!!uECC_vli_testBit(u2, num_bits - 1)) << 1)];
+	uECC_vli_set(X, p, num_words);
+	uECC_vli_set(Y, p + num_words, num_words);
+	Z[0] = 1;
+
+	for (i = num_bits - 2; i >= 0; --i) {
+		uECC_word_t index;
+		curve->double_jacobian(X, Y, Z, curve);
+
+		index = (!!uECC_vli_testBit(u1, i)) | ((!!uECC_vli_testBit(u2, i)) << 1);
+		p	  = points[index];
+		if (p) {
+			uECC_vli_set(tx, p, num_words);
+			uECC_vli_set(ty, p + num_words, num_words);
+			apply_z(tx, ty, Z, curve);
+			uECC_vli_modSub(tz, X, tx, curve->p, num_words); /* Z = x2 - x1 */
+			XYcZ_add(tx, ty, X, Y, curve);
+			uECC_vli_modMult_fast(Z, Z, tz, curve);
+		}
+	}
+}
+
+static void EccPoint_msm_flush(
+	uECC_word_t (*z)[uECC_MAX_WORDS], uECC_word_t **pending, unsigned used, uECC_Curve curve
+) {
+	unsigned i;
+	uECC_vli_modInv_batch_fast(z, used, curve);
+	for (i = 0; i < used; ++i) {
+		apply_z(pending[i], pending[i] + curve->num_words, z[i], curve);
+	}
+}
+
+void EccPoint_msm_init(
+	EccPoint_msm_term *terms,
+	uECC_word_t (*scalars)[uECC_MAX_WORDS],
+	unsigned count,
+	uECC_Curve curve
+) {
+	uECC_word_t D[uECC_MAX_WORDS * 2];
+	uECC_word_t T[uECC_MAX_WORDS * 2];
+	uECC_word_t zt[uECC_MAX_WORDS];
+	uECC_word_t diff[uECC_MAX_WORDS];
+	uECC_word_t z[uECC_BATCH_SIZE][uECC_MAX_WORDS];
+	uECC_word_t *pending[uECC_BATCH_SIZE];
+	unsigned used = 0;
+	unsigned i, k;
+	wordcount_t num_words	= curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+	for (i = 0; i < count; ++i) {
+		EccPoint_msm_term *term = &terms[i];
+
+		/* D = 2P and T = P share the Z coordinate zt after the initial double. */
+		uECC_vli_set(D, term->table[0], num_words * 2);
+		uECC_vli_set(T, term->table[0], num_words * 2);
+		uECC_vli_clear(zt, num_words);
+		zt[0] = 1;
+		curve->double_jacobian(D, D + num_words, zt, curve);
+		apply_z(T, T + num_words, zt, curve);
+
+		/* Each co-Z addition T = T + D multiplies the shared Z by (T.x - D.x). */
+		for (k = 1; k < uECC_WNAF_TABLE_SIZE; ++k) {
+			uECC_vli_modSub(diff, T, D, curve->p, num_words);
+			XYcZ_add(D, D + num_words, T, T + num_words, curve);
+			uECC_vli_modMult_fast(zt, zt, diff, curve);
+			uECC_vli_set(term->table[k], T, num_words * 2);
+			uECC_vli_set(z[used], zt, num_words);
+			pending[used++] = term->table[k];
+			if (used == uECC_BATCH_SIZE) {
+				EccPoint_msm_flush(z, pending, used, curve);
+				used = 0;
+			}
+		}
+
+		term->wnaf_len = uECC_vli_wnaf(term->wnaf, scalars[i], uECC_WNAF_WINDOW, num_n_words);
+	}
+	if (used) {
+		EccPoint_msm_flush(z, pending, used, curve);
+	}
+}
+
+int EccPoint_msm(
+	uECC_word_t *X,
+	uECC_word_t *Y,
+	uECC_word_t *Z,
+	const EccPoint_msm_term *terms,
+	unsigned count,
+	uECC_Curve curve
+) {
+	uECC_word_t tx[uECC_MAX_WORDS];
+	uECC_word_t ty[uECC_MAX_WORDS];
+	uECC_word_t tz[uECC_MAX_WORDS];
+	bitcount_t max_len = 0;
+	bitcount_t i;
+	unsigned j;
+	int started			  = 0;
+	wordcount_t num_words = curve->num_words;
+
+	for (j = 0; j < count; ++j) {
+		if (terms[j].wnaf_len > max_len) {
+			max_len = terms[j].wnaf_len;
+		}
+	}
+
+	for (i = max_len - 1; i >= 0; --i) {
+		if (started) {
+			curve->double_jacobian(X, Y, Z, curve);
+		}
+		for (j = 0; j < count; ++j) {
+			const uECC_word_t *entry;
+			int d;
+			if (i >= terms[j].wnaf_len || terms[j].wnaf[i] == 0) {
+				continue;
+			}
+			d	  = terms[j].wnaf[i];
+			entry = terms[j].table[(d < 0 ? -d : d) >> 1];
+			uECC_vli_set(tx, entry, num_words);
+			if (d > 0) {
+				uECC_vli_set(ty, entry + num_words, num_words);
+			} else {
+				uECC_vli_sub(ty, curve->p, entry + num_words, num_words);
+			}
+			if (!started) {
+				uECC_vli_set(X, tx, num_words);
+				uECC_vli_set(Y, ty, num_words);
+				uECC_vli_clear(Z, num_words);
+				Z[0]	= 1;
+				started = 1;
+				continue;
+			}
+			apply_z(tx, ty, Z, curve);
+			uECC_vli_modSub(tz, X, tx, curve->p, num_words); /* Z = x2 - x1 */
+			if (uECC_vli_isZero(tz, num_words)) {
+				return 0; /* doubling or cancellation, which the co-Z addition cannot express */
+			}
+			XYcZ_add(tx, ty, X, Y, curve);
+			uECC_vli_modMult_fast(Z, Z, tz, curve);
+		}
+	}
+	return started;
+}
+
 uECC_word_t regularize_k(const uECC_word_t *const k, uECC_word_t *k0, uECC_word_t *k1, uECC_Curve curve) {
 	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
 	bitcount_t num_n_bits	= curve->num_n_bits;
@@ -170,6 +509,26 @@ uECC_word_t regularize_k(const uECC_word_t *const k, uECC_word_t *k0, uECC_word_
 	return carry;
 }
 
+int EccPoint_mult_G_edge(uECC_word_t *result, const uECC_word_t *k, uECC_Curve curve) {
+	uECC_word_t k1[uECC_MAX_WORDS];
+	wordcount_t num_words	= curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+	uECC_vli_clear(k1, num_n_words);
+	k1[0] = 1;
+	uECC_vli_set(result, curve->G, num_words);
+	if (uECC_vli_equal(k, k1, num_n_words)) {
+		uECC_vli_set(result + num_words, curve->G + num_words, num_words);
+		return 1;
+	}
+	uECC_vli_add(k1, k, k1, num_n_words);
+	if (uECC_vli_equal(k1, curve->n, num_n_words)) {
+		uECC_vli_sub(result + num_words, curve->p, curve->G + num_words, num_words);
+		return 1;
+	}
+	return 0;
+}
+
 uECC_word_t EccPoint_compute_public_key(uECC_word_t *result, uECC_word_t *private_key, uECC_Curve curve) {
 	uECC_word_t tmp1[uECC_MAX_WORDS];
 	uECC_word_t tmp2[uECC_MAX_WORDS];
@@ -177,6 +536,10 @@ uECC_word_t EccPoint_compute_public_key(uECC_word_t *result, uECC_word_t *privat
 	uECC_word_t *initial_Z = 0;
 	uECC_word_t carry;
 
+	if (EccPoint_mult_G_edge(result, private_key, curve)) {
+		return 1;
+	}
+
 	/* Regularize the bitcount for the private key so that attackers cannot use a side channel
 	 attack to learn the number of leading zeros. */
 	carry = regularize_k(private_key, tmp1, tmp2, curve);
@@ -42,6 +42,21 @@ void XYcZ_add(uECC_word_t *X1, uECC_word_t *Y1, uECC_word_t *X2, uECC_word_t *Y2
  */
 void XYcZ_addC(uECC_word_t *X1, uECC_word_t *Y1, uECC_word_t *X2, uECC_word_t *Y2, uECC_Curve curve);
 
+/* Computes result = scalar * point like EccPoint_mult(), but stops before the final field
+   inversion. The affine result is apply_z(result, z_num / z_den), which lets callers share one
+   inversion across many multiplications. z_den is zero only for the point at infinity.
+   result may overlap point. */
+void EccPoint_mult_deferred(
+	uECC_word_t *result,
+	uECC_word_t *z_num,
+	uECC_word_t *z_den,
+	const uECC_word_t *point,
+	const uECC_word_t *scalar,
+	const uECC_word_t *initial_Z,
+	bitcount_t num_bits,
+	uECC_Curve curve
+);
+
 /* result may overlap point. */
 void EccPoint_mult(
 	uECC_word_t *result,
@@ -52,8 +67,93 @@ void EccPoint_mult(
 	uECC_Curve curve
 );
 
+/* Computes the x coordinate of scalar * P from the affine x of P alone, with a Montgomery ladder
+   on projective (X : Z) that never touches y. The affine x is X / Z, which callers may invert in
+   batches. Z is zero only for the point at infinity. scalar must have bit num_bits - 1 set, as
+   regularize_k() ensures. */
+void EccPoint_mult_xz(
+	uECC_word_t *X,
+	uECC_word_t *Z,
+	const uECC_word_t *x,
+	const uECC_word_t *scalar,
+	bitcount_t num_bits,
+	uECC_Curve curve
+);
+
+/* Finishes count results of EccPoint_mult_deferred() with a single field inversion.
+   Every z_den must be non-zero; z_num and z_den are clobbered. */
+void EccPoint_apply_z_batch(
+	uECC_word_t (*points)[uECC_MAX_WORDS * 2],
+	uECC_word_t (*z_num)[uECC_MAX_WORDS],
+	uECC_word_t (*z_den)[uECC_MAX_WORDS],
+	unsigned count,
+	uECC_Curve curve
+);
+
+/* Computes sum = G + point in co-Z coordinates. The affine sum is apply_z(sum, 1 / z_den).
+   point must not be G or -G. */
+void EccPoint_add_G_deferred(uECC_word_t *sum, uECC_word_t *z_den, const uECC_word_t *point, uECC_Curve curve);
+
+/* Computes the affine sum = G + point. point must not be G or -G. */
+void EccPoint_add_G(uECC_word_t *sum, const uECC_word_t *point, uECC_Curve curve);
+
+/* Computes (X, Y, Z) = u1 * G + u2 * point in Jacobian coordinates using Shamir's trick, where
+   sum is the affine G + point. Z is zero if the result is the point at infinity.
+   Not constant time; only for public inputs. */
+void EccPoint_mult_shamir(
+	uECC_word_t *X,
+	uECC_word_t *Y,
+	uECC_word_t *Z,
+	const uECC_word_t *u1,
+	const uECC_word_t *u2,
+	const uECC_word_t *point,
+	const uECC_word_t *sum,
+	uECC_Curve curve
+);
+
+/* Window width of the wNAF recoding used by EccPoint_msm(). Each term keeps the
+   2^(uECC_WNAF_WINDOW - 2) odd multiples P, 3P, 5P, ... of its point. */
+#define uECC_WNAF_WINDOW	 4
+#define uECC_WNAF_TABLE_SIZE (1 << (uECC_WNAF_WINDOW - 2))
+#define uECC_WNAF_MAX_DIGITS (uECC_MAX_WORDS * uECC_WORD_BITS + 1)
+
+/* One scalar * point term of a multi-scalar multiplication. */
+typedef struct {
+	uECC_word_t table[uECC_WNAF_TABLE_SIZE][uECC_MAX_WORDS * 2]; /* affine odd multiples */
+	int8_t wnaf[uECC_WNAF_MAX_DIGITS];
+	bitcount_t wnaf_len;
+} EccPoint_msm_term;
+
+/* Prepares count terms for EccPoint_msm(). On entry table[0] of every term holds its affine
+   point; the remaining odd multiples share one field inversion per uECC_BATCH_SIZE entries.
+   Not constant time; only for public inputs. */
+void EccPoint_msm_init(
+	EccPoint_msm_term *terms,
+	uECC_word_t (*scalars)[uECC_MAX_WORDS],
+	unsigned count,
+	uECC_Curve curve
+);
+
+/* Computes (X, Y, Z) = sum of scalar * point over all terms in Jacobian coordinates, sharing
+   the doublings between the terms (Straus' method). Returns 0, leaving the output undefined, if
+   the sum is empty or an addition would double a point or reach the point at infinity; callers
+   must treat that as "unknown" rather than as a result.
+   Not constant time; only for public inputs. */
+int EccPoint_msm(
+	uECC_word_t *X,
+	uECC_word_t *Y,
+	uECC_word_t *Z,
+	const EccPoint_msm_term *terms,
+	unsigned count,
+	uECC_Curve curve
+);
+
 uECC_word_t regularize_k(const uECC_word_t *const k, uECC_word_t *k0, uECC_word_t *k1, uECC_Curve curve);
 
+/* Sets result to k * G and returns 1 if k is 1 or n - 1, whose public keys G and -G the co-Z
+   ladder cannot compute, and returns 0 for any other k in [1, n-1]. */
+int EccPoint_mult_G_edge(uECC_word_t *result, const uECC_word_t *k, uECC_Curve curve);
+
 uECC_word_t EccPoint_compute_public_key(uECC_word_t *result, uECC_word_t *private_key, uECC_Curve curve);
 
 void uECC_point_mult(uECC_word_t *result, const uECC_word_t *point, const uECC_word_t *scalar, uECC_Curve curve);
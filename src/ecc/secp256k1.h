@@ -16,6 +16,7 @@
 #include "vli.h"
 
 static void double_jacobian_secp256k1(uECC_word_t *X1, uECC_word_t *Y1, uECC_word_t *Z1, uECC_Curve curve);
+static void mod_sqrt_secp256k1(uECC_word_t *a, uECC_Curve curve);
 static void x_side_secp256k1(uECC_word_t *result, const uECC_word_t *x, uECC_Curve curve);
 static void vli_mmod_fast_secp256k1(uECC_word_t *result, uECC_word_t *product);
 static void omega_mult_secp256k1(uECC_word_t *result, const uECC_word_t *right);
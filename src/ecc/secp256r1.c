@@ -0,0 +1,212 @@
+//
+//  secp256r1.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+// ---------------------------------------------------------------------
+//  adapted from micro-ecc
+//  Copyright © 2015, Kenneth MacKay. BSD 2-clause license
+// ---------------------------------------------------------------------
+
+#include "secp256r1.h"
+
+#if uECC_SUPPORTS_secp256r1
+
+static const struct uECC_Curve_t curve_secp256r1 = {
+	num_words_secp256r1,
+	num_bytes_secp256r1,
+	256, /* num_n_bits */
+	{BYTES_TO_WORDS_8(FF, FF, FF, FF, FF, FF, FF, FF),
+	 BYTES_TO_WORDS_8(FF, FF, FF, FF, 00, 00, 00, 00),
+	 BYTES_TO_WORDS_8(00, 00, 00, 00, 00, 00, 00, 00),
+	 BYTES_TO_WORDS_8(01, 00, 00, 00, FF, FF, FF, FF)},
+	{BYTES_TO_WORDS_8(51, 25, 63, FC, C2, CA, B9, F3),
+	 BYTES_TO_WORDS_8(84, 9E, 17, A7, AD, FA, E6, BC),
+	 BYTES_TO_WORDS_8(FF, FF, FF, FF, FF, FF, FF, FF),
+	 BYTES_TO_WORDS_8(00, 00, 00, 00, FF, FF, FF, FF)},
+	{BYTES_TO_WORDS_8(96, C2, 98, D8, 45, 39, A1, F4),
+	 BYTES_TO_WORDS_8(A0, 33, EB, 2D, 81, 7D, 03, 77),
+	 BYTES_TO_WORDS_8(F2, 40, A4, 63, E5, E6, BC, F8),
+	 BYTES_TO_WORDS_8(47, 42, 2C, E1, F2, D1, 17, 6B),
+
+	 BYTES_TO_WORDS_8(F5, 51, BF, 37, 68, 40, B6, CB),
+	 BYTES_TO_WORDS_8(CE, 5E, 31, 6B, 57, 33, CE, 2B),
+	 BYTES_TO_WORDS_8(16, 9E, 0F, 7C, 4A, EB, E7, 8E),
+	 BYTES_TO_WORDS_8(9B, 7F, 1A, FE, E2, 42, E3, 4F)},
+	{BYTES_TO_WORDS_8(4B, 60, D2, 27, 3E, 3C, CE, 3B),
+	 BYTES_TO_WORDS_8(F6, B0, 53, CC, B0, 06, 1D, 65),
+	 BYTES_TO_WORDS_8(BC, 86, 98, 76, 55, BD, EB, B3),
+	 BYTES_TO_WORDS_8(E7, 93, 3A, AA, D8, 35, C6, 5A)},
+	&double_jacobian_secp256r1,
+	&mod_sqrt_secp256r1,
+	&x_side_secp256r1,
+	&vli_mmod_fast_secp256r1};
+
+uECC_Curve uECC_secp256r1(void) { return &curve_secp256r1; }
+
+/* Double in place, using a = -3: 3*x1^2 + a*z1^4 = 3*(x1 - z1^2)*(x1 + z1^2) trades the two
+   squarings of the general formula for one multiplication. */
+static void double_jacobian_secp256r1(uECC_word_t *X1, uECC_word_t *Y1, uECC_word_t *Z1, uECC_Curve curve) {
+	/* t1 = X, t2 = Y, t3 = Z */
+	uECC_word_t t4[num_words_secp256r1];
+	uECC_word_t t5[num_words_secp256r1];
+
+	if (uECC_vli_isZero(Z1, num_words_secp256r1)) {
+		return;
+	}
+
+	uECC_vli_modSquare_fast(t4, Y1, curve);	  /* t4 = y1^2 */
+	uECC_vli_modMult_fast(t5, X1, t4, curve); /* t5 = x1*y1^2 = A */
+	uECC_vli_modSquare_fast(t4, t4, curve);	  /* t4 = y1^4 */
+	uECC_vli_modMult_fast(Y1, Y1, Z1, curve); /* t2 = y1*z1 = z3 */
+	uECC_vli_modSquare_fast(Z1, Z1, curve);	  /* t3 = z1^2 */
+
+	uECC_vli_modAdd(X1, X1, Z1, curve->p, num_words_secp256r1); /* t1 = x1 + z1^2 */
+	uECC_vli_modAdd(Z1, Z1, Z1, curve->p, num_words_secp256r1); /* t3 = 2*z1^2 */
+	uECC_vli_modSub(Z1, X1, Z1, curve->p, num_words_secp256r1); /* t3 = x1 - z1^2 */
+	uECC_vli_modMult_fast(X1, X1, Z1, curve);					/* t1 = x1^2 - z1^4 */
+
+	uECC_vli_modAdd(Z1, X1, X1, curve->p, num_words_secp256r1); /* t3 = 2*(x1^2 - z1^4) */
+	uECC_vli_modAdd(X1, X1, Z1, curve->p, num_words_secp256r1); /* t1 = 3*(x1^2 - z1^4) */
+	if (uECC_vli_testBit(X1, 0)) {
+		uECC_word_t carry = uECC_vli_add(X1, X1, curve->p, num_words_secp256r1);
+		uECC_vli_rshift1(X1, num_words_secp256r1);
+		X1[num_words_secp256r1 - 1] |= carry << (uECC_WORD_BITS - 1);
+	} else {
+		uECC_vli_rshift1(X1, num_words_secp256r1);
+	}
+	/* t1 = 3/2*(x1^2 - z1^4) = B */
+
+	uECC_vli_modSquare_fast(Z1, X1, curve);						/* t3 = B^2 */
+	uECC_vli_modSub(Z1, Z1, t5, curve->p, num_words_secp256r1); /* t3 = B^2 - A */
+	uECC_vli_modSub(Z1, Z1, t5, curve->p, num_words_secp256r1); /* t3 = B^2 - 2A = x3 */
+	uECC_vli_modSub(t5, t5, Z1, curve->p, num_words_secp256r1); /* t5 = A - x3 */
+	uECC_vli_modMult_fast(X1, X1, t5, curve);					/* t1 = B * (A - x3) */
+	uECC_vli_modSub(t4, X1, t4, curve->p, num_words_secp256r1); /* t4 = B * (A - x3) - y1^4 = y3 */
+
+	uECC_vli_set(X1, Z1, num_words_secp256r1);
+	uECC_vli_set(Z1, Y1, num_words_secp256r1);
+	uECC_vli_set(Y1, t4, num_words_secp256r1);
+}
+
+/* Computes result = x^3 - 3x + b. result must not overlap x. */
+static void x_side_secp256r1(uECC_word_t *result, const uECC_word_t *x, uECC_Curve curve) {
+	uECC_word_t _3[num_words_secp256r1] = {3}; /* -a = 3 */
+
+	uECC_vli_modSquare_fast(result, x, curve);								  /* r = x^2 */
+	uECC_vli_modSub(result, result, _3, curve->p, num_words_secp256r1);		  /* r = x^2 - 3 */
+	uECC_vli_modMult_fast(result, result, x, curve);						  /* r = x^3 - 3x */
+	uECC_vli_modAdd(result, result, curve->b, curve->p, num_words_secp256r1); /* r = x^3 - 3x + b */
+}
+
+/* Computes result = a^(2^n). result may alias a. */
+static void mod_square_n_secp256r1(uECC_word_t *result, const uECC_word_t *a, int n, uECC_Curve curve) {
+	uECC_vli_set(result, a, num_words_secp256r1);
+	while (n-- > 0) {
+		uECC_vli_modSquare_fast(result, result, curve);
+	}
+}
+
+/* Computes a = a^((p + 1) / 4), the square root of a if there is one. The exponent is
+   (2^32 - 1) * 2^222 + 2^190 + 2^94, so after building a^(2^32 - 1) the chain needs only two
+   more multiplications: 254 squarings and 7 multiplications in all. */
+static void mod_sqrt_secp256r1(uECC_word_t *a, uECC_Curve curve) {
+	uECC_word_t x[num_words_secp256r1], t[num_words_secp256r1];
+
+	uECC_vli_modSquare_fast(x, a, curve);
+	uECC_vli_modMult_fast(x, x, a, curve); /* x2 = a^(2^2 - 1) */
+	mod_square_n_secp256r1(t, x, 2, curve);
+	uECC_vli_modMult_fast(x, t, x, curve); /* x4 */
+	mod_square_n_secp256r1(t, x, 4, curve);
+	uECC_vli_modMult_fast(x, t, x, curve); /* x8 */
+	mod_square_n_secp256r1(t, x, 8, curve);
+	uECC_vli_modMult_fast(x, t, x, curve); /* x16 */
+	mod_square_n_secp256r1(t, x, 16, curve);
+	uECC_vli_modMult_fast(x, t, x, curve); /* x32 */
+
+	mod_square_n_secp256r1(x, x, 32, curve);
+	uECC_vli_modMult_fast(x, x, a, curve);
+	mod_square_n_secp256r1(x, x, 96, curve);
+	uECC_vli_modMult_fast(x, x, a, curve);
+	mod_square_n_secp256r1(a, x, 94, curve);
+}
+
+/* Solinas reduction (FIPS 186-4 D.2.3): with the product split into 32-bit limbs c0..c15,
+   result = t + 2*s1 + 2*s2 + s3 + s4 - d1 - d2 - d3 - d4 (mod p), where every term is a
+   256-bit rearrangement of the upper limbs. The running carry stays within [-4, 5]. */
+static void vli_mmod_fast_secp256r1(uECC_word_t *result, uECC_word_t *product) {
+	uECC_word_t tmp[num_words_secp256r1];
+	int carry;
+
+	/* t */
+	uECC_vli_set(result, product, num_words_secp256r1);
+
+	/* s1 */
+	tmp[0] = 0;
+	tmp[1] = product[5] & 0xffffffff00000000ull;
+	tmp[2] = product[6];
+	tmp[3] = product[7];
+	carry  = (int)uECC_vli_add(tmp, tmp, tmp, num_words_secp256r1);
+	carry += (int)uECC_vli_add(result, result, tmp, num_words_secp256r1);
+
+	/* s2 */
+	tmp[1] = product[6] << 32;
+	tmp[2] = (product[6] >> 32) | (product[7] << 32);
+	tmp[3] = product[7] >> 32;
+	carry += (int)uECC_vli_add(tmp, tmp, tmp, num_words_secp256r1);
+	carry += (int)uECC_vli_add(result, result, tmp, num_words_secp256r1);
+
+	/* s3 */
+	tmp[0] = product[4];
+	tmp[1] = product[5] & 0xffffffff;
+	tmp[2] = 0;
+	tmp[3] = product[7];
+	carry += (int)uECC_vli_add(result, result, tmp, num_words_secp256r1);
+
+	/* s4 */
+	tmp[0] = (product[4] >> 32) | (product[5] << 32);
+	tmp[1] = (product[5] >> 32) | (product[6] & 0xffffffff00000000ull);
+	tmp[2] = product[7];
+	tmp[3] = (product[6] >> 32) | (product[4] << 32);
+	carry += (int)uECC_vli_add(result, result, tmp, num_words_secp256r1);
+
+	/* d1 */
+	tmp[0] = (product[5] >> 32) | (product[6] << 32);
+	tmp[1] = (product[6] >> 32);
+	tmp[2] = 0;
+	tmp[3] = (product[4] & 0xffffffff) | (product[5] << 32);
+	carry -= (int)uECC_vli_sub(result, result, tmp, num_words_secp256r1);
+
+	/* d2 */
+	tmp[0] = product[6];
+	tmp[1] = product[7];
+	tmp[2] = 0;
+	tmp[3] = (product[4] >> 32) | (product[5] & 0xffffffff00000000ull);
+	carry -= (int)uECC_vli_sub(result, result, tmp, num_words_secp256r1);
+
+	/* d3 */
+	tmp[0] = (product[6] >> 32) | (product[7] << 32);
+	tmp[1] = (product[7] >> 32) | (product[4] << 32);
+	tmp[2] = (product[4] >> 32) | (product[5] << 32);
+	tmp[3] = (product[6] << 32);
+	carry -= (int)uECC_vli_sub(result, result, tmp, num_words_secp256r1);
+
+	/* d4 */
+	tmp[0] = product[7];
+	tmp[1] = product[4] & 0xffffffff00000000ull;
+	tmp[2] = product[5];
+	tmp[3] = product[6] & 0xffffffff00000000ull;
+	carry -= (int)uECC_vli_sub(result, result, tmp, num_words_secp256r1);
+
+	if (carry < 0) {
+		do {
+			carry += (int)uECC_vli_add(result, result, curve_secp256r1.p, num_words_secp256r1);
+		} while (carry < 0);
+	} else {
+		while (carry || uECC_vli_cmp_unsafe(curve_secp256r1.p, result, num_words_secp256r1) != 1) {
+			carry -= (int)uECC_vli_sub(result, result, curve_secp256r1.p, num_words_secp256r1);
+		}
+	}
+}
+
+#endif /* uECC_SUPPORTS_secp256r1 */
@@ -0,0 +1,23 @@
+//
+//  secp256r1.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+// ---------------------------------------------------------------------
+//  adapted from micro-ecc
+//  Copyright © 2015, Kenneth MacKay. BSD 2-clause license
+// ---------------------------------------------------------------------
+
+#ifndef secp256r1_h
+#define secp256r1_h
+
+#include "common.h"
+#include "curve.h"
+#include "vli.h"
+
+static void double_jacobian_secp256r1(uECC_word_t *X1, uECC_word_t *Y1, uECC_word_t *Z1, uECC_Curve curve);
+static void mod_sqrt_secp256r1(uECC_word_t *a, uECC_Curve curve);
+static void x_side_secp256r1(uECC_word_t *result, const uECC_word_t *x, uECC_Curve curve);
+static void vli_mmod_fast_secp256r1(uECC_word_t *result, uECC_word_t *product);
+
+#endif /* secp256r1_h */
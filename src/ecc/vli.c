@@ -326,6 +326,71 @@ void uECC_vli_modInv(uECC_word_t *result, const uECC_word_t *input, const uECC_w
 	uECC_vli_set(result, u, num_words);
 }
 
+/* Computes values[i] = (1 / values[i]) % mod using a single modular inversion.
+   prefix[i] holds values[0] * ... * values[i]; walking back from the inverse of the full product
+   peels off one value per step. */
+void uECC_vli_modInv_batch(
+	uECC_word_t (*values)[uECC_MAX_WORDS],
+	unsigned count,
+	const uECC_word_t *mod,
+	wordcount_t num_words
+) {
+	uECC_word_t prefix[uECC_BATCH_SIZE][uECC_MAX_WORDS];
+	uECC_word_t inv[uECC_MAX_WORDS];
+	uECC_word_t tmp[uECC_MAX_WORDS];
+	unsigned i;
+
+	if (count == 0) {
+		return;
+	}
+
+	uECC_vli_set(prefix[0], values[0], num_words);
+	for (i = 1; i < count; ++i) {
+		uECC_vli_modMult(prefix[i], prefix[i - 1], values[i], mod, num_words);
+	}
+
+	uECC_vli_modInv(inv, prefix[count - 1], mod, num_words);
+
+	for (i = count - 1; i > 0; --i) {
+		uECC_vli_modMult(tmp, inv, prefix[i - 1], mod, num_words); /* tmp = 1 / values[i] */
+		uECC_vli_modMult(inv, inv, values[i], mod, num_words);	   /* inv = 1 / prefix[i - 1] */
+		uECC_vli_set(values[i], tmp, num_words);
+	}
+	uECC_vli_set(values[0], inv, num_words);
+}
+
+bitcount_t uECC_vli_wnaf(int8_t *wnaf, const uECC_word_t *scalar, unsigned w, wordcount_t num_words) {
+	uECC_word_t k[uECC_MAX_WORDS + 1];
+	uECC_word_t digit[uECC_MAX_WORDS + 1];
+	bitcount_t len = 0;
+	int d;
+
+	uECC_vli_set(k, scalar, num_words);
+	k[num_words] = 0;
+	uECC_vli_clear(digit, num_words + 1);
+
+	while (!uECC_vli_isZero(k, num_words + 1)) {
+		d = 0;
+		if (k[0] & 1) {
+			d = (int)(k[0] & ((1u << w) - 1));
+			if (d >= (1 << (w - 1))) {
+				d -= (1 << w);
+			}
+			/* k -= d */
+			if (d > 0) {
+				digit[0] = (uECC_word_t)d;
+				uECC_vli_sub(k, k, digit, num_words + 1);
+			} else {
+				digit[0] = (uECC_word_t)-d;
+				uECC_vli_add(k, k, digit, num_words + 1);
+			}
+		}
+		wnaf[len++] = (int8_t)d;
+		uECC_vli_rshift1(k, num_words + 1);
+	}
+	return len;
+}
+
 static void mul2add(uECC_word_t a, uECC_word_t b, uECC_word_t *r0, uECC_word_t *r1, uECC_word_t *r2) {
 	uECC_dword_t p	 = (uECC_dword_t)a * b;
 	uECC_dword_t r01 = ((uECC_dword_t)(*r1) << uECC_WORD_BITS) | *r0;
@@ -361,9 +426,3 @@ void uECC_vli_square(uECC_word_t *result, const uECC_word_t *left, wordcount_t n
 
 	result[num_words * 2 - 1] = r0;
 }
-
-#include "../hmac/scalar.h"
-
-void uECC_vli_negate(uECC_word_t *vli) { secp256k1_scalar_negate((secp256k1_scalar *)vli, (secp256k1_scalar *)vli); }
-
-int uECC_vli_is_high(uECC_word_t *vli) { return secp256k1_scalar_is_high((secp256k1_scalar *)vli); }
@@ -101,6 +101,24 @@ void uECC_vli_modSquare(uECC_word_t *result, const uECC_word_t *left, const uECC
 /* Computes result = (1 / input) % mod.*/
 void uECC_vli_modInv(uECC_word_t *result, const uECC_word_t *input, const uECC_word_t *mod, wordcount_t num_words);
 
+/* Computes values[i] = (1 / values[i]) % mod for every value using a single modular inversion
+   (Montgomery's trick). All values must be non-zero; count must not exceed uECC_BATCH_SIZE. */
+void uECC_vli_modInv_batch(
+	uECC_word_t (*values)[uECC_MAX_WORDS],
+	unsigned count,
+	const uECC_word_t *mod,
+	wordcount_t num_words
+);
+
+/* Computes values[i] = (1 / values[i]) % curve->p, as uECC_vli_modInv_batch(). */
+void uECC_vli_modInv_batch_fast(uECC_word_t (*values)[uECC_MAX_WORDS], unsigned count, uECC_Curve curve);
+
+/* Computes the width-w non-adjacent form of scalar: every digit is zero or odd with absolute
+   value below 2^(w-1), and any w consecutive digits hold at most one non-zero digit. wnaf must
+   have room for num_words * uECC_WORD_BITS + 1 digits. Returns the number of digits written.
+   Not constant time; only for public scalars. */
+bitcount_t uECC_vli_wnaf(int8_t *wnaf, const uECC_word_t *scalar, unsigned w, wordcount_t num_words);
+
 /* Calculates a = sqrt(a) (mod curve->p) */
 void uECC_vli_mod_sqrt(uECC_word_t *a, uECC_Curve curve);
 
@@ -116,8 +134,10 @@ int uECC_valid_point(const uECC_word_t *point, uECC_Curve curve);
    that scalar must be curve->num_n_words long (NOT curve->num_words). */
 void uECC_point_mult(uECC_word_t *result, const uECC_word_t *point, const uECC_word_t *scalar, uECC_Curve curve);
 
-void uECC_vli_negate(uECC_word_t *vli);
+/* Computes vli = (curve_n - vli) % curve_n. */
+void uECC_vli_negate(uECC_word_t *vli, uECC_Curve curve);
 
-int uECC_vli_is_high(uECC_word_t *vli);
+/* Returns 1 if vli > curve_n / 2, 0 otherwise. */
+int uECC_vli_is_high(const uECC_word_t *vli, uECC_Curve curve);
 
 #endif /* vli_h */
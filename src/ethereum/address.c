@@ -0,0 +1,120 @@
+//
+//  address.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#include "address.h"
+#include "../ecc/core.h"
+#include "../keccak256/keccak256.h"
+
+#include <string.h>
+
+int ethereum_addresses(
+	uint8_t *addresses, const uint8_t *keys, unsigned count, ethereum_key_format format, uint8_t *valid
+) {
+	uint8_t public_keys[uECC_BATCH_SIZE][64];
+	uint8_t hashes[uECC_BATCH_SIZE][32];
+	uint8_t ok[uECC_BATCH_SIZE];
+	const uint8_t *inputs[uECC_BATCH_SIZE] = {NULL};
+	size_t sizes[uECC_BATCH_SIZE]		   = {0};
+	unsigned map[uECC_BATCH_SIZE];
+	unsigned done, i, hashed;
+	uECC_Curve curve = uECC_secp256k1();
+	int ret			 = 1;
+
+	if (format != ETHEREUM_KEY_PRIVATE && format != ETHEREUM_KEY_COMPRESSED && format != ETHEREUM_KEY_RAW &&
+		format != ETHEREUM_KEY_UNCOMPRESSED) {
+		return 0;
+	}
+
+	for (done = 0; done < count; done += uECC_BATCH_SIZE) {
+		unsigned chunk	   = count - done < uECC_BATCH_SIZE ? count - done : uECC_BATCH_SIZE;
+		const uint8_t *key = keys + (size_t)done * format;
+
+		/* Bring every key of the chunk to x || y, in place where the caller's buffer has it. */
+		if (format == ETHEREUM_KEY_PRIVATE) {
+			uECC_compute_public_key_batch(key, chunk, 0, public_keys[0], ok, curve);
+		}
+		hashed = 0;
+		for (i = 0; i < chunk; ++i, key += format) {
+			const uint8_t *point = public_keys[i];
+			switch (format) {
+			case ETHEREUM_KEY_PRIVATE:
+				break;
+			case ETHEREUM_KEY_COMPRESSED:
+				ok[i] = (uint8_t)uECC_decompress(key, public_keys[i], curve);
+				break;
+			case ETHEREUM_KEY_UNCOMPRESSED:
+				point = key + 1;
+				ok[i] = key[0] == 0x04 && uECC_valid_public_key(point, curve);
+				break;
+			case ETHEREUM_KEY_RAW:
+				point = key;
+				ok[i] = (uint8_t)uECC_valid_public_key(point, curve);
+				break;
+			}
+			if (ok[i]) {
+				inputs[hashed] = point;
+				sizes[hashed]  = 64;
+				map[hashed++]  = i;
+			} else {
+				memset(addresses + (size_t)(done + i) * 20, 0, 20);
+			}
+			if (valid) {
+				valid[done + i] = ok[i];
+			}
+			ret &= ok[i];
+		}
+
+		keccak256_batch(hashes[0], inputs, sizes, hashed);
+		for (i = 0; i < hashed; ++i) {
+			memcpy(addresses + (size_t)(done + map[i]) * 20, hashes[i] + 12, 20);
+		}
+	}
+	return ret;
+}
+
+int ethereum_address(uint8_t *address, const uint8_t *key, ethereum_key_format format) {
+	return ethereum_addresses(address, key, 1, format, NULL);
+}
+
+void ethereum_addresses_to_hex(char *hex, const uint8_t *addresses, unsigned count) {
+	static const char digits[] = "0123456789abcdef";
+	const uint8_t *inputs[uECC_BATCH_SIZE];
+	size_t sizes[uECC_BATCH_SIZE];
+	uint8_t hashes[uECC_BATCH_SIZE][32];
+	unsigned done, i, j;
+
+	for (done = 0; done < count; done += uECC_BATCH_SIZE) {
+		unsigned chunk = count - done < uECC_BATCH_SIZE ? count - done : uECC_BATCH_SIZE;
+
+		/* The checksum hashes the lowercase digits, which are written in place first. */
+		for (i = 0; i < chunk; ++i) {
+			char *out			 = hex + (size_t)(done + i) * (ETHEREUM_ADDRESS_HEX_SIZE + 1);
+			const uint8_t *bytes = addresses + (size_t)(done + i) * 20;
+			out[0]				 = '0';
+			out[1]				 = 'x';
+			for (j = 0; j < 20; ++j) {
+				out[2 + 2 * j] = digits[bytes[j] >> 4];
+				out[3 + 2 * j] = digits[bytes[j] & 0x0f];
+			}
+			out[ETHEREUM_ADDRESS_HEX_SIZE] = '\0';
+			inputs[i]					   = (const uint8_t *)out + 2;
+			sizes[i]					   = 40;
+		}
+		keccak256_batch(hashes[0], inputs, sizes, chunk);
+
+		/* A letter is uppercased when the matching nibble of the hash is 8 or more. */
+		for (i = 0; i < chunk; ++i) {
+			char *out = hex + (size_t)(done + i) * (ETHEREUM_ADDRESS_HEX_SIZE + 1) + 2;
+			for (j = 0; j < 40; ++j) {
+				uint8_t nibble = (uint8_t)(j % 2 == 0 ? hashes[i][j / 2] >> 4 : hashes[i][j / 2] & 0x0f);
+				if (out[j] >= 'a' && nibble >= 8) {
+					out[j] = (char)(out[j] - 'a' + 'A');
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,42 @@
+//
+//  address.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#ifndef address_h
+#define address_h
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Length of a checksummed address, "0x" and 40 hex digits, without the terminating NUL. */
+#define ETHEREUM_ADDRESS_HEX_SIZE 42
+
+/* Forms of the secp256k1 keys ethereum_addresses() accepts, named by their size in bytes. */
+typedef enum {
+	ETHEREUM_KEY_PRIVATE	  = 32, /* big-endian private key */
+	ETHEREUM_KEY_COMPRESSED	  = 33, /* 0x02 or 0x03, then x */
+	ETHEREUM_KEY_RAW		  = 64, /* x || y */
+	ETHEREUM_KEY_UNCOMPRESSED = 65  /* 0x04, then x || y */
+} ethereum_key_format;
+
+/* Computes the 20-byte address keccak256(x || y)[12..32] of one key. Returns 1 on success, 0 if
+   the key is not a valid key of its format, in which case address is zeroed. */
+int ethereum_address(uint8_t *address, const uint8_t *key, ethereum_key_format format);
+
+/* Computes the addresses of count keys of the same format, stored back to back, into addresses,
+   20 bytes each. Private keys share one field inversion per uECC_BATCH_SIZE keys, and the public
+   keys are hashed side by side with keccak256_batch(); uncompressed and raw keys are hashed in
+   place. Invalid keys get a zero address. valid, if not NULL, receives 1 for every valid key and
+   0 for every invalid one. Returns 1 if every key was valid, 0 otherwise. */
+int ethereum_addresses(
+	uint8_t *addresses, const uint8_t *keys, unsigned count, ethereum_key_format format, uint8_t *valid
+);
+
+/* Writes the EIP-55 mixed-case checksummed form of count addresses, each
+   ETHEREUM_ADDRESS_HEX_SIZE + 1 bytes long including its NUL, back to back into hex. */
+void ethereum_addresses_to_hex(char *hex, const uint8_t *addresses, unsigned count);
+
+#endif /* address_h */
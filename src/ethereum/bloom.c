@@ -0,0 +1,129 @@
+//
+//  bloom.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#include "bloom.h"
+#include "../keccak256/keccak256.h"
+
+#include <string.h>
+
+/* Items hashed per keccak256_batch() call. */
+#define BLOOM_BATCH 64
+
+static void bloom_set_bits(uint8_t *bloom, const uint8_t *hash) {
+	unsigned i, bit;
+	for (i = 0; i < 6; i += 2) {
+		bit = ((unsigned)hash[i] << 8 | hash[i + 1]) & 2047;
+		bloom[BLOOM_SIZE - 1 - bit / 8] |= (uint8_t)(1 << (bit % 8));
+	}
+}
+
+void bloom_add(uint8_t *bloom, const uint8_t *const *items, const size_t *sizes, size_t count) {
+	uint8_t hashes[BLOOM_BATCH][32];
+	size_t done, i;
+
+	for (done = 0; done < count; done += BLOOM_BATCH) {
+		size_t chunk = count - done < BLOOM_BATCH ? count - done : BLOOM_BATCH;
+		keccak256_batch(hashes[0], items + done, sizes + done, chunk);
+		for (i = 0; i < chunk; ++i) {
+			bloom_set_bits(bloom, hashes[i]);
+		}
+	}
+}
+
+void bloom_add_logs(
+	uint8_t *bloom, const uint8_t *addresses, size_t address_count, const uint8_t *topics, size_t topic_count
+) {
+	const uint8_t *items[BLOOM_BATCH];
+	size_t sizes[BLOOM_BATCH];
+	size_t done, chunk = 0;
+
+	for (done = 0; done < address_count + topic_count; ++done) {
+		if (done < address_count) {
+			items[chunk] = addresses + 20 * done;
+			sizes[chunk] = 20;
+		} else {
+			items[chunk] = topics + 32 * (done - address_count);
+			sizes[chunk] = 32;
+		}
+		if (++chunk == BLOOM_BATCH) {
+			bloom_add(bloom, items, sizes, chunk);
+			chunk = 0;
+		}
+	}
+	bloom_add(bloom, items, sizes, chunk);
+}
+
+void bloom_merge(uint8_t *bloom, const uint8_t *other) {
+	unsigned i;
+	for (i = 0; i < BLOOM_SIZE; ++i) {
+		bloom[i] |= other[i];
+	}
+}
+
+int bloom_contains(const uint8_t *bloom, const uint8_t *query) {
+	uint8_t missing = 0;
+	unsigned i;
+	for (i = 0; i < BLOOM_SIZE; ++i) {
+		missing |= (uint8_t)(query[i] & ~bloom[i]);
+	}
+	return missing == 0;
+}
+
+/* Every bloom is tested in full, without branches, and its index is always written; it only
+   counts when a query bit is missing from none of its words. */
+#define BLOOM_FILTER(word)                                                                         \
+	word q[BLOOM_SIZE / sizeof(word)], b, missing;                                                 \
+	size_t found = 0, i;                                                                           \
+	unsigned w;                                                                                    \
+	memcpy(q, query, BLOOM_SIZE);                                                                  \
+	for (i = 0; i < count; ++i) {                                                                  \
+		const uint8_t *bloom = blooms + i * BLOOM_SIZE;                                            \
+		memset(&missing, 0, sizeof(word));                                                         \
+		for (w = 0; w < BLOOM_SIZE / sizeof(word); ++w) {                                          \
+			memcpy(&b, bloom + w * sizeof(word), sizeof(word));                                    \
+			missing |= q[w] & ~b;                                                                  \
+		}                                                                                          \
+		matches[found] = i;                                                                        \
+		found += BLOOM_NONE_MISSING(missing);                                                      \
+	}                                                                                              \
+	return found;
+
+#define BLOOM_NONE_MISSING(missing) ((missing) == 0)
+
+static size_t bloom_filter_scalar(size_t *matches, const uint8_t *blooms, size_t count, const uint8_t *query) {
+	BLOOM_FILTER(uint64_t)
+}
+
+#undef BLOOM_NONE_MISSING
+
+/* 256-bit words when the compiler can target AVX2, which bloom_filter() checks for at run time. */
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define BLOOM_SIMD 1
+
+typedef uint64_t bloom_x4 __attribute__((vector_size(32)));
+
+#define BLOOM_NONE_MISSING(missing) (((missing)[0] | (missing)[1] | (missing)[2] | (missing)[3]) == 0)
+
+__attribute__((target("avx2"))) static size_t bloom_filter_x4(
+	size_t *matches, const uint8_t *blooms, size_t count, const uint8_t *query
+) {
+	BLOOM_FILTER(bloom_x4)
+}
+
+#undef BLOOM_NONE_MISSING
+#else
+#define BLOOM_SIMD 0
+#endif
+
+size_t bloom_filter(size_t *matches, const uint8_t *blooms, size_t count, const uint8_t *query) {
+#if BLOOM_SIMD
+	if (__builtin_cpu_supports("avx2")) {
+		return bloom_filter_x4(matches, blooms, count, query);
+	}
+#endif
+	return bloom_filter_scalar(matches, blooms, count, query);
+}
@@ -0,0 +1,42 @@
+//
+//  bloom.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#ifndef bloom_h
+#define bloom_h
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Size of a log bloom in bytes: 2048 bits. */
+#define BLOOM_SIZE 256
+
+/* Sets the 3 bits of each of count items in bloom, as the logs bloom of a receipt or block does
+   for the address and topics of every log: bits h[0..1], h[2..3] and h[4..5] modulo 2048 of
+   h = keccak256(item), numbered from the last byte of the big-endian bloom. The items are hashed
+   side by side with keccak256_batch(). */
+void bloom_add(uint8_t *bloom, const uint8_t *const *items, const size_t *sizes, size_t count);
+
+/* Adds address_count 20-byte addresses and topic_count 32-byte topics, each stored back to back,
+   such as those of every log of a receipt, hashing them all together. */
+void bloom_add_logs(
+	uint8_t *bloom, const uint8_t *addresses, size_t address_count, const uint8_t *topics, size_t topic_count
+);
+
+/* ORs other into bloom. */
+void bloom_merge(uint8_t *bloom, const uint8_t *other);
+
+/* Returns 1 if every bit of query is set in bloom, 0 otherwise. A query is built with
+   bloom_add() from the items a log must have; 0 is a certain miss, 1 a possible hit. */
+int bloom_contains(const uint8_t *bloom, const uint8_t *query);
+
+/* Tests count blooms stored back to back against query, 256 bits at a time where the CPU has
+   AVX2, and writes the indexes of those that contain it, in order, to matches. The loop stores
+   an index for every bloom and only counts the matching ones, so matches must hold count entries
+   however few match. Returns the number of matches. */
+size_t bloom_filter(size_t *matches, const uint8_t *blooms, size_t count, const uint8_t *query);
+
+#endif /* bloom_h */
@@ -0,0 +1,187 @@
+//
+//  create2.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#include "create2.h"
+#include "../keccak256/keccak256.h"
+#include "workers.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+/* 0xff || deployer || salt || init_code_hash */
+#define CREATE2_INPUT_SIZE 85
+
+/* The Keccak state word holding the counter: input bytes 40..47. */
+#define CREATE2_COUNTER_WORD ((1 + 20 + CREATE2_COUNTER_OFFSET) / 8)
+
+/* Attempts a thread claims at a time. */
+#define CREATE2_CHUNK 256
+
+/* State shared by the threads of one search. */
+typedef struct {
+	uint8_t input[CREATE2_INPUT_SIZE];
+	uint64_t counter;
+	uint64_t max_attempts;
+	create2_predicate predicate;
+	void *user;
+	pthread_mutex_t lock;
+	uint64_t next;	   /* first attempt not handed out yet */
+	uint64_t best;	   /* lowest matching attempt so far, UINT64_MAX if none */
+	uint64_t attempts; /* attempts hashed */
+	uint8_t address[20];
+} create2_shared;
+
+static void create2_input(uint8_t *input, const uint8_t *deployer, const uint8_t *salt, const uint8_t *init_code_hash) {
+	input[0] = 0xff;
+	memcpy(input + 1, deployer, 20);
+	memcpy(input + 21, salt, 32);
+	memcpy(input + 53, init_code_hash, 32);
+}
+
+void create2_address(uint8_t *address, const uint8_t *deployer, const uint8_t *salt, const uint8_t *init_code_hash) {
+	uint8_t input[CREATE2_INPUT_SIZE], hash[32];
+	create2_input(input, deployer, salt, init_code_hash);
+	keccak256_raw(hash, 32, input, sizeof(input), 1, 256);
+	memcpy(address, hash + 12, 20);
+}
+
+int create2_pattern_prefix(create2_pattern *pattern, const char *prefix) {
+	size_t i;
+	memset(pattern, 0, sizeof(*pattern));
+	if (prefix[0] == '0' && (prefix[1] == 'x' || prefix[1] == 'X')) {
+		prefix += 2;
+	}
+	for (i = 0; prefix[i]; ++i) {
+		char c = prefix[i];
+		unsigned digit, shift = i % 2 == 0 ? 4 : 0;
+		if (i == 40) {
+			return 0;
+		}
+		if (c >= '0' && c <= '9') {
+			digit = (unsigned)(c - '0');
+		} else if (c >= 'a' && c <= 'f') {
+			digit = (unsigned)(c - 'a' + 10);
+		} else if (c >= 'A' && c <= 'F') {
+			digit = (unsigned)(c - 'A' + 10);
+		} else {
+			return 0;
+		}
+		pattern->mask[i / 2] |= (uint8_t)(0x0f << shift);
+		pattern->value[i / 2] |= (uint8_t)(digit << shift);
+	}
+	return 1;
+}
+
+int create2_pattern_match(void *pattern, const uint8_t *address) {
+	const create2_pattern *p = (const create2_pattern *)pattern;
+	uint8_t diff			 = 0;
+	unsigned i;
+	for (i = 0; i < 20; ++i) {
+		diff |= (uint8_t)((address[i] ^ p->value[i]) & p->mask[i]);
+	}
+	return diff == 0;
+}
+
+/* Claims chunks of attempts until they run out or start past the best match, which is then the
+   lowest match of all. */
+static void *create2_worker(void *arg) {
+	create2_shared *shared = (create2_shared *)arg;
+	uint64_t values[CREATE2_CHUNK];
+	uint8_t hashes[CREATE2_CHUNK][32];
+	uint64_t first;
+	unsigned count, i;
+
+	for (;;) {
+		pthread_mutex_lock(&shared->lock);
+		first = shared->next;
+		if (first >= shared->max_attempts || first >= shared->best) {
+			pthread_mutex_unlock(&shared->lock);
+			return NULL;
+		}
+		count = shared->max_attempts - first < CREATE2_CHUNK ? (unsigned)(shared->max_attempts - first) : CREATE2_CHUNK;
+		shared->next += count;
+		pthread_mutex_unlock(&shared->lock);
+
+		for (i = 0; i < count; ++i) {
+			values[i] = shared->counter + first + i;
+		}
+		keccak256_batch_variants(hashes[0], shared->input, CREATE2_INPUT_SIZE, CREATE2_COUNTER_WORD, values, count);
+		for (i = 0; i < count && !shared->predicate(shared->user, hashes[i] + 12); ++i) {
+		}
+
+		pthread_mutex_lock(&shared->lock);
+		shared->attempts += count;
+		if (i < count && first + i < shared->best) {
+			shared->best = first + i;
+			memcpy(shared->address, hashes[i] + 12, 20);
+		}
+		pthread_mutex_unlock(&shared->lock);
+	}
+}
+
+static uint64_t create2_load64(const uint8_t *in) {
+	uint64_t value = 0;
+	unsigned i;
+	for (i = 0; i < 8; ++i) {
+		value |= (uint64_t)in[i] << (8 * i);
+	}
+	return value;
+}
+
+static void create2_store64(uint8_t *out, uint64_t value) {
+	unsigned i;
+	for (i = 0; i < 8; ++i) {
+		out[i] = (uint8_t)(value >> (8 * i));
+	}
+}
+
+int create2_search(
+	uint8_t *salt,
+	uint8_t *address,
+	const uint8_t *deployer,
+	const uint8_t *init_code_hash,
+	uint64_t max_attempts,
+	unsigned threads,
+	create2_predicate predicate,
+	void *user,
+	create2_stats *stats
+) {
+	create2_shared shared;
+	struct timespec start, end;
+
+	create2_input(shared.input, deployer, salt, init_code_hash);
+	shared.counter		= create2_load64(salt + CREATE2_COUNTER_OFFSET);
+	shared.max_attempts = max_attempts;
+	shared.predicate	= predicate;
+	shared.user			= user;
+	shared.next			= 0;
+	shared.best			= UINT64_MAX;
+	shared.attempts		= 0;
+	if (pthread_mutex_init(&shared.lock, NULL) != 0) {
+		return 0;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	run_workers(create2_worker, &shared, threads, CREATE2_MAX_THREADS);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	pthread_mutex_destroy(&shared.lock);
+
+	if (stats) {
+		double seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+		stats->attempts			   = shared.attempts;
+		stats->seconds			   = seconds;
+		stats->attempts_per_second = seconds > 0 ? (double)shared.attempts / seconds : 0;
+	}
+	if (shared.best == UINT64_MAX) {
+		return 0;
+	}
+	create2_store64(salt + CREATE2_COUNTER_OFFSET, shared.counter + shared.best);
+	memcpy(address, shared.address, 20);
+	return 1;
+}
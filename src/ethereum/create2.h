@@ -0,0 +1,68 @@
+//
+//  create2.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#ifndef create2_h
+#define create2_h
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Most threads create2_search() starts. */
+#define CREATE2_MAX_THREADS 64
+
+/* Bytes of the salt create2_search() varies: a little-endian counter in salt[19..26], which is
+   one whole word of the Keccak state. */
+#define CREATE2_COUNTER_OFFSET 19
+
+/* Decides whether a 20-byte address is wanted. Called from several threads at once. */
+typedef int (*create2_predicate)(void *user, const uint8_t *address);
+
+/* Addresses whose bits under mask equal value. */
+typedef struct {
+	uint8_t mask[20];
+	uint8_t value[20];
+} create2_pattern;
+
+/* Throughput of a search. */
+typedef struct {
+	uint64_t attempts;
+	double seconds;
+	double attempts_per_second;
+} create2_stats;
+
+/* Computes the CREATE2 address keccak256(0xff || deployer || salt || init_code_hash)[12..32] of
+   a 20-byte deployer, a 32-byte salt and the 32-byte Keccak-256 of the init code. */
+void create2_address(uint8_t *address, const uint8_t *deployer, const uint8_t *salt, const uint8_t *init_code_hash);
+
+/* Sets pattern to match the addresses starting with the hex digits of prefix, with or without
+   "0x", of either case. Returns 1 on success, 0 if prefix is not at most 40 hex digits. */
+int create2_pattern_prefix(create2_pattern *pattern, const char *prefix);
+
+/* A create2_predicate for a create2_pattern. */
+int create2_pattern_match(void *pattern, const uint8_t *address);
+
+/* Searches up to max_attempts salts for one whose address satisfies predicate. Attempt i uses
+   salt with its counter bytes (see CREATE2_COUNTER_OFFSET) advanced by i, wrapping around. The
+   fixed part of the input is padded into a Keccak block once; every attempt only changes the
+   counter word and costs one permutation, on as many SIMD lanes as keccak256_batch() uses and on
+   threads threads, the calling thread being one of them.
+
+   Returns 1 and writes the salt and address of the lowest matching attempt, which does not depend
+   on threads, or 0 if none matched. stats, if not NULL, receives the attempts made and the rate. */
+int create2_search(
+	uint8_t *salt,
+	uint8_t *address,
+	const uint8_t *deployer,
+	const uint8_t *init_code_hash,
+	uint64_t max_attempts,
+	unsigned threads,
+	create2_predicate predicate,
+	void *user,
+	create2_stats *stats
+);
+
+#endif /* create2_h */
@@ -0,0 +1,322 @@
+//
+//  eip712.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#include "eip712.h"
+
+#include <string.h>
+
+/* Parses the decimal number in text[0, length), which must not be empty or start with 0. */
+static int eip712_parse_number(const char *text, size_t length, uint32_t *value) {
+	uint64_t v = 0;
+	size_t i;
+	if (length == 0 || length > 9 || text[0] == '0') {
+		return 0;
+	}
+	for (i = 0; i < length; ++i) {
+		if (text[i] < '0' || text[i] > '9') {
+			return 0;
+		}
+		v = v * 10 + (uint64_t)(text[i] - '0');
+	}
+	*value = (uint32_t)v;
+	return 1;
+}
+
+static int eip712_find_type_n(const eip712_type *types, size_t type_count, const char *name, size_t length) {
+	size_t i;
+	for (i = 0; i < type_count; ++i) {
+		if (strncmp(types[i].name, name, length) == 0 && types[i].name[length] == '\0') {
+			return (int)i;
+		}
+	}
+	return -1;
+}
+
+/* Resolves a member type such as "uint256", "Person" or "bytes32[2][]". */
+static int eip712_parse_field(eip712_field *field, const char *type, const eip712_type *types, size_t type_count) {
+	const char *suffix = strchr(type, '[');
+	size_t base		   = suffix ? (size_t)(suffix - type) : strlen(type);
+	uint32_t n		   = 0;
+	int index;
+
+	memset(field, 0, sizeof(*field));
+	if (base == 7 && strncmp(type, "address", 7) == 0) {
+		field->kind = EIP712_ADDRESS;
+	} else if (base == 4 && strncmp(type, "bool", 4) == 0) {
+		field->kind = EIP712_BOOL;
+	} else if (base == 6 && strncmp(type, "string", 6) == 0) {
+		field->kind = EIP712_STRING;
+	} else if (base == 5 && strncmp(type, "bytes", 5) == 0) {
+		field->kind = EIP712_BYTES;
+	} else if (base > 5 && strncmp(type, "bytes", 5) == 0 && eip712_parse_number(type + 5, base - 5, &n)) {
+		if (n > 32) {
+			return 0;
+		}
+		field->kind = EIP712_FIXED_BYTES;
+		field->size = (uint16_t)n;
+	} else if (base > 4 && strncmp(type, "uint", 4) == 0 && eip712_parse_number(type + 4, base - 4, &n)) {
+		if (n > 256 || n % 8 != 0) {
+			return 0;
+		}
+		field->kind = EIP712_UINT;
+		field->size = (uint16_t)n;
+	} else if (base > 3 && strncmp(type, "int", 3) == 0 && eip712_parse_number(type + 3, base - 3, &n)) {
+		if (n > 256 || n % 8 != 0) {
+			return 0;
+		}
+		field->kind = EIP712_INT;
+		field->size = (uint16_t)n;
+	} else if ((index = eip712_find_type_n(types, type_count, type, base)) >= 0) {
+		field->kind			= EIP712_STRUCT;
+		field->struct_index = (uint8_t)index;
+	} else {
+		return 0;
+	}
+
+	while (suffix && *suffix) {
+		const char *close = strchr(suffix, ']');
+		if (*suffix != '[' || !close || field->dimensions == EIP712_MAX_DIMENSIONS) {
+			return 0;
+		}
+		n = 0;
+		if (close > suffix + 1 && !eip712_parse_number(suffix + 1, (size_t)(close - suffix - 1), &n)) {
+			return 0;
+		}
+		field->lengths[field->dimensions++] = n;
+		suffix								= close + 1;
+	}
+	return 1;
+}
+
+/* Absorbs "Name(type1 name1,type2 name2)". */
+static void eip712_absorb_type(keccak256_ctx *ctx, const eip712_type *type) {
+	size_t i;
+	keccak256_update(ctx, (const uint8_t *)type->name, strlen(type->name));
+	keccak256_update(ctx, (const uint8_t *)"(", 1);
+	for (i = 0; i < type->member_count; ++i) {
+		const eip712_member *member = &type->members[i];
+		if (i > 0) {
+			keccak256_update(ctx, (const uint8_t *)",", 1);
+		}
+		keccak256_update(ctx, (const uint8_t *)member->type, strlen(member->type));
+		keccak256_update(ctx, (const uint8_t *)" ", 1);
+		keccak256_update(ctx, (const uint8_t *)member->name, strlen(member->name));
+	}
+	keccak256_update(ctx, (const uint8_t *)")", 1);
+}
+
+/* typeHash = keccak256(encodeType), where encodeType is the type followed by every struct type it
+   references, directly or not, sorted by name. */
+static void eip712_type_hash(eip712_schema *schema, size_t type) {
+	keccak256_ctx ctx;
+	uint32_t referenced = 0, grown;
+	size_t i, j;
+
+	/* Closes the references of type over the member types until nothing new is reached. */
+	do {
+		grown = referenced;
+		for (i = 0; i < schema->type_count; ++i) {
+			if (i != type && !(referenced >> i & 1)) {
+				continue;
+			}
+			for (j = 0; j < schema->types[i].member_count; ++j) {
+				const eip712_field *field = &schema->fields[i][j];
+				if (field->kind == EIP712_STRUCT) {
+					grown |= (uint32_t)1 << field->struct_index;
+				}
+			}
+		}
+		grown &= ~((uint32_t)1 << type);
+		if (grown == referenced) {
+			break;
+		}
+		referenced = grown;
+	} while (1);
+
+	keccak256_init(&ctx);
+	eip712_absorb_type(&ctx, &schema->types[type]);
+	while (referenced) {
+		size_t first = schema->type_count;
+		for (i = 0; i < schema->type_count; ++i) {
+			if ((referenced >> i & 1) &&
+				(first == schema->type_count || strcmp(schema->types[i].name, schema->types[first].name) < 0)) {
+				first = i;
+			}
+		}
+		eip712_absorb_type(&ctx, &schema->types[first]);
+		referenced &= ~((uint32_t)1 << first);
+	}
+	keccak256_final(&ctx, schema->type_hashes[type]);
+}
+
+int eip712_compile(eip712_schema *schema, const eip712_type *types, size_t type_count) {
+	size_t i, j;
+
+	if (type_count > EIP712_MAX_TYPES) {
+		return 0;
+	}
+	schema->types	   = types;
+	schema->type_count = type_count;
+	for (i = 0; i < type_count; ++i) {
+		if (types[i].member_count > EIP712_MAX_MEMBERS ||
+			eip712_find_type_n(types, type_count, types[i].name, strlen(types[i].name)) != (int)i) {
+			return 0;
+		}
+		for (j = 0; j < types[i].member_count; ++j) {
+			if (!eip712_parse_field(&schema->fields[i][j], types[i].members[j].type, types, type_count)) {
+				return 0;
+			}
+		}
+	}
+	for (i = 0; i < type_count; ++i) {
+		eip712_type_hash(schema, i);
+	}
+	return 1;
+}
+
+int eip712_find_type(const eip712_schema *schema, const char *name) {
+	return eip712_find_type_n(schema->types, schema->type_count, name, strlen(name));
+}
+
+/* Encodes an atomic value as its 32-byte word. */
+static int eip712_encode_word(uint8_t *word, const eip712_field *field, const eip712_value *value) {
+	size_t size = value->size;
+	size_t i, pad;
+	uint8_t fill;
+
+	memset(word, 0, 32);
+	switch (field->kind) {
+	case EIP712_ADDRESS:
+		if (size != 20) {
+			return 0;
+		}
+		memcpy(word + 12, value->data, 20);
+		return 1;
+	case EIP712_BOOL:
+		if (size != 1 || value->data[0] > 1) {
+			return 0;
+		}
+		word[31] = value->data[0];
+		return 1;
+	case EIP712_FIXED_BYTES:
+		if (size != field->size) {
+			return 0;
+		}
+		memcpy(word, value->data, size);
+		return 1;
+	case EIP712_UINT:
+	case EIP712_INT:
+		if (size == 0 || size > 32) {
+			return 0;
+		}
+		fill = (field->kind == EIP712_INT && (value->data[0] & 0x80)) ? 0xff : 0x00;
+		memset(word, fill, 32 - size);
+		memcpy(word + 32 - size, value->data, size);
+
+		/* The value must fit in the type's bits: the bytes above them repeat the sign (or zero). */
+		pad = 32 - field->size / 8;
+		for (i = 0; i < pad; ++i) {
+			if (word[i] != fill) {
+				return 0;
+			}
+		}
+		return pad == 0 || field->kind == EIP712_UINT || (word[pad] & 0x80) == (fill & 0x80);
+	default:
+		return 0;
+	}
+}
+
+static int eip712_hash_struct_at(uint8_t *out, const eip712_schema *schema, size_t type, const eip712_value *value);
+
+/* Absorbs encodeData of value, a member of type field with dimension array suffixes left. */
+static int eip712_absorb_field(
+	keccak256_ctx *ctx, const eip712_schema *schema, const eip712_field *field, int dimension, const eip712_value *value
+) {
+	uint8_t word[32];
+	keccak256_ctx array;
+	size_t i;
+
+	if (dimension > 0) {
+		/* An array is the hash of its elements' encodings, back to back. */
+		uint32_t length = field->lengths[dimension - 1];
+		if ((length != 0 && value->count != length) || (value->count > 0 && value->items == NULL)) {
+			return 0;
+		}
+		keccak256_init(&array);
+		for (i = 0; i < value->count; ++i) {
+			if (!eip712_absorb_field(&array, schema, field, dimension - 1, &value->items[i])) {
+				return 0;
+			}
+		}
+		keccak256_final(&array, word);
+	} else if (field->kind == EIP712_STRUCT) {
+		if (!eip712_hash_struct_at(word, schema, field->struct_index, value)) {
+			return 0;
+		}
+	} else if (field->kind == EIP712_BYTES || field->kind == EIP712_STRING) {
+		if (value->data == NULL && value->size > 0) {
+			return 0;
+		}
+		keccak256_raw(word, 32, value->data, value->size, 1, 256);
+	} else if (value->data == NULL || !eip712_encode_word(word, field, value)) {
+		return 0;
+	}
+	keccak256_update(ctx, word, 32);
+	return 1;
+}
+
+static int eip712_hash_struct_at(uint8_t *out, const eip712_schema *schema, size_t type, const eip712_value *value) {
+	const eip712_type *definition = &schema->types[type];
+	keccak256_ctx ctx;
+	size_t i;
+
+	if (value->count != definition->member_count || (value->count > 0 && value->items == NULL)) {
+		return 0;
+	}
+	keccak256_init(&ctx);
+	keccak256_update(&ctx, schema->type_hashes[type], 32);
+	for (i = 0; i < definition->member_count; ++i) {
+		const eip712_field *field = &schema->fields[type][i];
+		if (!eip712_absorb_field(&ctx, schema, field, field->dimensions, &value->items[i])) {
+			return 0;
+		}
+	}
+	keccak256_final(&ctx, out);
+	return 1;
+}
+
+int eip712_hash_struct(uint8_t *out, const eip712_schema *schema, int type, const eip712_value *value) {
+	if (type < 0 || (size_t)type >= schema->type_count) {
+		return 0;
+	}
+	return eip712_hash_struct_at(out, schema, (size_t)type, value);
+}
+
+int eip712_domain_init(eip712_domain *domain, const eip712_schema *schema, const eip712_value *value) {
+	if (!eip712_hash_struct(domain->separator, schema, eip712_find_type(schema, "EIP712Domain"), value)) {
+		return 0;
+	}
+	keccak256_init(&domain->prefix);
+	keccak256_update(&domain->prefix, (const uint8_t *)"\x19\x01", 2);
+	keccak256_update(&domain->prefix, domain->separator, 32);
+	return 1;
+}
+
+int eip712_digest(
+	uint8_t *out, const eip712_domain *domain, const eip712_schema *schema, int type, const eip712_value *message
+) {
+	keccak256_ctx ctx;
+	uint8_t message_hash[32];
+
+	if (!eip712_hash_struct(message_hash, schema, type, message)) {
+		return 0;
+	}
+	keccak256_clone(&ctx, &domain->prefix);
+	keccak256_update(&ctx, message_hash, 32);
+	keccak256_final(&ctx, out);
+	return 1;
+}
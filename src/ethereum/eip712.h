@@ -0,0 +1,107 @@
+//
+//  eip712.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#ifndef eip712_h
+#define eip712_h
+
+#include "../keccak256/keccak256.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Limits of a compiled schema. */
+#define EIP712_MAX_TYPES	  32
+#define EIP712_MAX_MEMBERS	  24
+#define EIP712_MAX_DIMENSIONS 4
+
+typedef enum {
+	EIP712_UINT,
+	EIP712_INT,
+	EIP712_ADDRESS,
+	EIP712_BOOL,
+	EIP712_FIXED_BYTES,
+	EIP712_BYTES,
+	EIP712_STRING,
+	EIP712_STRUCT
+} eip712_kind;
+
+/* A member as written in a type definition, such as {"wallets", "address[]"}. */
+typedef struct {
+	const char *name;
+	const char *type;
+} eip712_member;
+
+/* A struct type, such as the EIP712Domain or Mail of the EIP-712 example. */
+typedef struct {
+	const char *name;
+	const eip712_member *members;
+	size_t member_count;
+} eip712_type;
+
+/* A member type as resolved by eip712_compile(). */
+typedef struct {
+	uint8_t kind;		  /* eip712_kind */
+	uint16_t size;		  /* bits of an intN or uintN, bytes of a bytesN */
+	uint8_t struct_index; /* type of an EIP712_STRUCT member */
+	uint8_t dimensions;	  /* array suffixes, 0 for a plain value */
+	uint32_t lengths[EIP712_MAX_DIMENSIONS]; /* per suffix in written order, 0 if dynamic */
+} eip712_field;
+
+/* Types compiled once and then shared, read-only, by any number of threads. The type definitions
+   must outlive the schema. */
+typedef struct {
+	const eip712_type *types;
+	size_t type_count;
+	eip712_field fields[EIP712_MAX_TYPES][EIP712_MAX_MEMBERS];
+	uint8_t type_hashes[EIP712_MAX_TYPES][32];
+} eip712_schema;
+
+/* A value to encode, as a tree mirroring its type.
+
+   Structs list their members in declaration order in items, and arrays list their elements.
+   Atomic values are given in data: uintN and intN as big-endian numbers of at most 32 bytes, intN
+   sign-extended from its first byte; an address as 20 bytes; a bool as one byte, 0 or 1; a bytesN
+   as exactly N bytes. bytes and string values are the raw bytes, which are hashed. */
+typedef struct eip712_value {
+	const uint8_t *data;
+	size_t size;
+	const struct eip712_value *items;
+	size_t count;
+} eip712_value;
+
+#define EIP712_DATA(data, size)	  {(const uint8_t *)(data), (size), NULL, 0}
+#define EIP712_TEXT(text)		  {(const uint8_t *)(text), sizeof(text) - 1, NULL, 0}
+#define EIP712_ITEMS(items, count) {NULL, 0, (items), (count)}
+
+/* A domain separator, with the Keccak state after "\x19\x01" || separator kept as a midstate. */
+typedef struct {
+	uint8_t separator[32];
+	keccak256_ctx prefix;
+} eip712_domain;
+
+/* Resolves the member types of types, which may refer to each other in any order, and computes
+   every typeHash. Returns 1 on success, 0 if a type is unknown, malformed or a limit is exceeded. */
+int eip712_compile(eip712_schema *schema, const eip712_type *types, size_t type_count);
+
+/* Returns the index of the type called name, or -1. */
+int eip712_find_type(const eip712_schema *schema, const char *name);
+
+/* Computes hashStruct(value) of the type at index type. Returns 1 on success, 0 if value does
+   not match the type. */
+int eip712_hash_struct(uint8_t *out, const eip712_schema *schema, int type, const eip712_value *value);
+
+/* Computes the separator of the domain value, which must be of the schema's EIP712Domain type.
+   Returns 1 on success, 0 otherwise. */
+int eip712_domain_init(eip712_domain *domain, const eip712_schema *schema, const eip712_value *value);
+
+/* Computes keccak256("\x19\x01" || domainSeparator || hashStruct(message)), the digest to sign,
+   for a message of the type at index type. Returns 1 on success, 0 if message does not match. */
+int eip712_digest(
+	uint8_t *out, const eip712_domain *domain, const eip712_schema *schema, int type, const eip712_value *message
+);
+
+#endif /* eip712_h */
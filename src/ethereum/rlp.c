@@ -0,0 +1,118 @@
+//
+//  rlp.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#include "rlp.h"
+
+#include <string.h>
+
+/* Number of bytes in the big-endian form of value without leading zeros. */
+static unsigned rlp_length_bytes(uint64_t value) {
+	unsigned n = 0;
+	while (value) {
+		++n;
+		value >>= 8;
+	}
+	return n;
+}
+
+size_t rlp_header_size(size_t size) { return size < 56 ? 1 : 1 + rlp_length_bytes(size); }
+
+size_t rlp_put_header(uint8_t *out, size_t size, uint8_t offset) {
+	unsigned n, i;
+	if (size < 56) {
+		out[0] = (uint8_t)(offset + size);
+		return 1;
+	}
+	n	   = rlp_length_bytes(size);
+	out[0] = (uint8_t)(offset + 55 + n);
+	for (i = 0; i < n; ++i) {
+		out[1 + i] = (uint8_t)((uint64_t)size >> (8 * (n - 1 - i)));
+	}
+	return 1 + n;
+}
+
+size_t rlp_string_size(const uint8_t *data, size_t size) {
+	if (size == 1 && data[0] < 0x80) {
+		return 1;
+	}
+	return rlp_header_size(size) + size;
+}
+
+size_t rlp_put_string(uint8_t *out, const uint8_t *data, size_t size) {
+	size_t header;
+	if (size == 1 && data[0] < 0x80) {
+		out[0] = data[0];
+		return 1;
+	}
+	header = rlp_put_header(out, size, RLP_STRING);
+	if (size > 0) {
+		memcpy(out + header, data, size);
+	}
+	return header + size;
+}
+
+size_t rlp_put_uint(uint8_t *out, uint64_t value) {
+	uint8_t bytes[8];
+	unsigned n = rlp_length_bytes(value), i;
+	for (i = 0; i < n; ++i) {
+		bytes[i] = (uint8_t)(value >> (8 * (n - 1 - i)));
+	}
+	return rlp_put_string(out, bytes, n);
+}
+
+int rlp_read_header(const uint8_t *in, size_t size, size_t *offset, size_t *length) {
+	uint8_t first;
+	int kind;
+	size_t n, i, payload = 0;
+
+	if (size == 0) {
+		return 0;
+	}
+	first = in[0];
+	if (first < RLP_STRING) {
+		*offset = 0;
+		*length = 1;
+		return RLP_STRING;
+	}
+	kind  = first < RLP_LIST ? RLP_STRING : RLP_LIST;
+	first = (uint8_t)(first - kind);
+	if (first < 56) {
+		/* A single byte below 0x80 must be encoded as itself. */
+		if (kind == RLP_STRING && first == 1 && (size < 2 || in[1] < RLP_STRING)) {
+			return 0;
+		}
+		*offset = 1;
+		*length = first;
+	} else {
+		/* The length takes n bytes, without leading zeros, and is at least 56. */
+		n = first - 55u;
+		if (n > sizeof(size_t) || size < 1 + n || in[1] == 0) {
+			return 0;
+		}
+		for (i = 0; i < n; ++i) {
+			payload = payload << 8 | in[1 + i];
+		}
+		if (payload < 56) {
+			return 0;
+		}
+		*offset = 1 + n;
+		*length = payload;
+	}
+	return *length <= size - *offset ? kind : 0;
+}
+
+int rlp_read_uint(uint64_t *value, const uint8_t *data, size_t size) {
+	size_t i;
+	if (size > 8 || (size > 0 && data[0] == 0)) {
+		return 0;
+	}
+	*value = 0;
+	for (i = 0; i < size; ++i) {
+		*value = *value << 8 | data[i];
+	}
+	return 1;
+}
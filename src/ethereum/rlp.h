@@ -0,0 +1,49 @@
+//
+//  rlp.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#ifndef rlp_h
+#define rlp_h
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* First byte offsets of RLP string and list headers. */
+#define RLP_STRING 0x80
+#define RLP_LIST   0xc0
+
+/* Longest RLP header: the offset byte and an 8-byte length. */
+#define RLP_MAX_HEADER 9
+
+/* Returns the size of the header of a string or list with a payload of size bytes. */
+size_t rlp_header_size(size_t size);
+
+/* Writes the header of a payload of size bytes, offset being RLP_STRING or RLP_LIST. Returns the
+   number of bytes written. */
+size_t rlp_put_header(uint8_t *out, size_t size, uint8_t offset);
+
+/* Returns the encoded size of the byte string data. */
+size_t rlp_string_size(const uint8_t *data, size_t size);
+
+/* Encodes the byte string data: a single byte below 0x80 as itself, anything else behind a
+   string header. out may not overlap data. Returns the number of bytes written. */
+size_t rlp_put_string(uint8_t *out, const uint8_t *data, size_t size);
+
+/* Encodes value as the big-endian string without leading zeros that RLP uses for integers, zero
+   being the empty string. Returns the number of bytes written, at most 9. */
+size_t rlp_put_uint(uint8_t *out, uint64_t value);
+
+/* Reads the header of the item at the start of the size bytes of in. On success, sets *offset
+   and *length to the position and size of its payload, which lies within in, and returns
+   RLP_STRING or RLP_LIST; a single byte below 0x80 is a string of length 1 at offset 0. Returns 0
+   if the item is truncated or not in canonical form. */
+int rlp_read_header(const uint8_t *in, size_t size, size_t *offset, size_t *length);
+
+/* Decodes the canonical integer string payload data of size bytes, which must fit in 64 bits.
+   Returns 1 on success, 0 otherwise. */
+int rlp_read_uint(uint64_t *value, const uint8_t *data, size_t size);
+
+#endif /* rlp_h */
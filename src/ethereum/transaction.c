@@ -0,0 +1,429 @@
+//
+//  transaction.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#include "transaction.h"
+#include "../ecc/core.h"
+#include "../keccak256/keccak256.h"
+#include "../rfc6979/der.h"
+#include "../rfc6979/sign.h"
+#include "../rfc6979/verify.h"
+#include "rlp.h"
+#include "workers.h"
+
+#include <pthread.h>
+#include <string.h>
+
+/* Newest transaction type transaction_senders() reads: 3 is an EIP-4844 blob transaction and 4 an
+   EIP-7702 set-code one, both signed over type || rlp(fields) like the others. */
+#define TRANSACTION_SENDERS_MAX_TYPE 4
+
+/* State shared by the threads of one transaction_senders() call. */
+typedef struct {
+	const uint8_t *list; /* payload of the list of transactions */
+	size_t size;
+	uint8_t *senders;
+	uint8_t *valid;
+	size_t max_count;
+	pthread_mutex_t lock;
+	size_t cursor;	   /* offset of the first transaction not handed out yet */
+	size_t next_index; /* its index */
+	int malformed;
+	int ok;
+} transaction_senders_shared;
+
+/* Where an encoding goes: absorbed into a Keccak state, copied to a buffer, or only measured. */
+typedef struct {
+	keccak256_ctx *ctx;
+	uint8_t *out;
+	size_t size;
+} transaction_sink;
+
+static void transaction_put(transaction_sink *sink, const uint8_t *data, size_t size) {
+	if (size == 0) {
+		return;
+	}
+	if (sink->ctx) {
+		keccak256_update(sink->ctx, data, size);
+	} else if (sink->out) {
+		memcpy(sink->out + sink->size, data, size);
+	}
+	sink->size += size;
+}
+
+static void transaction_put_header(transaction_sink *sink, size_t size, uint8_t offset) {
+	uint8_t header[RLP_MAX_HEADER];
+	transaction_put(sink, header, rlp_put_header(header, size, offset));
+}
+
+static void transaction_put_string(transaction_sink *sink, const uint8_t *data, size_t size) {
+	if (size != 1 || data[0] >= 0x80) {
+		transaction_put_header(sink, size, RLP_STRING);
+	}
+	transaction_put(sink, data, size);
+}
+
+static void transaction_put_uint(transaction_sink *sink, uint64_t value) {
+	uint8_t encoded[RLP_MAX_HEADER];
+	transaction_put(sink, encoded, rlp_put_uint(encoded, value));
+}
+
+/* A 32-byte big-endian integer, without its leading zeros. */
+static void transaction_put_amount(transaction_sink *sink, const uint8_t *amount) {
+	size_t skip = 0;
+	while (skip < 32 && amount[skip] == 0) {
+		++skip;
+	}
+	transaction_put_string(sink, amount + skip, 32 - skip);
+}
+
+/* [[address, [storage key, ...]], ...] */
+static void transaction_put_access_list(transaction_sink *sink, const transaction *tx) {
+	size_t payload = 0, i, j;
+
+	for (i = 0; i < tx->access_list_count; ++i) {
+		size_t keys	 = 33 * tx->access_list[i].storage_key_count;
+		size_t entry = 21 + rlp_header_size(keys) + keys;
+		payload += rlp_header_size(entry) + entry;
+	}
+	transaction_put_header(sink, payload, RLP_LIST);
+	for (i = 0; i < tx->access_list_count; ++i) {
+		const transaction_access *access = &tx->access_list[i];
+		size_t keys						 = 33 * access->storage_key_count;
+		transaction_put_header(sink, 21 + rlp_header_size(keys) + keys, RLP_LIST);
+		transaction_put_string(sink, access->address, 20);
+		transaction_put_header(sink, keys, RLP_LIST);
+		for (j = 0; j < access->storage_key_count; ++j) {
+			transaction_put_string(sink, access->storage_keys + 32 * j, 32);
+		}
+	}
+}
+
+/* Emits the fields of tx, then v, r and s if signature is not NULL. An unsigned EIP-155
+   transaction ends in chain_id, 0, 0 instead. */
+static void transaction_put_fields(
+	transaction_sink *sink, const transaction *tx, const uint8_t *signature, uint64_t v
+) {
+	if (tx->type != TRANSACTION_LEGACY) {
+		transaction_put_uint(sink, tx->chain_id);
+	}
+	transaction_put_uint(sink, tx->nonce);
+	if (tx->type == TRANSACTION_DYNAMIC_FEE) {
+		transaction_put_amount(sink, tx->max_priority_fee_per_gas);
+		transaction_put_amount(sink, tx->max_fee_per_gas);
+	} else {
+		transaction_put_amount(sink, tx->gas_price);
+	}
+	transaction_put_uint(sink, tx->gas_limit);
+	transaction_put_string(sink, tx->to, tx->to ? 20 : 0);
+	transaction_put_amount(sink, tx->value);
+	transaction_put_string(sink, tx->data, tx->data_size);
+	if (tx->type != TRANSACTION_LEGACY) {
+		transaction_put_access_list(sink, tx);
+	}
+
+	if (signature) {
+		transaction_put_uint(sink, v);
+		transaction_put_amount(sink, signature);
+		transaction_put_amount(sink, signature + 32);
+	} else if (tx->type == TRANSACTION_LEGACY && tx->chain_id) {
+		transaction_put_uint(sink, tx->chain_id);
+		transaction_put_uint(sink, 0);
+		transaction_put_uint(sink, 0);
+	}
+}
+
+/* Emits the type byte of a typed transaction and the list of its fields, measured beforehand. */
+static void transaction_encode(transaction_sink *sink, const transaction *tx, const uint8_t *signature, uint64_t v) {
+	transaction_sink measure = {NULL, NULL, 0};
+	uint8_t type			 = (uint8_t)tx->type;
+
+	transaction_put_fields(&measure, tx, signature, v);
+	if (tx->type != TRANSACTION_LEGACY) {
+		transaction_put(sink, &type, 1);
+	}
+	transaction_put_header(sink, measure.size, RLP_LIST);
+	transaction_put_fields(sink, tx, signature, v);
+}
+
+static int transaction_type_is_valid(const transaction *tx) {
+	return tx->type == TRANSACTION_LEGACY || tx->type == TRANSACTION_ACCESS_LIST ||
+		   tx->type == TRANSACTION_DYNAMIC_FEE;
+}
+
+size_t transaction_signed_size(const transaction *tx) {
+	uint8_t signature[64];
+	transaction_sink measure = {NULL, NULL, 0};
+
+	memset(signature, 0xff, sizeof(signature));
+	transaction_encode(&measure, tx, signature, UINT64_MAX);
+	return measure.size;
+}
+
+int transaction_signing_hash(uint8_t *hash, const transaction *tx) {
+	keccak256_ctx ctx;
+	transaction_sink sink = {&ctx, NULL, 0};
+
+	if (!transaction_type_is_valid(tx)) {
+		return 0;
+	}
+	keccak256_init(&ctx);
+	transaction_encode(&sink, tx, NULL, 0);
+	keccak256_final(&ctx, hash);
+	return 1;
+}
+
+size_t transaction_sign(uint8_t *out, size_t out_size, const transaction *tx, const uint8_t *private_key) {
+	uint8_t hash[32], signature[64], recid;
+	transaction_sink sink = {NULL, NULL, 0};
+	uint64_t v;
+
+	/* v = recid + 35 + 2 * chain_id must fit in 64 bits. */
+	if (!transaction_type_is_valid(tx) ||
+		(tx->type == TRANSACTION_LEGACY && tx->chain_id > (UINT64_MAX - 36) / 2)) {
+		return 0;
+	}
+	transaction_signing_hash(hash, tx);
+	/* A recid of 2 or 3, for an R.x above n, has no v. */
+	if (!sign_rfc6979(private_key, hash, sizeof(hash), &recid, signature, uECC_secp256k1()) || recid > 1) {
+		return 0;
+	}
+	if (tx->type != TRANSACTION_LEGACY) {
+		v = recid;
+	} else if (tx->chain_id) {
+		v = recid + 35 + 2 * tx->chain_id;
+	} else {
+		v = recid + 27;
+	}
+
+	transaction_encode(&sink, tx, signature, v);
+	if (sink.size > out_size) {
+		return 0;
+	}
+	sink.out  = out;
+	sink.size = 0;
+	transaction_encode(&sink, tx, signature, v);
+	return sink.size;
+}
+
+/* Reads the item at *at of a list payload of size bytes, returning its kind and payload and
+   moving *at past it, or returns 0 if it is malformed. */
+static int transaction_next(const uint8_t *list, size_t size, size_t *at, const uint8_t **data, size_t *length) {
+	size_t offset;
+	int kind = rlp_read_header(list + *at, size - *at, &offset, length);
+	if (kind) {
+		*data = list + *at + offset;
+		*at += offset + *length;
+	}
+	return kind;
+}
+
+/* A big-endian integer string of at most 32 bytes into a 32-byte field. Leading zeros are
+   rejected, as rlp_read_uint() does for v. */
+static int transaction_read_scalar(uint8_t *out, const uint8_t *data, size_t size) {
+	if (size > 32 || (size > 0 && data[0] == 0)) {
+		return 0;
+	}
+	memset(out, 0, 32 - size);
+	memcpy(out + 32 - size, data, size);
+	return 1;
+}
+
+/* Decodes the signed transaction item of size bytes, an RLP list for a legacy transaction or a
+   string holding type || payload for a typed one. Computes its signing hash from the unsigned
+   fields in place, and reads r || s and the recid. Returns 1 on success, 0 if it is malformed. */
+static int transaction_decode(
+	uint8_t *hash, uint8_t *signature, uint8_t *recid, const uint8_t *item, size_t size
+) {
+	uint8_t type = TRANSACTION_LEGACY, header[RLP_MAX_HEADER], tail[RLP_MAX_HEADER + 2];
+	keccak256_chunk chunks[4];
+	const uint8_t *payload, *field;
+	size_t offset, length, field_length, fields, starts[3], at = 0, tail_size = 0, i;
+	unsigned count = 0;
+	uint64_t v;
+	int kind = rlp_read_header(item, size, &offset, &length);
+
+	if (kind == RLP_STRING) {
+		if (length == 0 || item[offset] < TRANSACTION_ACCESS_LIST || item[offset] > TRANSACTION_SENDERS_MAX_TYPE) {
+			return 0;
+		}
+		type = item[offset];
+		item += offset + 1;
+		size = length - 1;
+		if (rlp_read_header(item, size, &offset, &length) != RLP_LIST || offset + length != size) {
+			return 0;
+		}
+	} else if (kind != RLP_LIST) {
+		return 0;
+	}
+	payload = item + offset;
+
+	/* The unsigned fields are every item before the final v, r and s, however many the type has;
+	   starts keeps where the last three items begin. */
+	for (i = 0; at < length; ++i) {
+		starts[i % 3] = at;
+		if (!transaction_next(payload, length, &at, &field, &field_length)) {
+			return 0;
+		}
+	}
+	if (i < 4 || (type == TRANSACTION_LEGACY && i != 9)) {
+		return 0;
+	}
+	fields = at = starts[(i - 3) % 3];
+	if (transaction_next(payload, length, &at, &field, &field_length) != RLP_STRING ||
+		!rlp_read_uint(&v, field, field_length) ||
+		transaction_next(payload, length, &at, &field, &field_length) != RLP_STRING ||
+		!transaction_read_scalar(signature, field, field_length) ||
+		transaction_next(payload, length, &at, &field, &field_length) != RLP_STRING ||
+		!transaction_read_scalar(signature + 32, field, field_length) || at != length) {
+		return 0;
+	}
+
+	/* Typed transactions carry the y parity; legacy ones 27 or 28, or 35 + 2 * chain_id on. */
+	if (type != TRANSACTION_LEGACY) {
+		if (v > 1) {
+			return 0;
+		}
+		*recid = (uint8_t)v;
+	} else if (v == 27 || v == 28) {
+		*recid = (uint8_t)(v - 27);
+	} else if (v >= 35) {
+		*recid	  = (uint8_t)((v - 35) & 1);
+		tail_size = rlp_put_uint(tail, (v - 35) / 2);
+		tail[tail_size++] = RLP_STRING;
+		tail[tail_size++] = RLP_STRING;
+	} else {
+		return 0;
+	}
+
+	if (type != TRANSACTION_LEGACY) {
+		chunks[count].data	 = &type;
+		chunks[count++].size = 1;
+	}
+	chunks[count].data	 = header;
+	chunks[count++].size = rlp_put_header(header, fields + tail_size, RLP_LIST);
+	chunks[count].data	 = payload;
+	chunks[count++].size = fields;
+	chunks[count].data	 = tail;
+	chunks[count++].size = tail_size;
+	keccak256_gather(hash, chunks, count);
+	return 1;
+}
+
+/* Claims chunks of transactions, walking the list under the lock only as far as their headers,
+   and recovers their senders. */
+static void *transaction_senders_worker(void *arg) {
+	transaction_senders_shared *shared = (transaction_senders_shared *)arg;
+	uECC_Curve curve				   = uECC_secp256k1();
+	const uint8_t *items[uECC_BATCH_SIZE];
+	size_t item_sizes[uECC_BATCH_SIZE];
+	uint8_t hashes[uECC_BATCH_SIZE][32];
+	uint8_t signatures[uECC_BATCH_SIZE][64];
+	uint8_t recids[uECC_BATCH_SIZE];
+	uint8_t public_keys[uECC_BATCH_SIZE][64];
+	uint8_t recovered[uECC_BATCH_SIZE];
+	const uint8_t *inputs[uECC_BATCH_SIZE];
+	size_t sizes[uECC_BATCH_SIZE];
+	unsigned map[uECC_BATCH_SIZE];
+	unsigned chunk, decoded, i;
+	size_t first, offset, length;
+	int ok;
+
+	for (;;) {
+		pthread_mutex_lock(&shared->lock);
+		first = shared->next_index;
+		chunk = 0;
+		while (chunk < uECC_BATCH_SIZE && !shared->malformed && shared->cursor < shared->size) {
+			const uint8_t *item = shared->list + shared->cursor;
+			if (shared->next_index == shared->max_count ||
+				!rlp_read_header(item, shared->size - shared->cursor, &offset, &length)) {
+				shared->malformed = 1;
+				break;
+			}
+			items[chunk]		= item;
+			item_sizes[chunk++] = offset + length;
+			shared->cursor += offset + length;
+			shared->next_index++;
+		}
+		pthread_mutex_unlock(&shared->lock);
+		if (chunk == 0) {
+			return NULL;
+		}
+
+		decoded = 0;
+		for (i = 0; i < chunk; ++i) {
+			if (transaction_decode(hashes[decoded], signatures[decoded], &recids[decoded], items[i], item_sizes[i]) &&
+				signature_is_low_s(signatures[decoded], curve)) {
+				map[decoded++] = i;
+			}
+			memset(shared->senders + 20 * (first + i), 0, 20);
+			if (shared->valid) {
+				shared->valid[first + i] = 0;
+			}
+		}
+		ok = decoded == chunk;
+		if (decoded > 0) {
+			ok &= recover_rfc6979_batch(
+				hashes[0], 32, signatures[0], recids, decoded, public_keys[0], recovered, curve
+			);
+			for (i = 0; i < decoded; ++i) {
+				inputs[i] = public_keys[i];
+				sizes[i]  = 64;
+			}
+			keccak256_batch(hashes[0], inputs, sizes, decoded);
+			for (i = 0; i < decoded; ++i) {
+				if (recovered[i]) {
+					memcpy(shared->senders + 20 * (first + map[i]), hashes[i] + 12, 20);
+					if (shared->valid) {
+						shared->valid[first + map[i]] = 1;
+					}
+				}
+			}
+		}
+
+		if (!ok) {
+			pthread_mutex_lock(&shared->lock);
+			shared->ok = 0;
+			pthread_mutex_unlock(&shared->lock);
+		}
+	}
+}
+
+int transaction_senders(
+	uint8_t *senders,
+	uint8_t *valid,
+	size_t *count,
+	size_t max_count,
+	const uint8_t *transactions,
+	size_t size,
+	unsigned threads
+) {
+	transaction_senders_shared shared;
+	size_t offset, length;
+
+	*count = 0;
+	if (rlp_read_header(transactions, size, &offset, &length) != RLP_LIST || offset + length != size) {
+		return 0;
+	}
+	shared.list		  = transactions + offset;
+	shared.size		  = length;
+	shared.senders	  = senders;
+	shared.valid	  = valid;
+	shared.max_count  = max_count;
+	shared.cursor	  = 0;
+	shared.next_index = 0;
+	shared.malformed  = 0;
+	shared.ok		  = 1;
+	if (pthread_mutex_init(&shared.lock, NULL) != 0) {
+		return 0;
+	}
+
+	run_workers(transaction_senders_worker, &shared, threads, TRANSACTION_MAX_THREADS);
+	pthread_mutex_destroy(&shared.lock);
+
+	*count = shared.next_index;
+	return shared.ok && !shared.malformed;
+}
@@ -0,0 +1,90 @@
+//
+//  transaction.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#ifndef transaction_h
+#define transaction_h
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* EIP-2718 transaction types. */
+typedef enum {
+	TRANSACTION_LEGACY		= 0,
+	TRANSACTION_ACCESS_LIST = 1, /* EIP-2930 */
+	TRANSACTION_DYNAMIC_FEE = 2	 /* EIP-1559 */
+} transaction_type;
+
+/* One entry of an EIP-2930 access list. */
+typedef struct {
+	const uint8_t *address;		 /* 20 bytes */
+	const uint8_t *storage_keys; /* storage_key_count 32-byte keys, back to back */
+	size_t storage_key_count;
+} transaction_access;
+
+/* A transaction to sign. Amounts are 32-byte big-endian integers; the fields a type does not have
+   are ignored. Nothing is copied: to, data and the access list are read in place. */
+typedef struct {
+	transaction_type type;
+	uint64_t chain_id; /* 0 signs a legacy transaction without EIP-155 replay protection */
+	uint64_t nonce;
+	uint8_t gas_price[32];				  /* legacy and EIP-2930 */
+	uint8_t max_priority_fee_per_gas[32]; /* EIP-1559 */
+	uint8_t max_fee_per_gas[32];		  /* EIP-1559 */
+	uint64_t gas_limit;
+	const uint8_t *to; /* 20 bytes, NULL to create a contract */
+	uint8_t value[32];
+	const uint8_t *data;
+	size_t data_size;
+	const transaction_access *access_list; /* EIP-2930 and EIP-1559 */
+	size_t access_list_count;
+} transaction;
+
+/* Returns the largest size the signed encoding of tx can have, whatever its signature. */
+size_t transaction_signed_size(const transaction *tx);
+
+/* Computes the hash a signature of tx covers: Keccak-256 of its unsigned encoding, which is
+   streamed into the hash rather than built in memory. Returns 1 on success, 0 if the type of tx
+   is unknown. */
+int transaction_signing_hash(uint8_t *hash, const transaction *tx);
+
+/* Signs tx with private_key, using RFC 6979 nonces and low s, and writes its signed encoding, as
+   sent to eth_sendRawTransaction, to out. v is recid + 27 for a legacy transaction without chain
+   id, recid + 35 + 2 * chain_id with one (EIP-155), and the y parity recid for typed ones. The
+   encoding is streamed into Keccak for the hash and then written once; nothing is allocated.
+   Returns the size of the encoding, or 0 if the type or chain id is invalid, out_size is too
+   small, the key is invalid or the signature has no Ethereum v. */
+size_t transaction_sign(uint8_t *out, size_t out_size, const transaction *tx, const uint8_t *private_key);
+
+/* Most threads transaction_senders() starts. */
+#define TRANSACTION_MAX_THREADS 64
+
+/* Recovers the sender of every transaction of the size-byte RLP list transactions, as found in a
+   block body: legacy transactions as lists and typed ones, of types 1 to 4, as strings holding
+   type || payload. Everything before the final v, r and s of a typed payload is signed, so blob
+   (EIP-4844) and set-code (EIP-7702) transactions are read too.
+   senders receives 20 bytes per transaction and valid, if not NULL, 1 for every recovered sender
+   and 0 for every transaction that cannot be decoded, has a high s or no recoverable key, whose
+   sender is zeroed. *count receives the number of transactions, of which there may be at most
+   max_count.
+
+   Chunks of uECC_BATCH_SIZE transactions are handed out to threads threads, the calling thread
+   being one of them. Each chunk streams its signing payloads into Keccak in place, recovers its
+   public keys with recover_rfc6979_batch() and hashes them to addresses with keccak256_batch().
+
+   Returns 1 if every sender was recovered, 0 if one was not, the list is malformed or holds more
+   than max_count transactions. */
+int transaction_senders(
+	uint8_t *senders,
+	uint8_t *valid,
+	size_t *count,
+	size_t max_count,
+	const uint8_t *transactions,
+	size_t size,
+	unsigned threads
+);
+
+#endif /* transaction_h */
@@ -0,0 +1,444 @@
+//
+//  trie.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#include "trie.h"
+#include "../keccak256/keccak256.h"
+#include "rlp.h"
+#include "workers.h"
+
+#include <pthread.h>
+#include <string.h>
+
+#define TRIE_NONE UINT32_MAX
+
+/* Nodes hashed per keccak256_batch() call. */
+#define TRIE_BATCH 64
+
+/* Encoded size bounds: a reference to a child is at most 0xa0 and a hash, an empty slot 0x80. */
+#define TRIE_REF_SIZE	 33
+#define TRIE_BRANCH_SIZE (RLP_MAX_HEADER + 17)
+
+enum { TRIE_LEAF, TRIE_EXTENSION, TRIE_BRANCH };
+
+typedef struct {
+	uint32_t children[16]; /* TRIE_NONE when empty; an extension's child is children[0] */
+	uint32_t pair;		   /* key and value of a leaf, value of a branch, or a key below an extension */
+	uint32_t depth;		   /* key nibbles above the node */
+	uint32_t path;		   /* key nibbles in the path of a leaf or an extension */
+	uint32_t height;	   /* 0 for a leaf, one more than the highest child otherwise */
+	uint32_t size;		   /* nodes in the subtree, which are the size nodes ending at this one */
+	uint32_t encoded_size;
+	uint8_t kind;
+	size_t offset; /* of the encoding in the arena */
+	uint8_t hash[32];
+} trie_node;
+
+typedef struct {
+	const uint8_t *const *keys;
+	const size_t *key_sizes;
+	const uint8_t *const *values;
+	const size_t *value_sizes;
+	trie_node *nodes;
+	uint32_t node_count;
+	uint32_t max_nodes;
+	uint8_t *encodings;
+	size_t encoding_used;
+	size_t encoding_capacity;
+	uint32_t root;
+
+	/* Subtrees handed out to the threads, as [first, end) node ranges. */
+	pthread_mutex_t lock;
+	uint32_t task_first[16];
+	uint32_t task_end[16];
+	unsigned task_count;
+	unsigned next_task;
+} trie_builder;
+
+static unsigned trie_nibble(const uint8_t *key, size_t index) {
+	return index % 2 == 0 ? key[index / 2] >> 4 : key[index / 2] & 0x0f;
+}
+
+/* Encoded size of the hex-prefix form of a path of nibbles, which RLP wraps as a string. */
+static size_t trie_path_size(uint32_t nibbles) {
+	size_t size = nibbles / 2 + 1;
+	return size == 1 ? 1 : rlp_header_size(size) + size;
+}
+
+/* Writes the hex-prefix form of nibbles nibbles of key from start, as an RLP string. The flag
+   nibble is 2 for a leaf and 0 for an extension, plus 1 for an odd length. */
+static size_t trie_put_path(uint8_t *out, const uint8_t *key, uint32_t start, uint32_t nibbles, int leaf) {
+	size_t size		 = nibbles / 2 + 1;
+	size_t header	 = size == 1 ? 0 : rlp_put_header(out, size, RLP_STRING);
+	uint8_t *bytes	 = out + header;
+	unsigned flag	 = (leaf ? 2 : 0) + (nibbles % 2);
+	uint32_t i		 = 0;
+	size_t written	 = 1;
+
+	if (nibbles % 2) {
+		bytes[0] = (uint8_t)(flag << 4 | trie_nibble(key, start));
+		i		 = 1;
+	} else {
+		bytes[0] = (uint8_t)(flag << 4);
+	}
+	for (; i < nibbles; i += 2) {
+		bytes[written++] = (uint8_t)(trie_nibble(key, start + i) << 4 | trie_nibble(key, start + i + 1));
+	}
+	return header + size;
+}
+
+static uint32_t trie_new_node(trie_builder *b, uint8_t kind, uint32_t depth, size_t encoding_bound) {
+	trie_node *node;
+	if (b->node_count == b->max_nodes || b->encoding_capacity - b->encoding_used < encoding_bound) {
+		return TRIE_NONE;
+	}
+	node		 = &b->nodes[b->node_count];
+	node->kind	 = (uint8_t)kind;
+	node->depth	 = depth;
+	node->path	 = 0;
+	node->pair	 = TRIE_NONE;
+	node->height = 0;
+	node->offset = b->encoding_used;
+	memset(node->children, 0xff, sizeof(node->children));
+	b->encoding_used += encoding_bound;
+	return b->node_count++;
+}
+
+/* Builds the subtree of the pairs [lo, hi), which share their first depth nibbles. Children are
+   built before their parent, so every subtree occupies a contiguous range of nodes. */
+static uint32_t trie_build(trie_builder *b, uint32_t lo, uint32_t hi, uint32_t depth) {
+	const uint8_t *first = b->keys[lo], *last = b->keys[hi - 1];
+	size_t first_nibbles = 2 * b->key_sizes[lo], last_nibbles = 2 * b->key_sizes[hi - 1];
+	uint32_t start		 = b->node_count;
+	uint32_t common		 = 0;
+	uint32_t child, index, i, j;
+	unsigned n;
+
+	if (hi - lo == 1) {
+		uint32_t path  = (uint32_t)(first_nibbles - depth);
+		size_t value   = rlp_string_size(b->values[lo], b->value_sizes[lo]);
+		size_t payload = trie_path_size(path) + value;
+		if ((index = trie_new_node(b, TRIE_LEAF, depth, rlp_header_size(payload) + payload)) == TRIE_NONE) {
+			return TRIE_NONE;
+		}
+		b->nodes[index].pair = lo;
+		b->nodes[index].path = path;
+		b->nodes[index].size = 1;
+		return index;
+	}
+
+	/* The pairs are sorted, so the first and last keys share the prefix of the whole range. */
+	while (depth + common < first_nibbles && depth + common < last_nibbles &&
+		   trie_nibble(first, depth + common) == trie_nibble(last, depth + common)) {
+		++common;
+	}
+	if (common > 0) {
+		size_t payload = trie_path_size(common) + TRIE_REF_SIZE;
+		if ((child = trie_build(b, lo, hi, depth + common)) == TRIE_NONE ||
+			(index = trie_new_node(b, TRIE_EXTENSION, depth, rlp_header_size(payload) + payload)) == TRIE_NONE) {
+			return TRIE_NONE;
+		}
+		b->nodes[index].children[0] = child;
+		b->nodes[index].pair		= lo;
+		b->nodes[index].path		= common;
+		b->nodes[index].height		= b->nodes[child].height + 1;
+		b->nodes[index].size		= index - start + 1;
+		return index;
+	}
+
+	/* A branch. Only the first key, sorting before the keys it prefixes, can end here. */
+	{
+		uint32_t children[16], value = TRIE_NONE, height = 0;
+		size_t bound = TRIE_BRANCH_SIZE;
+
+		i = lo;
+		if (first_nibbles == depth) {
+			value = lo;
+			bound += rlp_string_size(b->values[lo], b->value_sizes[lo]);
+			++i;
+		}
+		for (n = 0; n < 16; ++n) {
+			children[n] = TRIE_NONE;
+			for (j = i; j < hi && trie_nibble(b->keys[j], depth) == n; ++j) {
+			}
+			if (j > i) {
+				if ((children[n] = trie_build(b, i, j, depth + 1)) == TRIE_NONE) {
+					return TRIE_NONE;
+				}
+				bound += TRIE_REF_SIZE - 1;
+				if (b->nodes[children[n]].height + 1 > height) {
+					height = b->nodes[children[n]].height + 1;
+				}
+			}
+			i = j;
+		}
+		if ((index = trie_new_node(b, TRIE_BRANCH, depth, bound)) == TRIE_NONE) {
+			return TRIE_NONE;
+		}
+		memcpy(b->nodes[index].children, children, sizeof(children));
+		b->nodes[index].pair   = value;
+		b->nodes[index].height = height;
+		b->nodes[index].size   = index - start + 1;
+		return index;
+	}
+}
+
+static size_t trie_ref_size(const trie_node *child) {
+	return child->encoded_size < 32 ? child->encoded_size : TRIE_REF_SIZE;
+}
+
+/* Embeds a child shorter than 32 bytes, refers to any other by its hash. */
+static size_t trie_put_ref(uint8_t *out, const trie_builder *b, const trie_node *child) {
+	if (child->encoded_size < 32) {
+		memcpy(out, b->encodings + child->offset, child->encoded_size);
+		return child->encoded_size;
+	}
+	out[0] = RLP_STRING + 32;
+	memcpy(out + 1, child->hash, 32);
+	return TRIE_REF_SIZE;
+}
+
+/* Encodes a node whose children are all encoded and hashed. */
+static void trie_encode(trie_builder *b, trie_node *node) {
+	uint8_t *out = b->encodings + node->offset;
+	size_t payload, at;
+	unsigned n;
+
+	switch (node->kind) {
+	case TRIE_LEAF:
+		payload = trie_path_size(node->path) + rlp_string_size(b->values[node->pair], b->value_sizes[node->pair]);
+		at		= rlp_put_header(out, payload, RLP_LIST);
+		at += trie_put_path(out + at, b->keys[node->pair], node->depth, node->path, 1);
+		at += rlp_put_string(out + at, b->values[node->pair], b->value_sizes[node->pair]);
+		break;
+	case TRIE_EXTENSION:
+		payload = trie_path_size(node->path) + trie_ref_size(&b->nodes[node->children[0]]);
+		at		= rlp_put_header(out, payload, RLP_LIST);
+		at += trie_put_path(out + at, b->keys[node->pair], node->depth, node->path, 0);
+		at += trie_put_ref(out + at, b, &b->nodes[node->children[0]]);
+		break;
+	default:
+		payload = node->pair == TRIE_NONE ? 1 : rlp_string_size(b->values[node->pair], b->value_sizes[node->pair]);
+		for (n = 0; n < 16; ++n) {
+			payload += node->children[n] == TRIE_NONE ? 1 : trie_ref_size(&b->nodes[node->children[n]]);
+		}
+		at = rlp_put_header(out, payload, RLP_LIST);
+		for (n = 0; n < 16; ++n) {
+			if (node->children[n] == TRIE_NONE) {
+				out[at++] = RLP_STRING;
+			} else {
+				at += trie_put_ref(out + at, b, &b->nodes[node->children[n]]);
+			}
+		}
+		if (node->pair == TRIE_NONE) {
+			out[at++] = RLP_STRING;
+		} else {
+			at += rlp_put_string(out + at, b->values[node->pair], b->value_sizes[node->pair]);
+		}
+		break;
+	}
+	node->encoded_size = (uint32_t)at;
+}
+
+/* Encodes and hashes the nodes [first, end) one height at a time, so that the nodes of a level
+   are hashed together. Every child of a node in the range must be in the range or done. */
+static void trie_hash_range(trie_builder *b, uint32_t first, uint32_t end) {
+	const uint8_t *inputs[TRIE_BATCH];
+	size_t sizes[TRIE_BATCH];
+	uint32_t batch[TRIE_BATCH];
+	uint8_t hashes[TRIE_BATCH][32];
+	uint32_t height, top = 0, i;
+	unsigned count, k;
+
+	for (i = first; i < end; ++i) {
+		top = b->nodes[i].height > top ? b->nodes[i].height : top;
+	}
+	for (height = 0; height <= top; ++height) {
+		count = 0;
+		for (i = first; i < end; ++i) {
+			trie_node *node = &b->nodes[i];
+			if (node->height == height) {
+				trie_encode(b, node);
+				if (node->encoded_size >= 32 || i == b->root) {
+					inputs[count]  = b->encodings + node->offset;
+					sizes[count]   = node->encoded_size;
+					batch[count++] = i;
+				}
+			}
+			if (count == TRIE_BATCH || i + 1 == end) {
+				keccak256_batch(hashes[0], inputs, sizes, count);
+				for (k = 0; k < count; ++k) {
+					memcpy(b->nodes[batch[k]].hash, hashes[k], 32);
+				}
+				count = 0;
+			}
+		}
+	}
+}
+
+static void *trie_worker(void *arg) {
+	trie_builder *b = (trie_builder *)arg;
+	unsigned task;
+	for (;;) {
+		pthread_mutex_lock(&b->lock);
+		task = b->next_task < b->task_count ? b->next_task++ : b->task_count;
+		pthread_mutex_unlock(&b->lock);
+		if (task == b->task_count) {
+			return NULL;
+		}
+		trie_hash_range(b, b->task_first[task], b->task_end[task]);
+	}
+}
+
+size_t trie_arena_size(size_t count, size_t max_key_size, size_t total_value_size) {
+	/* Per pair: a leaf (or a branch value) and at most one branch and one extension. Only the
+	   children of branches, fewer than the 3 nodes per pair, add to the size of a branch. */
+	size_t leaf		 = 3 * RLP_MAX_HEADER + 1 + max_key_size;
+	size_t extension = 2 * RLP_MAX_HEADER + 1 + max_key_size + TRIE_REF_SIZE;
+	size_t branch	 = TRIE_BRANCH_SIZE + 3 * (TRIE_REF_SIZE - 1);
+	return sizeof(uint64_t) + 3 * count * sizeof(trie_node) + count * (leaf + extension + branch) + total_value_size;
+}
+
+int trie_root(
+	uint8_t *root,
+	const uint8_t *const *keys,
+	const size_t *key_sizes,
+	const uint8_t *const *values,
+	const size_t *value_sizes,
+	size_t count,
+	void *arena,
+	size_t arena_size,
+	unsigned threads
+) {
+	static const uint8_t empty = RLP_STRING;
+	trie_builder b;
+	uintptr_t aligned = ((uintptr_t)arena + sizeof(uint64_t) - 1) & ~(uintptr_t)(sizeof(uint64_t) - 1);
+	size_t skipped	  = (size_t)(aligned - (uintptr_t)arena);
+	uint32_t split, n;
+	unsigned i;
+
+	if (count == 0) {
+		keccak256_raw(root, 32, &empty, 1, 1, 256);
+		return 1;
+	}
+	if (count >= TRIE_NONE / 3 || arena_size < skipped) {
+		return 0;
+	}
+	for (i = 0; i < count; ++i) {
+		if (value_sizes[i] == 0) {
+			return 0;
+		}
+		if (i > 0) {
+			size_t common = key_sizes[i - 1] < key_sizes[i] ? key_sizes[i - 1] : key_sizes[i];
+			int order	  = memcmp(keys[i - 1], keys[i], common);
+			if (order > 0 || (order == 0 && key_sizes[i - 1] >= key_sizes[i])) {
+				return 0;
+			}
+		}
+	}
+
+	b.keys		  = keys;
+	b.key_sizes	  = key_sizes;
+	b.values	  = values;
+	b.value_sizes = value_sizes;
+	b.nodes		  = (trie_node *)aligned;
+	b.node_count  = 0;
+	b.max_nodes	  = (uint32_t)(3 * count);
+	if ((arena_size - skipped) / sizeof(trie_node) < b.max_nodes) {
+		return 0;
+	}
+	b.encodings			= (uint8_t *)(b.nodes + b.max_nodes);
+	b.encoding_used		= 0;
+	b.encoding_capacity = arena_size - skipped - b.max_nodes * sizeof(trie_node);
+	if ((b.root = trie_build(&b, 0, (uint32_t)count, 0)) == TRIE_NONE) {
+		return 0;
+	}
+
+	/* A single thread hashes the whole trie in one range, batching each level across all of it. */
+	split = 0;
+	if (threads > 1) {
+		/* The subtrees of the top branch are independent; the nodes above them are done last. */
+		split = b.root;
+		if (b.nodes[split].kind == TRIE_EXTENSION) {
+			split = b.nodes[split].children[0];
+		}
+		b.task_count = 0;
+		b.next_task	 = 0;
+		if (b.nodes[split].kind == TRIE_BRANCH) {
+			for (n = 0; n < 16; ++n) {
+				uint32_t child = b.nodes[split].children[n];
+				if (child != TRIE_NONE) {
+					b.task_first[b.task_count] = child + 1 - b.nodes[child].size;
+					b.task_end[b.task_count++] = child + 1;
+				}
+			}
+		} else {
+			split = 0;
+		}
+
+		if (pthread_mutex_init(&b.lock, NULL) != 0) {
+			return 0;
+		}
+		run_workers(trie_worker, &b, threads, b.task_count < TRIE_MAX_THREADS ? b.task_count : TRIE_MAX_THREADS);
+		pthread_mutex_destroy(&b.lock);
+	}
+
+	trie_hash_range(&b, split, b.node_count);
+	memcpy(root, b.nodes[b.root].hash, 32);
+	return 1;
+}
+
+size_t trie_ordered_arena_size(size_t count, size_t total_value_size) {
+	size_t keys = count * (2 * sizeof(const uint8_t *) + 2 * sizeof(size_t) + RLP_MAX_HEADER);
+	return sizeof(uint64_t) + keys + trie_arena_size(count, RLP_MAX_HEADER, total_value_size);
+}
+
+int trie_ordered_root(
+	uint8_t *root,
+	const uint8_t *const *values,
+	const size_t *value_sizes,
+	size_t count,
+	void *arena,
+	size_t arena_size,
+	unsigned threads
+) {
+	uintptr_t aligned = ((uintptr_t)arena + sizeof(uint64_t) - 1) & ~(uintptr_t)(sizeof(uint64_t) - 1);
+	size_t skipped	  = (size_t)(aligned - (uintptr_t)arena);
+	size_t tables	  = count * (2 * sizeof(const uint8_t *) + 2 * sizeof(size_t) + RLP_MAX_HEADER);
+	const uint8_t **keys, **sorted_values;
+	size_t *key_sizes, *sorted_sizes, i, at, last_byte = count < 128 ? count - 1 : 127;
+	uint8_t *key_bytes;
+
+	if (arena_size < skipped || arena_size - skipped < tables) {
+		return 0;
+	}
+	keys		  = (const uint8_t **)aligned;
+	sorted_values = keys + count;
+	key_sizes	  = (size_t *)(sorted_values + count);
+	sorted_sizes  = key_sizes + count;
+	key_bytes	  = (uint8_t *)(sorted_sizes + count);
+
+	/* rlp(i) sorts 1..127 (single bytes) first, then 0 (0x80), then 128.. in numeric order, since
+	   longer integers get larger header bytes. Position last_byte holds 0. */
+	for (at = 0; at < count; ++at) {
+		i = at < last_byte ? at + 1 : (at == last_byte ? 0 : at);
+		keys[at]		  = key_bytes + at * RLP_MAX_HEADER;
+		key_sizes[at]	  = rlp_put_uint(key_bytes + at * RLP_MAX_HEADER, i);
+		sorted_values[at] = values[i];
+		sorted_sizes[at]  = value_sizes[i];
+	}
+	return trie_root(
+		root,
+		keys,
+		key_sizes,
+		sorted_values,
+		sorted_sizes,
+		count,
+		key_bytes + count * RLP_MAX_HEADER,
+		arena_size - skipped - tables,
+		threads
+	);
+}
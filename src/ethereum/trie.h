@@ -0,0 +1,61 @@
+//
+//  trie.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#ifndef trie_h
+#define trie_h
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Most threads a root computation uses: one per subtree of the top branch node. */
+#define TRIE_MAX_THREADS 16
+
+/* Returns the arena size trie_root() needs for count pairs whose keys are at most max_key_size
+   bytes long and whose values add up to total_value_size bytes. */
+size_t trie_arena_size(size_t count, size_t max_key_size, size_t total_value_size);
+
+/* Computes the root hash of the Merkle-Patricia trie holding count key/value pairs.
+
+   keys must be sorted in strictly increasing byte order (a prefix sorts first) and values must
+   not be empty. The trie is built in the caller's arena of arena_size bytes (see
+   trie_arena_size()); nothing else is allocated. Nodes are then hashed level by level from the
+   leaves, each level with keccak256_batch(); the node encodings shorter than 32 bytes are
+   embedded in their parents instead. With threads above 1, the subtrees below the top branch
+   node are hashed on up to threads threads.
+
+   Returns 1 on success, 0 if the keys are not sorted, a value is empty or the arena is too
+   small. An empty trie has the root keccak256(0x80). */
+int trie_root(
+	uint8_t *root,
+	const uint8_t *const *keys,
+	const size_t *key_sizes,
+	const uint8_t *const *values,
+	const size_t *value_sizes,
+	size_t count,
+	void *arena,
+	size_t arena_size,
+	unsigned threads
+);
+
+/* Returns the arena size trie_ordered_root() needs for count values adding up to
+   total_value_size bytes. */
+size_t trie_ordered_arena_size(size_t count, size_t total_value_size);
+
+/* Computes the root of the trie mapping rlp(i) to values[i], as the transactions and receipts
+   roots of a block do, without the caller having to build and sort the keys. Otherwise the same
+   as trie_root(). */
+int trie_ordered_root(
+	uint8_t *root,
+	const uint8_t *const *values,
+	const size_t *value_sizes,
+	size_t count,
+	void *arena,
+	size_t arena_size,
+	unsigned threads
+);
+
+#endif /* trie_h */
@@ -0,0 +1,32 @@
+//
+//  workers.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#include "workers.h"
+
+#include <pthread.h>
+
+void run_workers(void *(*fn)(void *), void *arg, unsigned threads, unsigned max) {
+	pthread_t workers[WORKERS_MAX];
+	unsigned started = 0, i;
+
+	if (max > WORKERS_MAX) {
+		max = WORKERS_MAX;
+	}
+	if (threads > max) {
+		threads = max;
+	}
+	for (i = 1; i < threads; ++i) {
+		if (pthread_create(&workers[i], NULL, fn, arg) != 0) {
+			break;
+		}
+		started = i;
+	}
+	fn(arg);
+	for (i = 1; i <= started; ++i) {
+		pthread_join(workers[i], NULL);
+	}
+}
@@ -0,0 +1,19 @@
+//
+//  workers.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#ifndef workers_h
+#define workers_h
+
+/* Most threads run_workers() starts, including the calling one. */
+#define WORKERS_MAX 64
+
+/* Runs fn(arg) on min(threads, max, WORKERS_MAX) threads, the calling one included, and returns
+   once all of them have. fn must share out the work through arg by itself. A thread that fails
+   to start leaves its share to the others; threads of 0 runs fn on the calling thread alone. */
+void run_workers(void *(*fn)(void *), void *arg, unsigned threads, unsigned max);
+
+#endif /* workers_h */
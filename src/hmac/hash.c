@@ -27,7 +27,7 @@ void secp256k1_write_be32(unsigned char *p, uint32_t x) {
 	p[0] = x >> 24;
 }
 
-static void secp256k1_sha256_initialize(secp256k1_sha256 *hash) {
+void secp256k1_sha256_initialize(secp256k1_sha256 *hash) {
 	hash->s[0]	= 0x6a09e667ul;
 	hash->s[1]	= 0xbb67ae85ul;
 	hash->s[2]	= 0x3c6ef372ul;
@@ -122,7 +122,7 @@ static void secp256k1_sha256_transform(uint32_t *s, const unsigned char *buf) {
 	s[7] += h;
 }
 
-static void secp256k1_sha256_write(secp256k1_sha256 *hash, const unsigned char *data, size_t len) {
+void secp256k1_sha256_write(secp256k1_sha256 *hash, const unsigned char *data, size_t len) {
 	size_t bufsize = hash->bytes & 0x3F;
 	hash->bytes += len;
 	VERIFY_CHECK(hash->bytes >= len);
@@ -141,7 +141,7 @@ static void secp256k1_sha256_write(secp256k1_sha256 *hash, const unsigned char *
 	}
 }
 
-static void secp256k1_sha256_finalize(secp256k1_sha256 *hash, unsigned char *out32) {
+void secp256k1_sha256_finalize(secp256k1_sha256 *hash, unsigned char *out32) {
 	static const unsigned char pad[64] = {0x80};
 	unsigned char sizedesc[8];
 	int i;
@@ -157,7 +157,20 @@ static void secp256k1_sha256_finalize(secp256k1_sha256 *hash, unsigned char *out
 	}
 }
 
-static void secp256k1_hmac_sha256_initialize(secp256k1_hmac_sha256 *hash, const unsigned char *key, size_t keylen) {
+void secp256k1_sha256_batch_weight(unsigned char *out16, const unsigned char *seed32, uint32_t index) {
+	secp256k1_sha256 hash;
+	unsigned char ctr[4];
+	unsigned char out[32];
+
+	secp256k1_write_be32(ctr, index);
+	secp256k1_sha256_initialize(&hash);
+	secp256k1_sha256_write(&hash, seed32, 32);
+	secp256k1_sha256_write(&hash, ctr, 4);
+	secp256k1_sha256_finalize(&hash, out);
+	memcpy(out16, out, 16);
+}
+
+void secp256k1_hmac_sha256_initialize(secp256k1_hmac_sha256 *hash, const unsigned char *key, size_t keylen) {
 	size_t n;
 	unsigned char rkey[64];
 	if (keylen <= sizeof(rkey)) {
@@ -185,11 +198,11 @@ static void secp256k1_hmac_sha256_initialize(secp256k1_hmac_sha256 *hash, const
 	memset(rkey, 0, sizeof(rkey));
 }
 
-static void secp256k1_hmac_sha256_write(secp256k1_hmac_sha256 *hash, const unsigned char *data, size_t size) {
+void secp256k1_hmac_sha256_write(secp256k1_hmac_sha256 *hash, const unsigned char *data, size_t size) {
 	secp256k1_sha256_write(&hash->inner, data, size);
 }
 
-static void secp256k1_hmac_sha256_finalize(secp256k1_hmac_sha256 *hash, unsigned char *out32) {
+void secp256k1_hmac_sha256_finalize(secp256k1_hmac_sha256 *hash, unsigned char *out32) {
 	unsigned char temp[32];
 	secp256k1_sha256_finalize(&hash->inner, temp);
 	secp256k1_sha256_write(&hash->outer, temp, 32);
@@ -197,21 +210,35 @@ static void secp256k1_hmac_sha256_finalize(secp256k1_hmac_sha256 *hash, unsigned
 	secp256k1_sha256_finalize(&hash->outer, out32);
 }
 
-void secp256k1_rfc6979_hmac_sha256_initialize(
-	secp256k1_rfc6979_hmac_sha256 *rng, const unsigned char *key, size_t keylen
-) {
-	secp256k1_hmac_sha256 hmac;
+void secp256k1_rfc6979_hmac_sha256_precompute(secp256k1_hmac_sha256 *prefix, const unsigned char *key, size_t keylen) {
 	static const unsigned char zero[1] = {0x00};
-	static const unsigned char one[1]  = {0x01};
+	unsigned char v[32];
+	unsigned char k[32];
+
+	memset(v, 0x01, 32); /* RFC6979 3.2.b. */
+	memset(k, 0x00, 32); /* RFC6979 3.2.c. */
+
+	/* RFC6979 3.2.d, up to the end of the shared key data. */
+	secp256k1_hmac_sha256_initialize(prefix, k, 32);
+	secp256k1_hmac_sha256_write(prefix, v, 32);
+	secp256k1_hmac_sha256_write(prefix, zero, 1);
+	secp256k1_hmac_sha256_write(prefix, key, keylen);
+}
+
+void secp256k1_rfc6979_hmac_sha256_initialize_prefixed(
+	secp256k1_rfc6979_hmac_sha256 *rng,
+	const secp256k1_hmac_sha256 *prefix,
+	const unsigned char *key,
+	size_t keylen,
+	size_t prefixlen
+) {
+	secp256k1_hmac_sha256 hmac		  = *prefix;
+	static const unsigned char one[1] = {0x01};
 
 	memset(rng->v, 0x01, 32); /* RFC6979 3.2.b. */
-	memset(rng->k, 0x00, 32); /* RFC6979 3.2.c. */
 
 	/* RFC6979 3.2.d. */
-	secp256k1_hmac_sha256_initialize(&hmac, rng->k, 32);
-	secp256k1_hmac_sha256_write(&hmac, rng->v, 32);
-	secp256k1_hmac_sha256_write(&hmac, zero, 1);
-	secp256k1_hmac_sha256_write(&hmac, key, keylen);
+	secp256k1_hmac_sha256_write(&hmac, key + prefixlen, keylen - prefixlen);
 	secp256k1_hmac_sha256_finalize(&hmac, rng->k);
 	secp256k1_hmac_sha256_initialize(&hmac, rng->k, 32);
 	secp256k1_hmac_sha256_write(&hmac, rng->v, 32);
@@ -229,6 +256,15 @@ void secp256k1_rfc6979_hmac_sha256_initialize(
 	rng->retry = 0;
 }
 
+void secp256k1_rfc6979_hmac_sha256_initialize(
+	secp256k1_rfc6979_hmac_sha256 *rng, const unsigned char *key, size_t keylen
+) {
+	secp256k1_hmac_sha256 prefix;
+
+	secp256k1_rfc6979_hmac_sha256_precompute(&prefix, key, 0);
+	secp256k1_rfc6979_hmac_sha256_initialize_prefixed(rng, &prefix, key, keylen, 0);
+}
+
 void secp256k1_rfc6979_hmac_sha256_generate(secp256k1_rfc6979_hmac_sha256 *rng, unsigned char *out, size_t outlen) {
 	/* RFC6979 3.2.h. */
 	static const unsigned char zero[1] = {0x00};
@@ -284,6 +320,11 @@ void secp256k1_int_cmov(int *r, const int *a, int flag) {
 	*r = (int)(r_masked | a_masked);
 }
 
+/* Calling memset through a volatile pointer keeps the compiler from dropping it as a dead store. */
+static void *(*const volatile secp256k1_memset)(void *, int, size_t) = memset;
+
+void secp256k1_memclear(void *ptr, size_t len) { secp256k1_memset(ptr, 0, len); }
+
 #undef Round
 #undef sigma1
 #undef sigma0
@@ -50,12 +50,43 @@ typedef struct {
 	int retry;
 } secp256k1_rfc6979_hmac_sha256;
 
+void secp256k1_sha256_initialize(secp256k1_sha256 *hash);
+void secp256k1_sha256_write(secp256k1_sha256 *hash, const unsigned char *data, size_t len);
+void secp256k1_sha256_finalize(secp256k1_sha256 *hash, unsigned char *out32);
+
+/* Writes the 128-bit weight of item index of a randomized batch verification, the first 16
+   bytes of SHA256(seed32 || index as 4 big-endian bytes). */
+void secp256k1_sha256_batch_weight(unsigned char *out16, const unsigned char *seed32, uint32_t index);
+
+void secp256k1_hmac_sha256_initialize(secp256k1_hmac_sha256 *hash, const unsigned char *key, size_t keylen);
+void secp256k1_hmac_sha256_write(secp256k1_hmac_sha256 *hash, const unsigned char *data, size_t size);
+void secp256k1_hmac_sha256_finalize(secp256k1_hmac_sha256 *hash, unsigned char *out32);
+
 void secp256k1_rfc6979_hmac_sha256_initialize(
 	secp256k1_rfc6979_hmac_sha256 *rng, const unsigned char *key, size_t keylen
 );
+
+/* Absorbs the part of RFC6979 3.2.d that only depends on the first keylen bytes of the key
+   data, HMAC_K(V || 0x00 || key) with the initial K and V, so it can be shared by every
+   initialization whose key data starts with the same bytes. */
+void secp256k1_rfc6979_hmac_sha256_precompute(secp256k1_hmac_sha256 *prefix, const unsigned char *key, size_t keylen);
+
+/* Same as secp256k1_rfc6979_hmac_sha256_initialize(), starting from a prefix computed over the
+   first prefixlen bytes of key. */
+void secp256k1_rfc6979_hmac_sha256_initialize_prefixed(
+	secp256k1_rfc6979_hmac_sha256 *rng,
+	const secp256k1_hmac_sha256 *prefix,
+	const unsigned char *key,
+	size_t keylen,
+	size_t prefixlen
+);
 void secp256k1_rfc6979_hmac_sha256_generate(secp256k1_rfc6979_hmac_sha256 *rng, unsigned char *out, size_t outlen);
 void secp256k1_rfc6979_hmac_sha256_finalize(secp256k1_rfc6979_hmac_sha256 *rng);
 
 void secp256k1_int_cmov(int *r, const int *a, int flag);
 
+/* Zeroes len bytes at ptr, even when they are never read again, for wiping secrets before they go
+   out of scope or are freed. */
+void secp256k1_memclear(void *ptr, size_t len);
+
 #endif /* hash_h */
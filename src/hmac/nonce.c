@@ -8,14 +8,16 @@
 //  Copyright © 2014 Pieter Wuille. MIT software license
 // ---------------------------------------------------------------------
 
-#include "hash.h"
 #include "int128.h"
-#include "scalar.h"
+#include "nonce.h"
 
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+const secp256k1_scalar secp256k1_scalar_one	 = SECP256K1_SCALAR_CONST(0, 0, 0, 0, 0, 0, 0, 1);
+const secp256k1_scalar secp256k1_scalar_zero = SECP256K1_SCALAR_CONST(0, 0, 0, 0, 0, 0, 0, 0);
+
 static void buffer_append(unsigned char *buf, unsigned int *offset, const void *data, unsigned int len) {
 	memcpy(buf + *offset, data, len);
 	*offset += len;
@@ -61,3 +63,32 @@ int nonce_function_rfc6979(
 	secp256k1_rfc6979_hmac_sha256_finalize(&rng);
 	return 1;
 }
+
+void nonce_function_rfc6979_precompute(secp256k1_hmac_sha256 *prefix, const unsigned char *key32) {
+	secp256k1_rfc6979_hmac_sha256_precompute(prefix, key32, 32);
+}
+
+int nonce_function_rfc6979_prefixed(
+	unsigned char *nonce32,
+	const secp256k1_hmac_sha256 *prefix,
+	const unsigned char *msg32,
+	const unsigned char *key32,
+	unsigned int counter
+) {
+	unsigned char keydata[64];
+	secp256k1_rfc6979_hmac_sha256 rng;
+	unsigned int i;
+	secp256k1_scalar msg;
+	/* Same key data as nonce_function_rfc6979() without extra data or algorithm name, the key
+	 * half of which is already absorbed into prefix. */
+	secp256k1_scalar_set_b32(&msg, msg32, NULL);
+	memcpy(keydata, key32, 32);
+	secp256k1_scalar_get_b32(keydata + 32, &msg);
+	secp256k1_rfc6979_hmac_sha256_initialize_prefixed(&rng, prefix, keydata, 64, 32);
+	memset(keydata, 0, sizeof(keydata));
+	for (i = 0; i <= counter; i++) {
+		secp256k1_rfc6979_hmac_sha256_generate(&rng, nonce32, 32);
+	}
+	secp256k1_rfc6979_hmac_sha256_finalize(&rng);
+	return 1;
+}
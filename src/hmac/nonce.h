@@ -11,10 +11,11 @@
 #ifndef nonce_h
 #define nonce_h
 
+#include "hash.h"
 #include "scalar.h"
 
-const secp256k1_scalar secp256k1_scalar_one	 = SECP256K1_SCALAR_CONST(0, 0, 0, 0, 0, 0, 0, 1);
-const secp256k1_scalar secp256k1_scalar_zero = SECP256K1_SCALAR_CONST(0, 0, 0, 0, 0, 0, 0, 0);
+extern const secp256k1_scalar secp256k1_scalar_one;
+extern const secp256k1_scalar secp256k1_scalar_zero;
 
 int nonce_function_rfc6979(
 	unsigned char *nonce32,
@@ -25,4 +26,18 @@ int nonce_function_rfc6979(
 	unsigned int counter
 );
 
+/* Absorbs key32 into an RFC 6979 prefix so that nonce_function_rfc6979_prefixed() can skip it
+   for every message signed under the same key. prefix holds key material; clear it after use. */
+void nonce_function_rfc6979_precompute(secp256k1_hmac_sha256 *prefix, const unsigned char *key32);
+
+/* Same as nonce_function_rfc6979() without extra data or algorithm name, with key32 already
+   absorbed into prefix by nonce_function_rfc6979_precompute(). */
+int nonce_function_rfc6979_prefixed(
+	unsigned char *nonce32,
+	const secp256k1_hmac_sha256 *prefix,
+	const unsigned char *msg32,
+	const unsigned char *key32,
+	unsigned int counter
+);
+
 #endif /* nonce_h */
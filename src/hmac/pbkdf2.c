@@ -0,0 +1,250 @@
+//
+//  pbkdf2.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#include "pbkdf2.h"
+#include "hash.h"
+
+#include <string.h>
+
+/* Every iteration after the first hashes a 64-byte value behind a 128-byte key block, so both the
+   inner and the outer hash are a single compression of the value followed by this padding. */
+static void pbkdf2_pad_block(uint64_t *w) {
+	int i;
+	w[8] = 0x8000000000000000ull;
+	for (i = 9; i < 15; ++i) {
+		w[i] = 0;
+	}
+	w[15] = (128 + 64) * 8;
+}
+
+/* Computes U_1 = HMAC(password, salt || INT(block)) and returns it as words in u. hmac holds the
+   key schedule, whose inner and outer states are the midstates of every later iteration. */
+static void pbkdf2_first(
+	uint64_t *u, const secp256k1_hmac_sha512 *hmac, const uint8_t *salt, size_t salt_size, uint32_t block
+) {
+	secp256k1_hmac_sha512 h = *hmac;
+	uint8_t index[4];
+	uint8_t digest[64];
+	int i;
+
+	index[0] = (uint8_t)(block >> 24);
+	index[1] = (uint8_t)(block >> 16);
+	index[2] = (uint8_t)(block >> 8);
+	index[3] = (uint8_t)block;
+	secp256k1_hmac_sha512_write(&h, salt, salt_size);
+	secp256k1_hmac_sha512_write(&h, index, 4);
+	secp256k1_hmac_sha512_finalize(&h, digest);
+	for (i = 0; i < 8; ++i) {
+		u[i] = secp256k1_read_be64(digest + 8 * i);
+	}
+	secp256k1_memclear(digest, sizeof(digest));
+}
+
+static void pbkdf2_output(uint8_t *out, size_t out_size, const uint64_t *t) {
+	uint8_t block[64];
+	int i;
+	for (i = 0; i < 8; ++i) {
+		secp256k1_write_be64(block + 8 * i, t[i]);
+	}
+	memcpy(out, block, out_size < 64 ? out_size : 64);
+	secp256k1_memclear(block, sizeof(block));
+}
+
+void pbkdf2_hmac_sha512(
+	const uint8_t *password,
+	size_t password_size,
+	const uint8_t *salt,
+	size_t salt_size,
+	uint32_t iterations,
+	uint8_t *out,
+	size_t out_size
+) {
+	secp256k1_hmac_sha512 hmac;
+	uint64_t u[8], t[8], s[8], w[16];
+	uint32_t block, j;
+	int i;
+
+	secp256k1_hmac_sha512_initialize(&hmac, password, password_size);
+	for (block = 1; out_size > 0; ++block) {
+		pbkdf2_first(u, &hmac, salt, salt_size, block);
+		memcpy(t, u, sizeof(t));
+		for (j = 1; j < iterations; ++j) {
+			memcpy(s, hmac.inner.s, sizeof(s));
+			memcpy(w, u, sizeof(u));
+			pbkdf2_pad_block(w);
+			secp256k1_sha512_compress(s, w);
+
+			memcpy(u, hmac.outer.s, sizeof(u));
+			memcpy(w, s, sizeof(s));
+			pbkdf2_pad_block(w);
+			secp256k1_sha512_compress(u, w);
+			for (i = 0; i < 8; ++i) {
+				t[i] ^= u[i];
+			}
+		}
+		pbkdf2_output(out, out_size, t);
+		out += out_size < 64 ? out_size : 64;
+		out_size -= out_size < 64 ? out_size : 64;
+	}
+
+	secp256k1_memclear(&hmac, sizeof(hmac));
+	secp256k1_memclear(u, sizeof(u));
+	secp256k1_memclear(t, sizeof(t));
+	secp256k1_memclear(s, sizeof(s));
+	secp256k1_memclear(w, sizeof(w));
+}
+
+#define PBKDF2_ROUND(a, b, c, d, e, f, g, h, k, w)                                  \
+	for (l = 0; l < PBKDF2_LANES; ++l) {                                            \
+		uint64_t t1 = h[l] + Sigma1_64(e[l]) + Ch64(e[l], f[l], g[l]) + (k) + w[l]; \
+		uint64_t t2 = Sigma0_64(a[l]) + Maj64(a[l], b[l], c[l]);                    \
+		d[l] += t1;                                                                 \
+		h[l] = t1 + t2;                                                             \
+	}
+
+#define PBKDF2_SCHEDULE(i)                                                      \
+	if ((i) >= 16) {                                                            \
+		for (l = 0; l < PBKDF2_LANES; ++l) {                                    \
+			w[(i) & 15][l] += sigma1_64(w[((i) + 14) & 15][l]) + w[((i) + 9) & 15][l] + \
+							  sigma0_64(w[((i) + 1) & 15][l]);                  \
+		}                                                                       \
+	}
+
+/* secp256k1_sha512_compress() on PBKDF2_LANES interleaved states and blocks. */
+static void pbkdf2_compress_lanes(uint64_t (*s)[PBKDF2_LANES], uint64_t (*w)[PBKDF2_LANES]) {
+	uint64_t a[PBKDF2_LANES], b[PBKDF2_LANES], c[PBKDF2_LANES], d[PBKDF2_LANES];
+	uint64_t e[PBKDF2_LANES], f[PBKDF2_LANES], g[PBKDF2_LANES], h[PBKDF2_LANES];
+	int i, l;
+
+	for (l = 0; l < PBKDF2_LANES; ++l) {
+		a[l] = s[0][l];
+		b[l] = s[1][l];
+		c[l] = s[2][l];
+		d[l] = s[3][l];
+		e[l] = s[4][l];
+		f[l] = s[5][l];
+		g[l] = s[6][l];
+		h[l] = s[7][l];
+	}
+
+	for (i = 0; i < 80; i += 8) {
+		PBKDF2_SCHEDULE(i);
+		PBKDF2_ROUND(a, b, c, d, e, f, g, h, secp256k1_sha512_k[i], w[i & 15]);
+		PBKDF2_SCHEDULE(i + 1);
+		PBKDF2_ROUND(h, a, b, c, d, e, f, g, secp256k1_sha512_k[i + 1], w[(i + 1) & 15]);
+		PBKDF2_SCHEDULE(i + 2);
+		PBKDF2_ROUND(g, h, a, b, c, d, e, f, secp256k1_sha512_k[i + 2], w[(i + 2) & 15]);
+		PBKDF2_SCHEDULE(i + 3);
+		PBKDF2_ROUND(f, g, h, a, b, c, d, e, secp256k1_sha512_k[i + 3], w[(i + 3) & 15]);
+		PBKDF2_SCHEDULE(i + 4);
+		PBKDF2_ROUND(e, f, g, h, a, b, c, d, secp256k1_sha512_k[i + 4], w[(i + 4) & 15]);
+		PBKDF2_SCHEDULE(i + 5);
+		PBKDF2_ROUND(d, e, f, g, h, a, b, c, secp256k1_sha512_k[i + 5], w[(i + 5) & 15]);
+		PBKDF2_SCHEDULE(i + 6);
+		PBKDF2_ROUND(c, d, e, f, g, h, a, b, secp256k1_sha512_k[i + 6], w[(i + 6) & 15]);
+		PBKDF2_SCHEDULE(i + 7);
+		PBKDF2_ROUND(b, c, d, e, f, g, h, a, secp256k1_sha512_k[i + 7], w[(i + 7) & 15]);
+	}
+
+	for (l = 0; l < PBKDF2_LANES; ++l) {
+		s[0][l] += a[l];
+		s[1][l] += b[l];
+		s[2][l] += c[l];
+		s[3][l] += d[l];
+		s[4][l] += e[l];
+		s[5][l] += f[l];
+		s[6][l] += g[l];
+		s[7][l] += h[l];
+	}
+}
+
+void pbkdf2_hmac_sha512_multi(
+	const uint8_t *const *passwords,
+	const size_t *password_sizes,
+	const uint8_t *const *salts,
+	const size_t *salt_sizes,
+	unsigned count,
+	uint32_t iterations,
+	uint8_t *out,
+	size_t out_size
+) {
+	secp256k1_hmac_sha512 hmac[PBKDF2_LANES];
+	uint64_t inner[8][PBKDF2_LANES], outer[8][PBKDF2_LANES];
+	uint64_t u[8][PBKDF2_LANES], t[8][PBKDF2_LANES], s[8][PBKDF2_LANES], w[16][PBKDF2_LANES];
+	uint64_t lane[16];
+	unsigned done, lanes, k;
+	uint32_t block, j;
+	size_t offset;
+	int i, l;
+
+	for (done = 0; done < count; done += PBKDF2_LANES) {
+		lanes = count - done < PBKDF2_LANES ? count - done : PBKDF2_LANES;
+
+		/* Idle lanes repeat the last derivation; their results are dropped. */
+		for (l = 0; l < PBKDF2_LANES; ++l) {
+			k = done + ((unsigned)l < lanes ? (unsigned)l : lanes - 1);
+			secp256k1_hmac_sha512_initialize(&hmac[l], passwords[k], password_sizes[k]);
+			for (i = 0; i < 8; ++i) {
+				inner[i][l] = hmac[l].inner.s[i];
+				outer[i][l] = hmac[l].outer.s[i];
+			}
+		}
+
+		for (block = 1, offset = 0; offset < out_size; ++block, offset += 64) {
+			for (l = 0; l < PBKDF2_LANES; ++l) {
+				k = done + ((unsigned)l < lanes ? (unsigned)l : lanes - 1);
+				pbkdf2_first(lane, &hmac[l], salts[k], salt_sizes[k], block);
+				for (i = 0; i < 8; ++i) {
+					u[i][l] = t[i][l] = lane[i];
+				}
+			}
+
+			for (j = 1; j < iterations; ++j) {
+				memcpy(s, inner, sizeof(s));
+				memcpy(w, u, sizeof(u));
+				pbkdf2_pad_block(lane);
+				for (i = 8; i < 16; ++i) {
+					for (l = 0; l < PBKDF2_LANES; ++l) {
+						w[i][l] = lane[i];
+					}
+				}
+				pbkdf2_compress_lanes(s, w);
+
+				memcpy(u, outer, sizeof(u));
+				memcpy(w, s, sizeof(s));
+				for (i = 8; i < 16; ++i) {
+					for (l = 0; l < PBKDF2_LANES; ++l) {
+						w[i][l] = lane[i];
+					}
+				}
+				pbkdf2_compress_lanes(u, w);
+				for (i = 0; i < 8; ++i) {
+					for (l = 0; l < PBKDF2_LANES; ++l) {
+						t[i][l] ^= u[i][l];
+					}
+				}
+			}
+
+			for (l = 0; l < (int)lanes; ++l) {
+				size_t size = out_size - offset < 64 ? out_size - offset : 64;
+				for (i = 0; i < 8; ++i) {
+					lane[i] = t[i][l];
+				}
+				pbkdf2_output(out + (size_t)(done + l) * out_size + offset, size, lane);
+			}
+		}
+	}
+
+	secp256k1_memclear(hmac, sizeof(hmac));
+	secp256k1_memclear(inner, sizeof(inner));
+	secp256k1_memclear(outer, sizeof(outer));
+	secp256k1_memclear(u, sizeof(u));
+	secp256k1_memclear(t, sizeof(t));
+	secp256k1_memclear(s, sizeof(s));
+	secp256k1_memclear(w, sizeof(w));
+	secp256k1_memclear(lane, sizeof(lane));
+}
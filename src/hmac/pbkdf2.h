@@ -0,0 +1,45 @@
+//
+//  pbkdf2.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#ifndef pbkdf2_h
+#define pbkdf2_h
+
+#include "sha512.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Number of derivations pbkdf2_hmac_sha512_multi() runs side by side. The lanes are plain arrays
+   that the compiler can map onto SIMD registers; they also hide the latency of the serial
+   SHA-512 rounds when it does not. */
+#define PBKDF2_LANES 4
+
+/* Computes out_size bytes of PBKDF2-HMAC-SHA512 (RFC 8018) of password and salt. */
+void pbkdf2_hmac_sha512(
+	const uint8_t *password,
+	size_t password_size,
+	const uint8_t *salt,
+	size_t salt_size,
+	uint32_t iterations,
+	uint8_t *out,
+	size_t out_size
+);
+
+/* Runs count independent derivations with the same iteration count and output size, as
+   pbkdf2_hmac_sha512(), PBKDF2_LANES at a time. Outputs are written back to back. */
+void pbkdf2_hmac_sha512_multi(
+	const uint8_t *const *passwords,
+	const size_t *password_sizes,
+	const uint8_t *const *salts,
+	const size_t *salt_sizes,
+	unsigned count,
+	uint32_t iterations,
+	uint8_t *out,
+	size_t out_size
+);
+
+#endif /* pbkdf2_h */
@@ -0,0 +1,168 @@
+//
+//  sha512.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#include "sha512.h"
+
+#include <string.h>
+
+const uint64_t secp256k1_sha512_k[80] = {
+	0x428a2f98d728ae22ull, 0x7137449123ef65cdull, 0xb5c0fbcfec4d3b2full, 0xe9b5dba58189dbbcull, 0x3956c25bf348b538ull,
+	0x59f111f1b605d019ull, 0x923f82a4af194f9bull, 0xab1c5ed5da6d8118ull, 0xd807aa98a3030242ull, 0x12835b0145706fbeull,
+	0x243185be4ee4b28cull, 0x550c7dc3d5ffb4e2ull, 0x72be5d74f27b896full, 0x80deb1fe3b1696b1ull, 0x9bdc06a725c71235ull,
+	0xc19bf174cf692694ull, 0xe49b69c19ef14ad2ull, 0xefbe4786384f25e3ull, 0x0fc19dc68b8cd5b5ull, 0x240ca1cc77ac9c65ull,
+	0x2de92c6f592b0275ull, 0x4a7484aa6ea6e483ull, 0x5cb0a9dcbd41fbd4ull, 0x76f988da831153b5ull, 0x983e5152ee66dfabull,
+	0xa831c66d2db43210ull, 0xb00327c898fb213full, 0xbf597fc7beef0ee4ull, 0xc6e00bf33da88fc2ull, 0xd5a79147930aa725ull,
+	0x06ca6351e003826full, 0x142929670a0e6e70ull, 0x27b70a8546d22ffcull, 0x2e1b21385c26c926ull, 0x4d2c6dfc5ac42aedull,
+	0x53380d139d95b3dfull, 0x650a73548baf63deull, 0x766a0abb3c77b2a8ull, 0x81c2c92e47edaee6ull, 0x92722c851482353bull,
+	0xa2bfe8a14cf10364ull, 0xa81a664bbc423001ull, 0xc24b8b70d0f89791ull, 0xc76c51a30654be30ull, 0xd192e819d6ef5218ull,
+	0xd69906245565a910ull, 0xf40e35855771202aull, 0x106aa07032bbd1b8ull, 0x19a4c116b8d2d0c8ull, 0x1e376c085141ab53ull,
+	0x2748774cdf8eeb99ull, 0x34b0bcb5e19b48a8ull, 0x391c0cb3c5c95a63ull, 0x4ed8aa4ae3418acbull, 0x5b9cca4f7763e373ull,
+	0x682e6ff3d6b2b8a3ull, 0x748f82ee5defb2fcull, 0x78a5636f43172f60ull, 0x84c87814a1f0ab72ull, 0x8cc702081a6439ecull,
+	0x90befffa23631e28ull, 0xa4506cebde82bde9ull, 0xbef9a3f7b2c67915ull, 0xc67178f2e372532bull, 0xca273eceea26619cull,
+	0xd186b8c721c0c207ull, 0xeada7dd6cde0eb1eull, 0xf57d4f7fee6ed178ull, 0x06f067aa72176fbaull, 0x0a637dc5a2c898a6ull,
+	0x113f9804bef90daeull, 0x1b710b35131c471bull, 0x28db77f523047d84ull, 0x32caab7b40c72493ull, 0x3c9ebe0a15c9bebcull,
+	0x431d67c49c100d4cull, 0x4cc5d4becb3e42b6ull, 0x597f299cfc657e2aull, 0x5fcb6fab3ad6faecull, 0x6c44198c4a475817ull};
+
+uint64_t secp256k1_read_be64(const unsigned char *p) {
+	return (uint64_t)p[0] << 56 | (uint64_t)p[1] << 48 | (uint64_t)p[2] << 40 | (uint64_t)p[3] << 32 |
+		   (uint64_t)p[4] << 24 | (uint64_t)p[5] << 16 | (uint64_t)p[6] << 8 | (uint64_t)p[7];
+}
+
+void secp256k1_write_be64(unsigned char *p, uint64_t x) {
+	int i;
+	for (i = 7; i >= 0; --i) {
+		p[i] = (unsigned char)x;
+		x >>= 8;
+	}
+}
+
+void secp256k1_sha512_initialize(secp256k1_sha512 *hash) {
+	hash->s[0]	= 0x6a09e667f3bcc908ull;
+	hash->s[1]	= 0xbb67ae8584caa73bull;
+	hash->s[2]	= 0x3c6ef372fe94f82bull;
+	hash->s[3]	= 0xa54ff53a5f1d36f1ull;
+	hash->s[4]	= 0x510e527fade682d1ull;
+	hash->s[5]	= 0x9b05688c2b3e6c1full;
+	hash->s[6]	= 0x1f83d9abfb41bd6bull;
+	hash->s[7]	= 0x5be0cd19137e2179ull;
+	hash->bytes = 0;
+}
+
+void secp256k1_sha512_compress(uint64_t *s, uint64_t *w) {
+	uint64_t a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+	uint64_t t1, t2;
+	int i;
+
+	for (i = 0; i < 80; ++i) {
+		if (i >= 16) {
+			w[i & 15] += sigma1_64(w[(i + 14) & 15]) + w[(i + 9) & 15] + sigma0_64(w[(i + 1) & 15]);
+		}
+		t1 = h + Sigma1_64(e) + Ch64(e, f, g) + secp256k1_sha512_k[i] + w[i & 15];
+		t2 = Sigma0_64(a) + Maj64(a, b, c);
+		h  = g;
+		g  = f;
+		f  = e;
+		e  = d + t1;
+		d  = c;
+		c  = b;
+		b  = a;
+		a  = t1 + t2;
+	}
+
+	s[0] += a;
+	s[1] += b;
+	s[2] += c;
+	s[3] += d;
+	s[4] += e;
+	s[5] += f;
+	s[6] += g;
+	s[7] += h;
+}
+
+/** Perform one SHA-512 transformation, processing 16 big endian 64-bit words. */
+static void secp256k1_sha512_transform(uint64_t *s, const unsigned char *buf) {
+	uint64_t w[16];
+	int i;
+
+	for (i = 0; i < 16; ++i) {
+		w[i] = secp256k1_read_be64(buf + 8 * i);
+	}
+	secp256k1_sha512_compress(s, w);
+}
+
+void secp256k1_sha512_write(secp256k1_sha512 *hash, const unsigned char *data, size_t len) {
+	size_t bufsize = hash->bytes & 0x7F;
+	hash->bytes += len;
+	while (len >= 128 - bufsize) {
+		/* Fill the buffer, and process it. */
+		size_t chunk_len = 128 - bufsize;
+		memcpy(hash->buf + bufsize, data, chunk_len);
+		data += chunk_len;
+		len -= chunk_len;
+		secp256k1_sha512_transform(hash->s, hash->buf);
+		bufsize = 0;
+	}
+	if (len) {
+		/* Fill the buffer with what remains. */
+		memcpy(hash->buf + bufsize, data, len);
+	}
+}
+
+void secp256k1_sha512_finalize(secp256k1_sha512 *hash, unsigned char *out64) {
+	static const unsigned char pad[128] = {0x80};
+	unsigned char sizedesc[16] = {0};
+	int i;
+	/* Messages are limited to 2^64-1 bytes, so the upper half of the bit count is the top 3 bits. */
+	secp256k1_write_be64(&sizedesc[0], hash->bytes >> 61);
+	secp256k1_write_be64(&sizedesc[8], hash->bytes << 3);
+	secp256k1_sha512_write(hash, pad, 1 + ((239 - (hash->bytes % 128)) % 128));
+	secp256k1_sha512_write(hash, sizedesc, 16);
+	for (i = 0; i < 8; i++) {
+		secp256k1_write_be64(&out64[8 * i], hash->s[i]);
+		hash->s[i] = 0;
+	}
+}
+
+void secp256k1_hmac_sha512_initialize(secp256k1_hmac_sha512 *hash, const unsigned char *key, size_t keylen) {
+	size_t n;
+	unsigned char rkey[128];
+	if (keylen <= sizeof(rkey)) {
+		memcpy(rkey, key, keylen);
+		memset(rkey + keylen, 0, sizeof(rkey) - keylen);
+	} else {
+		secp256k1_sha512 sha512;
+		secp256k1_sha512_initialize(&sha512);
+		secp256k1_sha512_write(&sha512, key, keylen);
+		secp256k1_sha512_finalize(&sha512, rkey);
+		memset(rkey + 64, 0, 64);
+	}
+
+	secp256k1_sha512_initialize(&hash->outer);
+	for (n = 0; n < sizeof(rkey); n++) {
+		rkey[n] ^= 0x5c;
+	}
+	secp256k1_sha512_write(&hash->outer, rkey, sizeof(rkey));
+
+	secp256k1_sha512_initialize(&hash->inner);
+	for (n = 0; n < sizeof(rkey); n++) {
+		rkey[n] ^= 0x5c ^ 0x36;
+	}
+	secp256k1_sha512_write(&hash->inner, rkey, sizeof(rkey));
+	memset(rkey, 0, sizeof(rkey));
+}
+
+void secp256k1_hmac_sha512_write(secp256k1_hmac_sha512 *hash, const unsigned char *data, size_t size) {
+	secp256k1_sha512_write(&hash->inner, data, size);
+}
+
+void secp256k1_hmac_sha512_finalize(secp256k1_hmac_sha512 *hash, unsigned char *out64) {
+	unsigned char temp[64];
+	secp256k1_sha512_finalize(&hash->inner, temp);
+	secp256k1_sha512_write(&hash->outer, temp, 64);
+	memset(temp, 0, 64);
+	secp256k1_sha512_finalize(&hash->outer, out64);
+}
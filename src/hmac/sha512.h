@@ -0,0 +1,53 @@
+//
+//  sha512.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#ifndef sha512_h
+#define sha512_h
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#define ROTR64(x, n) ((x) >> (n) | (x) << (64 - (n)))
+
+#define Ch64(x, y, z)  ((z) ^ ((x) & ((y) ^ (z))))
+#define Maj64(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
+#define Sigma0_64(x)   (ROTR64(x, 28) ^ ROTR64(x, 34) ^ ROTR64(x, 39))
+#define Sigma1_64(x)   (ROTR64(x, 14) ^ ROTR64(x, 18) ^ ROTR64(x, 41))
+#define sigma0_64(x)   (ROTR64(x, 1) ^ ROTR64(x, 8) ^ ((x) >> 7))
+#define sigma1_64(x)   (ROTR64(x, 19) ^ ROTR64(x, 61) ^ ((x) >> 6))
+
+/* SHA-512 round constants. */
+extern const uint64_t secp256k1_sha512_k[80];
+
+typedef struct {
+	uint64_t s[8];
+	unsigned char buf[128];
+	uint64_t bytes;
+} secp256k1_sha512;
+
+typedef struct {
+	secp256k1_sha512 inner, outer;
+} secp256k1_hmac_sha512;
+
+uint64_t secp256k1_read_be64(const unsigned char *p);
+void secp256k1_write_be64(unsigned char *p, uint64_t x);
+
+void secp256k1_sha512_initialize(secp256k1_sha512 *hash);
+void secp256k1_sha512_write(secp256k1_sha512 *hash, const unsigned char *data, size_t len);
+void secp256k1_sha512_finalize(secp256k1_sha512 *hash, unsigned char *out64);
+
+/* Runs the compression function on state s for one block given as 16 message words, for callers
+   that pad fixed-length messages themselves. w is used as scratch space. */
+void secp256k1_sha512_compress(uint64_t *s, uint64_t *w);
+
+/* HMAC-SHA512 as in RFC 4231. An initialized state only depends on the key, so it can be copied
+   and reused for many messages under the same key. */
+void secp256k1_hmac_sha512_initialize(secp256k1_hmac_sha512 *hash, const unsigned char *key, size_t keylen);
+void secp256k1_hmac_sha512_write(secp256k1_hmac_sha512 *hash, const unsigned char *data, size_t size);
+void secp256k1_hmac_sha512_finalize(secp256k1_hmac_sha512 *hash, unsigned char *out64);
+
+#endif /* sha512_h */
@@ -1,3 +1,17 @@
+#include "../bip32/bip32.h"
+#include "../bip32/bip39.h"
+#include "../ethereum/address.h"
+#include "../ethereum/bloom.h"
+#include "../ethereum/create2.h"
+#include "../ethereum/eip712.h"
+#include "../ethereum/rlp.h"
+#include "../ethereum/transaction.h"
+#include "../ethereum/trie.h"
 #include "../keccak256/keccak256.h"
+#include "../rfc6979/cache.h"
+#include "../rfc6979/der.h"
+#include "../rfc6979/key_cache.h"
 #include "../rfc6979/sign.h"
 #include "../rfc6979/verify.h"
+#include "../schnorr/schnorr.h"
+#include "../scan/key_scan.h"
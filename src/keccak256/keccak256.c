@@ -6,6 +6,8 @@
 // ---------------------------------------------------------------------
 //  adapted from keccak-tiny
 //  Copyright © David Leon Gily. CC0 license
+//  lane-complemented rounds adapted from the Keccak team's XKCP
+//  (KeccakP-1600-opt64). CC0 license
 // ---------------------------------------------------------------------
 //
 //  A single-file implementation of SHA-3 and SHAKE
@@ -16,9 +18,6 @@
 /******** The Keccak-f[1600] permutation ********/
 
 /*** Constants. ***/
-static const uint8_t rho[24] = {1,	3,	6,	10, 15, 21, 28, 36, 45, 55, 2,	14,
-								27, 41, 56, 8,	25, 43, 62, 18, 39, 61, 20, 44};
-static const uint8_t pi[24]	 = {10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1};
 static const uint64_t RC[24] = {
 	1ULL,
 	0x8082ULL,
@@ -47,105 +46,265 @@ static const uint64_t RC[24] = {
 };
 
 /*** Helper macros to unroll the permutation. ***/
-#define rol(x, s)	(((x) << s) | ((x) >> (64 - s)))
-#define REPEAT6(e)	e e e e e e
-#define REPEAT24(e) REPEAT6(e e e e)
-#define REPEAT5(e)	e e e e e
-#define FOR5(v, s, e) \
-	v = 0;            \
-	REPEAT5(e; v += s;)
-
-/*** Keccak-f[1600] ***/
-static inline void keccakf(void *state) {
-	uint64_t *a	  = (uint64_t *)state;
-	uint64_t b[5] = {0};
-	uint64_t t	  = 0;
-	uint8_t x, y;
-
-	for (int i = 0; i < 24; i++) {
-		// Theta
-		FOR5(x, 1, b[x] = 0; FOR5(y, 5, b[x] ^= a[x + y];))
-		FOR5(x, 1, FOR5(y, 5, a[y + x] ^= b[(x + 4) % 5] ^ rol(b[(x + 1) % 5], 1);))
-		// Rho and pi
-		t = a[1];
-		x = 0;
-		REPEAT24(b[0] = a[pi[x]]; a[pi[x]] = rol(t, rho[x]); t = b[0]; x++;)
-		// Chi
-		FOR5(y, 5, FOR5(x, 1, b[x] = a[y + x];) FOR5(x, 1, a[y + x] = b[x] ^ ((~b[(x + 1) % 5]) & b[(x + 2) % 5]);))
-		// Iota
-		a[0] ^= RC[i];
+#define rol(x, s) (((x) << (s)) | ((x) >> (64 - (s))))
+
+/* One round from the lanes prefixed A into the lanes prefixed E, following the lane-complementing
+   transform of the Keccak team's optimized implementation: with the lanes be, bi, go, ki, mi and
+   sa kept complemented between rounds, chi needs one NOT per plane instead of five. */
+#define KECCAK_ROUND(A, E, i)                                                                      \
+	do {                                                                                           \
+		Ca = A##ba ^ A##ga ^ A##ka ^ A##ma ^ A##sa;                                                \
+		Ce = A##be ^ A##ge ^ A##ke ^ A##me ^ A##se;                                                \
+		Ci = A##bi ^ A##gi ^ A##ki ^ A##mi ^ A##si;                                                \
+		Co = A##bo ^ A##go ^ A##ko ^ A##mo ^ A##so;                                                \
+		Cu = A##bu ^ A##gu ^ A##ku ^ A##mu ^ A##su;                                                \
+		Da = Cu ^ rol(Ce, 1);                                                                      \
+		De = Ca ^ rol(Ci, 1);                                                                      \
+		Di = Ce ^ rol(Co, 1);                                                                      \
+		Do = Ci ^ rol(Cu, 1);                                                                      \
+		Du = Co ^ rol(Ca, 1);                                                                      \
+                                                                                                   \
+		Bba = A##ba ^ Da;                                                                          \
+		Bbe = rol(A##ge ^ De, 44);                                                                 \
+		Bbi = rol(A##ki ^ Di, 43);                                                                 \
+		Bbo = rol(A##mo ^ Do, 21);                                                                 \
+		Bbu = rol(A##su ^ Du, 14);                                                                 \
+		E##ba = Bba ^ (Bbe | Bbi) ^ RC[i];                                                         \
+		E##be = Bbe ^ ((~Bbi) | Bbo);                                                              \
+		E##bi = Bbi ^ (Bbo & Bbu);                                                                 \
+		E##bo = Bbo ^ (Bbu | Bba);                                                                 \
+		E##bu = Bbu ^ (Bba & Bbe);                                                                 \
+                                                                                                   \
+		Bga = rol(A##bo ^ Do, 28);                                                                 \
+		Bge = rol(A##gu ^ Du, 20);                                                                 \
+		Bgi = rol(A##ka ^ Da, 3);                                                                  \
+		Bgo = rol(A##me ^ De, 45);                                                                 \
+		Bgu = rol(A##si ^ Di, 61);                                                                 \
+		E##ga = Bga ^ (Bge | Bgi);                                                                 \
+		E##ge = Bge ^ (Bgi & Bgo);                                                                 \
+		E##gi = Bgi ^ (Bgo | (~Bgu));                                                              \
+		E##go = Bgo ^ (Bgu | Bga);                                                                 \
+		E##gu = Bgu ^ (Bga & Bge);                                                                 \
+                                                                                                   \
+		Bka = rol(A##be ^ De, 1);                                                                  \
+		Bke = rol(A##gi ^ Di, 6);                                                                  \
+		Bki = rol(A##ko ^ Do, 25);                                                                 \
+		Bko = rol(A##mu ^ Du, 8);                                                                  \
+		Bku = rol(A##sa ^ Da, 18);                                                                 \
+		E##ka = Bka ^ (Bke | Bki);                                                                 \
+		E##ke = Bke ^ (Bki & Bko);                                                                 \
+		E##ki = Bki ^ ((~Bko) & Bku);                                                              \
+		E##ko = (~Bko) ^ (Bku | Bka);                                                              \
+		E##ku = Bku ^ (Bka & Bke);                                                                 \
+                                                                                                   \
+		Bma = rol(A##bu ^ Du, 27);                                                                 \
+		Bme = rol(A##ga ^ Da, 36);                                                                 \
+		Bmi = rol(A##ke ^ De, 10);                                                                 \
+		Bmo = rol(A##mi ^ Di, 15);                                                                 \
+		Bmu = rol(A##so ^ Do, 56);                                                                 \
+		E##ma = Bma ^ (Bme & Bmi);                                                                 \
+		E##me = Bme ^ (Bmi | Bmo);                                                                 \
+		E##mi = Bmi ^ ((~Bmo) | Bmu);                                                              \
+		E##mo = (~Bmo) ^ (Bmu & Bma);                                                              \
+		E##mu = Bmu ^ (Bma | Bme);                                                                 \
+                                                                                                   \
+		Bsa = rol(A##bi ^ Di, 62);                                                                 \
+		Bse = rol(A##go ^ Do, 55);                                                                 \
+		Bsi = rol(A##ku ^ Du, 39);                                                                 \
+		Bso = rol(A##ma ^ Da, 41);                                                                 \
+		Bsu = rol(A##se ^ De, 2);                                                                  \
+		E##sa = Bsa ^ ((~Bse) & Bsi);                                                              \
+		E##se = (~Bse) ^ (Bsi | Bso);                                                              \
+		E##si = Bsi ^ (Bso & Bsu);                                                                 \
+		E##so = Bso ^ (Bsu | Bsa);                                                                 \
+		E##su = Bsu ^ (Bsa & Bse);                                                                 \
+	} while (0)
+
+/* Lanes in the order of the state words: x varies fastest, y selects b, g, k, m, s. */
+#define KECCAK_LANES(X, F, w)                                                                      \
+	F(X##ba, 0, w) F(X##be, 1, w) F(X##bi, 2, w) F(X##bo, 3, w) F(X##bu, 4, w) F(X##ga, 5, w)      \
+	F(X##ge, 6, w) F(X##gi, 7, w) F(X##go, 8, w) F(X##gu, 9, w) F(X##ka, 10, w) F(X##ke, 11, w)    \
+	F(X##ki, 12, w) F(X##ko, 13, w) F(X##ku, 14, w) F(X##ma, 15, w) F(X##me, 16, w) F(X##mi, 17, w) \
+	F(X##mo, 18, w) F(X##mu, 19, w) F(X##sa, 20, w) F(X##se, 21, w) F(X##si, 22, w) F(X##so, 23, w) \
+	F(X##su, 24, w)
+
+/* Bit i of this mask marks lane i as complemented. */
+#define KECCAK_COMPLEMENTED ((1u << 1) | (1u << 2) | (1u << 8) | (1u << 12) | (1u << 17) | (1u << 20))
+
+/* A word holds lane i of one or more interleaved states; state stores the words back to back. */
+#define KECCAK_DECLARE(lane, i, word) word lane;
+#define KECCAK_LOAD(lane, i, word)                                                                 \
+	memcpy(&lane, state + (i) * (sizeof(word) / 8), sizeof(word));                                 \
+	if (KECCAK_COMPLEMENTED >> (i) & 1) {                                                          \
+		lane = ~lane;                                                                              \
 	}
-}
+#define KECCAK_STORE(lane, i, word)                                                                \
+	if (KECCAK_COMPLEMENTED >> (i) & 1) {                                                          \
+		lane = ~lane;                                                                              \
+	}                                                                                              \
+	memcpy(state + (i) * (sizeof(word) / 8), &lane, sizeof(word));
+
+/* The body of Keccak-f[1600] on the words of state, all 24 rounds unrolled. */
+#define KECCAK_PERMUTATION(word)                                                                   \
+	word Ca, Ce, Ci, Co, Cu, Da, De, Di, Do, Du;                                                   \
+	KECCAK_LANES(A, KECCAK_DECLARE, word)                                                          \
+	KECCAK_LANES(B, KECCAK_DECLARE, word)                                                          \
+	KECCAK_LANES(E, KECCAK_DECLARE, word)                                                          \
+	KECCAK_LANES(A, KECCAK_LOAD, word)                                                             \
+	KECCAK_ROUND(A, E, 0);                                                                         \
+	KECCAK_ROUND(E, A, 1);                                                                         \
+	KECCAK_ROUND(A, E, 2);                                                                         \
+	KECCAK_ROUND(E, A, 3);                                                                         \
+	KECCAK_ROUND(A, E, 4);                                                                         \
+	KECCAK_ROUND(E, A, 5);                                                                         \
+	KECCAK_ROUND(A, E, 6);                                                                         \
+	KECCAK_ROUND(E, A, 7);                                                                         \
+	KECCAK_ROUND(A, E, 8);                                                                         \
+	KECCAK_ROUND(E, A, 9);                                                                         \
+	KECCAK_ROUND(A, E, 10);                                                                        \
+	KECCAK_ROUND(E, A, 11);                                                                        \
+	KECCAK_ROUND(A, E, 12);                                                                        \
+	KECCAK_ROUND(E, A, 13);                                                                        \
+	KECCAK_ROUND(A, E, 14);                                                                        \
+	KECCAK_ROUND(E, A, 15);                                                                        \
+	KECCAK_ROUND(A, E, 16);                                                                        \
+	KECCAK_ROUND(E, A, 17);                                                                        \
+	KECCAK_ROUND(A, E, 18);                                                                        \
+	KECCAK_ROUND(E, A, 19);                                                                        \
+	KECCAK_ROUND(A, E, 20);                                                                        \
+	KECCAK_ROUND(E, A, 21);                                                                        \
+	KECCAK_ROUND(A, E, 22);                                                                        \
+	KECCAK_ROUND(E, A, 23);                                                                        \
+	KECCAK_LANES(A, KECCAK_STORE, word)
+
+static void keccakf(uint64_t *state) { KECCAK_PERMUTATION(uint64_t) }
+
+/* Several states advance together when the compiler can target the x86-64 vector units, which
+   keccak256_batch() checks for at run time: 4 states per AVX2 register, 8 per AVX-512 one. */
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define KECCAK_SIMD 1
+
+typedef uint64_t keccak_x4 __attribute__((vector_size(32)));
+typedef uint64_t keccak_x8 __attribute__((vector_size(64)));
+
+__attribute__((target("avx2"))) static void keccakf_x4(uint64_t *state) { KECCAK_PERMUTATION(keccak_x4) }
+
+__attribute__((target("avx512f"))) static void keccakf_x8(uint64_t *state) { KECCAK_PERMUTATION(keccak_x8) }
+#else
+#define KECCAK_SIMD 0
+#endif
 
 /******** The FIPS202-defined functions. ********/
 
-/*** Some helper macros. ***/
+#define Plen  200
+#define Lanes 25
 
-#define _(S) \
-	do {     \
-		S    \
-	} while (0)
-#define FOR(i, ST, L, S) _(for (size_t i = 0; i < L; i += ST) { S; })
-#define mkapply_ds(NAME, S) \
-	static inline void NAME(uint8_t *dst, const uint8_t *src, size_t len) { FOR(i, 1, len, S); }
-#define mkapply_sd(NAME, S) \
-	static inline void NAME(const uint8_t *src, uint8_t *dst, size_t len) { FOR(i, 1, len, S); }
-
-mkapply_ds(xorin, dst[i] ^= src[i])		// xorin
-	mkapply_sd(setout, dst[i] = src[i]) // setout
-#define P	 keccakf
-#define Plen 200
-// Fold P*F over the full blocks of an input.
-#define foldP(I, L, F)  \
-	while (L >= rate) { \
-		F(a, I, rate);  \
-		P(a);           \
-		I += rate;      \
-		L -= rate;      \
-	}
-
-	/** The sponge-based hash construction. **/
-	static inline int hash(
-		uint8_t *out, size_t outlen, const uint8_t *in, size_t inlen, size_t rate, uint8_t delim, int opt
-	) {
-
-	if ((out == NULL) || ((in == NULL) && inlen != 0) || (rate >= Plen)) {
+/* Lanes are little-endian; assembling them from bytes compiles to plain loads and stores on
+   little-endian targets and stays correct on big-endian ones. */
+static inline uint64_t load64(const uint8_t *in) {
+	return (uint64_t)in[0] | (uint64_t)in[1] << 8 | (uint64_t)in[2] << 16 | (uint64_t)in[3] << 24 |
+		   (uint64_t)in[4] << 32 | (uint64_t)in[5] << 40 | (uint64_t)in[6] << 48 | (uint64_t)in[7] << 56;
+}
+
+static inline void store64(uint8_t *out, uint64_t lane) {
+	for (int i = 0; i < 8; i++) {
+		out[i] = (uint8_t)(lane >> (8 * i));
+	}
+}
+
+/* XORs len bytes of in into the block at byte *offset, permuting whenever rate bytes have been
+   absorbed, and advances *offset. Whole lanes are loaded as words once the offset is aligned. */
+static void absorb(uint64_t *a, size_t *offset, size_t rate, const uint8_t *in, size_t len) {
+	size_t pos = *offset;
+
+	// Finish a partially filled lane.
+	while (len > 0 && pos % 8 != 0) {
+		a[pos / 8] ^= (uint64_t)*in++ << (8 * (pos % 8));
+		len--;
+		if (++pos == rate) {
+			keccakf(a);
+			pos = 0;
+		}
+	}
+	// Whole blocks straight from the input.
+	while (pos == 0 && len >= rate) {
+		for (size_t i = 0; i < rate / 8; i++) {
+			a[i] ^= load64(in + 8 * i);
+		}
+		keccakf(a);
+		in += rate;
+		len -= rate;
+	}
+	// Whole lanes, then the bytes of a last partial lane, which cannot complete the block.
+	while (len >= 8) {
+		a[pos / 8] ^= load64(in);
+		in += 8;
+		len -= 8;
+		pos += 8;
+		if (pos == rate) {
+			keccakf(a);
+			pos = 0;
+		}
+	}
+	for (; len > 0; len--, pos++) {
+		a[pos / 8] ^= (uint64_t)*in++ << (8 * (pos % 8));
+	}
+	*offset = pos;
+}
+
+/* Xors in the DS and the pad frame after offset absorbed bytes and permutes. */
+static inline void pad(uint64_t *a, size_t offset, size_t rate, uint8_t delim) {
+	a[offset / 8] ^= (uint64_t)delim << (8 * (offset % 8));
+	a[rate / 8 - 1] ^= 0x8000000000000000ULL;
+	keccakf(a);
+}
+
+/* Writes the first len bytes of the state to out. */
+static inline void setout(const uint64_t *a, uint8_t *out, size_t len) {
+	size_t i;
+	for (i = 0; i + 8 <= len; i += 8) {
+		store64(out + i, a[i / 8]);
+	}
+	for (; i < len; i++) {
+		out[i] = (uint8_t)(a[i / 8] >> (8 * (i % 8)));
+	}
+}
+
+/* Clears count words a word at a time; the volatile stores cannot be optimized away. */
+static inline void wipe_words(uint64_t *a, size_t count) {
+	volatile uint64_t *words = a;
+	for (size_t i = 0; i < count; i++) {
+		words[i] = 0;
+	}
+}
+
+static inline void wipe(uint64_t *a) { wipe_words(a, Lanes); }
+
+/** The sponge-based hash construction. **/
+static inline int hash(
+	uint8_t *out, size_t outlen, const uint8_t *in, size_t inlen, size_t rate, uint8_t delim, int opt
+) {
+	uint64_t a[Lanes] = {0};
+	size_t offset	  = 0;
+	(void)opt;
+
+	if ((out == NULL) || ((in == NULL) && inlen != 0) || (rate >= Plen) || (rate % 8 != 0)) {
 		return -1;
 	}
-	uint8_t a[Plen] = {0};
-	// Absorb input.
-	foldP(in, inlen, xorin);
-	// Xor in the DS and pad frame.
-	a[inlen] ^= delim;
-	a[rate - 1] ^= 0x80;
-	// Xor in the last block.
-	xorin(a, in, inlen);
-	// Apply P
-	P(a);
+
+	absorb(a, &offset, rate, in, inlen);
+	pad(a, offset, rate, delim);
+
 	// Squeeze output.
-	foldP(out, outlen, setout);
+	while (outlen >= rate) {
+		setout(a, out, rate);
+		keccakf(a);
+		out += rate;
+		outlen -= rate;
+	}
 	setout(a, out, outlen);
 
-	////////////////////////////////////////////
-	/// modified for ethereum keccak256 - walter
-	// if (opt == 1) {
-	// 	// Ethereum compatibility.
-	// 	// Clear the last block.
-	// 	// memset(a, 0, Plen);
-	// 	// memset_s(a, 200, 0, 200);
-	// 	memset_s(a, 200, 0, 200);
-	// } else {
-	// 	// Clear the whole buffer.
-	// 	// memset_s(a, 200, 0, 200);
-	// 	memset(a, 0, Plen);
-	// 	memset_s(a, 200, 0, 200);
-	// }
-
-	for (size_t i = 0; i < Plen; i++) {
-		a[i] = 0;
-	}
-	///////////////////////////////////////////
-
+	wipe(a);
 	return 0;
 }
 
@@ -156,6 +315,219 @@ int keccak256_raw(uint8_t *out, size_t outlen, const uint8_t *in, size_t inlen,
 	return hash(out, outlen, in, inlen, 200 - (bits / 4), 0x01, opt);
 }
 
+/******** Incremental Keccak-256. ********/
+
+void keccak256_init(keccak256_ctx *ctx) {
+	memset(ctx->state, 0, sizeof(ctx->state));
+	ctx->offset = 0;
+}
+
+void keccak256_update(keccak256_ctx *ctx, const uint8_t *in, size_t inlen) {
+	if (inlen > 0) {
+		absorb(ctx->state, &ctx->offset, KECCAK256_RATE, in, inlen);
+	}
+}
+
+void keccak256_update_gather(keccak256_ctx *ctx, const keccak256_chunk *chunks, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		keccak256_update(ctx, chunks[i].data, chunks[i].size);
+	}
+}
+
+void keccak256_clone(keccak256_ctx *dst, const keccak256_ctx *src) { *dst = *src; }
+
+void keccak256_final(keccak256_ctx *ctx, uint8_t *out) {
+	pad(ctx->state, ctx->offset, KECCAK256_RATE, 0x01);
+	setout(ctx->state, out, 32);
+	wipe(ctx->state);
+	ctx->offset = 0;
+}
+
+void keccak256_gather(uint8_t *out, const keccak256_chunk *chunks, size_t count) {
+	keccak256_ctx ctx;
+	keccak256_init(&ctx);
+	keccak256_update_gather(&ctx, chunks, count);
+	keccak256_final(&ctx, out);
+}
+
+/******** Batched Keccak-256. ********/
+
+unsigned keccak256_batch_lanes(void) {
+#if KECCAK_SIMD
+	if (__builtin_cpu_supports("avx512f")) {
+		return 8;
+	}
+	if (__builtin_cpu_supports("avx2")) {
+		return 4;
+	}
+#endif
+	return 1;
+}
+
+/* XORs the next block of a message into the lane-th of the width states interleaved in state,
+   padding it if it is the last one. Returns 1 once the message is fully absorbed. */
+static int batch_absorb_block(uint64_t *state, unsigned width, unsigned lane, const uint8_t *in, size_t remaining) {
+	uint64_t block[KECCAK256_RATE / 8] = {0};
+	size_t offset = 0;
+	int last	  = remaining < KECCAK256_RATE;
+
+	if (last) {
+		absorb(block, &offset, KECCAK256_RATE, in, remaining);
+		block[offset / 8] ^= (uint64_t)0x01 << (8 * (offset % 8));
+		block[KECCAK256_RATE / 8 - 1] ^= 0x8000000000000000ULL;
+	} else {
+		for (size_t i = 0; i < KECCAK256_RATE / 8; i++) {
+			block[i] = load64(in + 8 * i);
+		}
+	}
+	for (size_t i = 0; i < KECCAK256_RATE / 8; i++) {
+		state[i * width + lane] ^= block[i];
+	}
+	return last;
+}
+
+/* Hashes the messages width at a time. A lane whose message is done takes the next one, so
+   messages of mixed lengths keep every lane busy. */
+static void keccak256_batch_interleaved(
+	uint8_t *out,
+	const uint8_t *const *inputs,
+	const size_t *sizes,
+	size_t count,
+	unsigned width,
+	void (*permute)(uint64_t *)
+) {
+	uint64_t state[Lanes * KECCAK256_BATCH_MAX_LANES] = {0};
+	size_t message[KECCAK256_BATCH_MAX_LANES];
+	size_t absorbed[KECCAK256_BATCH_MAX_LANES] = {0};
+	int done[KECCAK256_BATCH_MAX_LANES];
+	size_t next = 0, active = 0;
+	unsigned l;
+
+	for (l = 0; l < width; l++) {
+		message[l] = next < count ? next++ : SIZE_MAX;
+		active += message[l] != SIZE_MAX;
+	}
+	while (active > 0) {
+		for (l = 0; l < width; l++) {
+			size_t m = message[l];
+			if (m != SIZE_MAX) {
+				done[l] = batch_absorb_block(state, width, l, inputs[m] + absorbed[l], sizes[m] - absorbed[l]);
+				absorbed[l] += KECCAK256_RATE;
+			}
+		}
+		permute(state);
+		for (l = 0; l < width; l++) {
+			size_t m = message[l];
+			if (m == SIZE_MAX || !done[l]) {
+				continue;
+			}
+			for (size_t i = 0; i < 4; i++) {
+				store64(out + 32 * m + 8 * i, state[i * width + l]);
+			}
+			for (size_t i = 0; i < Lanes; i++) {
+				state[i * width + l] = 0;
+			}
+			absorbed[l] = 0;
+			if (next < count) {
+				message[l] = next++;
+			} else {
+				message[l] = SIZE_MAX;
+				active--;
+			}
+		}
+	}
+	wipe_words(state, sizeof(state) / 8);
+}
+
+void keccak256_batch_width(
+	uint8_t *out, const uint8_t *const *inputs, const size_t *sizes, size_t count, unsigned lanes
+) {
+	unsigned available = keccak256_batch_lanes();
+#if KECCAK_SIMD
+	if (lanes >= 8 && available >= 8) {
+		keccak256_batch_interleaved(out, inputs, sizes, count, 8, keccakf_x8);
+		return;
+	}
+	if (lanes >= 4 && available >= 4) {
+		keccak256_batch_interleaved(out, inputs, sizes, count, 4, keccakf_x4);
+		return;
+	}
+#else
+	(void)lanes;
+	(void)available;
+#endif
+	for (size_t i = 0; i < count; i++) {
+		keccak256_raw(out + 32 * i, 32, inputs[i], sizes[i], 1, 256);
+	}
+}
+
+void keccak256_batch(uint8_t *out, const uint8_t *const *inputs, const size_t *sizes, size_t count) {
+	keccak256_batch_width(out, inputs, sizes, count, KECCAK256_BATCH_MAX_LANES);
+}
+
+/* Hashes the variants of the padded block width at a time. */
+static void keccak256_variants_interleaved(
+	uint8_t *out,
+	const uint64_t *block,
+	unsigned word,
+	const uint64_t *values,
+	size_t count,
+	unsigned width,
+	void (*permute)(uint64_t *)
+) {
+	uint64_t state[Lanes * KECCAK256_BATCH_MAX_LANES];
+	size_t done, i;
+	unsigned l, n;
+
+	for (done = 0; done < count; done += n) {
+		n = count - done < width ? (unsigned)(count - done) : width;
+		for (i = 0; i < Lanes; i++) {
+			for (l = 0; l < width; l++) {
+				state[i * width + l] = i < KECCAK256_RATE / 8 ? block[i] : 0;
+			}
+		}
+		for (l = 0; l < n; l++) {
+			state[word * width + l] = values[done + l];
+		}
+		permute(state);
+		for (l = 0; l < n; l++) {
+			for (i = 0; i < 4; i++) {
+				store64(out + 32 * (done + l) + 8 * i, state[i * width + l]);
+			}
+		}
+	}
+	wipe_words(state, sizeof(state) / 8);
+}
+
+int keccak256_batch_variants(
+	uint8_t *out, const uint8_t *message, size_t size, unsigned word, const uint64_t *values, size_t count
+) {
+	uint64_t block[KECCAK256_RATE / 8] = {0};
+	size_t offset					   = 0;
+	unsigned lanes					   = keccak256_batch_lanes();
+
+	if (size >= KECCAK256_RATE || 8 * (size_t)word + 8 > size) {
+		return 0;
+	}
+	absorb(block, &offset, KECCAK256_RATE, message, size);
+	block[offset / 8] ^= (uint64_t)0x01 << (8 * (offset % 8));
+	block[KECCAK256_RATE / 8 - 1] ^= 0x8000000000000000ULL;
+#if KECCAK_SIMD
+	if (lanes >= 8) {
+		keccak256_variants_interleaved(out, block, word, values, count, 8, keccakf_x8);
+		return 1;
+	}
+	if (lanes >= 4) {
+		keccak256_variants_interleaved(out, block, word, values, count, 4, keccakf_x4);
+		return 1;
+	}
+#else
+	(void)lanes;
+#endif
+	keccak256_variants_interleaved(out, block, word, values, count, 1, keccakf);
+	return 1;
+}
+
 int funinthesun() { return 0; }
 
 int sub(int a, int b) { return a - b; }
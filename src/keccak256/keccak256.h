@@ -23,4 +23,62 @@
 
 int keccak256_raw(uint8_t *out, size_t outlen, const uint8_t *in, size_t inlen, int opt, int bits);
 
+/* Bytes absorbed per Keccak-f[1600] call by Keccak-256. */
+#define KECCAK256_RATE 136
+
+/* A partially absorbed Keccak-256 sponge. The context holds no pointers, so copying it (or
+   keccak256_clone()) snapshots a midstate: absorb a shared prefix once, then finish any number of
+   messages from copies. */
+typedef struct {
+	uint64_t state[25];
+	size_t offset; /* bytes absorbed into the current block */
+} keccak256_ctx;
+
+/* One piece of a scatter/gather input. */
+typedef struct {
+	const uint8_t *data;
+	size_t size;
+} keccak256_chunk;
+
+void keccak256_init(keccak256_ctx *ctx);
+
+/* Absorbs inlen bytes of in. Splitting the input across calls does not change the digest. */
+void keccak256_update(keccak256_ctx *ctx, const uint8_t *in, size_t inlen);
+
+/* Absorbs the chunks in order, as if they had been concatenated. */
+void keccak256_update_gather(keccak256_ctx *ctx, const keccak256_chunk *chunks, size_t count);
+
+void keccak256_clone(keccak256_ctx *dst, const keccak256_ctx *src);
+
+/* Writes the 32-byte digest to out and wipes ctx, which must be initialized again before reuse. */
+void keccak256_final(keccak256_ctx *ctx, uint8_t *out);
+
+/* One-shot Keccak-256 of the concatenation of count chunks, without building it in memory. */
+void keccak256_gather(uint8_t *out, const keccak256_chunk *chunks, size_t count);
+
+/* Most messages keccak256_batch() hashes side by side. */
+#define KECCAK256_BATCH_MAX_LANES 8
+
+/* Number of messages this CPU hashes side by side: 8 with AVX-512, 4 with AVX2, otherwise 1. */
+unsigned keccak256_batch_lanes(void);
+
+/* Keccak-256 of count independent messages of any lengths, written back to back as 32-byte
+   digests to out. Messages share SIMD registers when keccak256_batch_lanes() is above 1 and are
+   hashed one by one otherwise. */
+void keccak256_batch(uint8_t *out, const uint8_t *const *inputs, const size_t *sizes, size_t count);
+
+/* Same as keccak256_batch(), using at most lanes lanes (1, 4 or 8). */
+void keccak256_batch_width(
+	uint8_t *out, const uint8_t *const *inputs, const size_t *sizes, size_t count, unsigned lanes
+);
+
+/* Keccak-256 of count variants of a message shorter than KECCAK256_RATE bytes, written back to
+   back as 32-byte digests to out. Variant i has the 8 bytes at offset 8 * word replaced by the
+   little-endian values[i]. The message is padded once and every variant costs one permutation,
+   variants sharing SIMD registers as in keccak256_batch(). Returns 1 on success, 0 if the message
+   is too long or the replaced bytes do not lie inside it. */
+int keccak256_batch_variants(
+	uint8_t *out, const uint8_t *message, size_t size, unsigned word, const uint64_t *values, size_t count
+);
+
 #endif /* keccak256_h */
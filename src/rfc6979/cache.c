@@ -0,0 +1,118 @@
+//
+//  cache.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#include "cache.h"
+#include "../hmac/hash.h"
+
+#include <string.h>
+
+/* What a signature is cached under. */
+typedef struct {
+	uint64_t key_handle;
+	uECC_Curve curve;
+	const uint8_t *message_hash;
+} sign_cache_key;
+
+static uint64_t sign_cache_hash(uint64_t key_handle, const uint8_t *message_hash) {
+	uint64_t h = key_handle * 0x9E3779B97F4A7C15ull;
+	uint64_t w;
+	int i;
+	for (i = 0; i < 32; i += 8) {
+		memcpy(&w, message_hash + i, 8);
+		h ^= w;
+		h *= 0xFF51AFD7ED558CCDull;
+		h ^= h >> 33;
+	}
+	return h;
+}
+
+static int sign_cache_match(const void *entry, const void *key) {
+	const sign_cache_entry *e = (const sign_cache_entry *)entry;
+	const sign_cache_key *k	  = (const sign_cache_key *)key;
+	return e->key_handle == k->key_handle && e->curve == k->curve && memcmp(e->message_hash, k->message_hash, 32) == 0;
+}
+
+static void sign_cache_wipe(void *entry) {
+	sign_cache_entry *e = (sign_cache_entry *)entry;
+	secp256k1_memclear(&e->key_handle, sizeof(e->key_handle));
+	e->curve = NULL;
+	secp256k1_memclear(e->message_hash, sizeof(e->message_hash));
+	secp256k1_memclear(e->signature, sizeof(e->signature));
+	e->recid = 0;
+}
+
+int sign_cache_init(sign_cache *cache, sign_cache_entry *entries, size_t capacity) {
+	return lru_init(&cache->lru, entries, sizeof(*entries), capacity, sign_cache_wipe);
+}
+
+void sign_cache_destroy(sign_cache *cache) {
+	lru_destroy(&cache->lru);
+}
+
+void sign_cache_clear(sign_cache *cache) {
+	lru_clear(&cache->lru);
+}
+
+void sign_cache_stats(const sign_cache *cache, uint64_t *hits, uint64_t *misses, uint64_t *evictions) {
+	lru_stats(&cache->lru, hits, misses, evictions);
+}
+
+int sign_rfc6979_cached(
+	sign_cache *cache,
+	uint64_t key_handle,
+	const uint8_t *private_key,
+	const uint8_t *message_hash,
+	unsigned hash_size,
+	uint8_t *recid,
+	uint8_t *signature,
+	uECC_Curve curve
+) {
+	sign_cache_key key = {key_handle, curve, message_hash};
+	sign_cache_entry *entry;
+	lru_shard *shard;
+	uint64_t h;
+	uint8_t rec;
+
+	if (hash_size != 32) {
+		return sign_rfc6979(private_key, message_hash, hash_size, recid, signature, curve);
+	}
+
+	h	  = sign_cache_hash(key_handle, message_hash);
+	shard = lru_shard_for(&cache->lru, h);
+
+	pthread_mutex_lock(&shard->lock);
+	entry = (sign_cache_entry *)lru_get(shard, h, sign_cache_match, &key);
+	if (entry) {
+		memcpy(signature, entry->signature, 64);
+		if (recid) {
+			*recid = entry->recid;
+		}
+		pthread_mutex_unlock(&shard->lock);
+		return 1;
+	}
+	pthread_mutex_unlock(&shard->lock);
+
+	/* Sign without holding the lock; a concurrent miss on the same pair computes the same value. */
+	if (!sign_rfc6979(private_key, message_hash, hash_size, &rec, signature, curve)) {
+		return 0;
+	}
+	if (recid) {
+		*recid = rec;
+	}
+
+	pthread_mutex_lock(&shard->lock);
+	entry = (sign_cache_entry *)lru_put(shard, h, sign_cache_match, &key);
+	if (entry) {
+		entry->key_handle = key_handle;
+		entry->curve	  = curve;
+		memcpy(entry->message_hash, message_hash, 32);
+		memcpy(entry->signature, signature, 64);
+		entry->recid = rec;
+	}
+	pthread_mutex_unlock(&shard->lock);
+	return 1;
+}
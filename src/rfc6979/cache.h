@@ -0,0 +1,66 @@
+//
+//  cache.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#ifndef cache_h
+#define cache_h
+
+#include "lru.h"
+#include "sign.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Number of independently locked shards. */
+#define SIGN_CACHE_SHARDS LRU_SHARDS
+
+/* One cached signature. Entries are owned by the caller, as lru.h describes. */
+typedef struct {
+	lru_links links;
+	uint64_t key_handle;
+	uECC_Curve curve;
+	uint8_t message_hash[32];
+	uint8_t signature[64];
+	uint8_t recid;
+} sign_cache_entry;
+
+typedef struct {
+	lru_cache lru;
+} sign_cache;
+
+/* Sets up cache over capacity caller-provided entries, split evenly across the shards.
+   capacity must be at least SIGN_CACHE_SHARDS. Returns 1 on success, 0 otherwise. */
+int sign_cache_init(sign_cache *cache, sign_cache_entry *entries, size_t capacity);
+
+/* Wipes every entry and releases the shard locks. The entries may be freed afterwards. */
+void sign_cache_destroy(sign_cache *cache);
+
+/* Wipes every entry, keeping the counters. */
+void sign_cache_clear(sign_cache *cache);
+
+/* Sums the counters of all shards. Any output may be NULL. */
+void sign_cache_stats(const sign_cache *cache, uint64_t *hits, uint64_t *misses, uint64_t *evictions);
+
+/* Same as sign_rfc6979(), answering repeated requests from cache.
+
+   RFC 6979 signatures are a pure function of the key and the message hash, so a signature is
+   cached under (key_handle, curve, message_hash) and returned as is when the same key signs the
+   same hash again on the same curve. key_handle is any value the caller uses to name
+   private_key; it must never name two different keys over the lifetime of the cache. The private
+   key itself is never stored. Hashes that are not 32 bytes long bypass the cache. cache may be
+   shared between threads. */
+int sign_rfc6979_cached(
+	sign_cache *cache,
+	uint64_t key_handle,
+	const uint8_t *private_key,
+	const uint8_t *message_hash,
+	unsigned hash_size,
+	uint8_t *recid,
+	uint8_t *signature,
+	uECC_Curve curve
+);
+
+#endif /* cache_h */
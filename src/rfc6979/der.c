@@ -0,0 +1,252 @@
+//
+//  der.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+// ---------------------------------------------------------------------
+//  adapted from bitcoin-core/secp256k1
+//  Copyright © 2013 Pieter Wuille. MIT software license
+// ---------------------------------------------------------------------
+
+#include "der.h"
+
+#include <string.h>
+
+/* Writes the minimal DER INTEGER for the big-endian value of size bytes at der + *pos. */
+static void der_put_integer(uint8_t *der, size_t *pos, const uint8_t *value, size_t size) {
+	while (size > 1 && value[0] == 0) {
+		++value;
+		--size;
+	}
+	der[(*pos)++] = 0x02;
+	if (value[0] & 0x80) {
+		der[(*pos)++] = (uint8_t)(size + 1);
+		der[(*pos)++] = 0x00;
+	} else {
+		der[(*pos)++] = (uint8_t)size;
+	}
+	memcpy(der + *pos, value, size);
+	*pos += size;
+}
+
+/* Size of der_put_integer()'s output, excluding the tag and length bytes. */
+static size_t der_integer_size(const uint8_t *value, size_t size) {
+	while (size > 1 && value[0] == 0) {
+		++value;
+		--size;
+	}
+	return size + ((value[0] & 0x80) ? 1 : 0);
+}
+
+int signature_der_encode(uint8_t *der, size_t *der_size, const uint8_t *signature, uECC_Curve curve) {
+	size_t num_bytes = (size_t)curve->num_bytes;
+	size_t rlen		 = der_integer_size(signature, num_bytes);
+	size_t slen		 = der_integer_size(signature + num_bytes, num_bytes);
+	size_t total	 = 6 + rlen + slen;
+	size_t pos		 = 0;
+
+	if (*der_size < total) {
+		return 0;
+	}
+	der[pos++] = 0x30;
+	der[pos++] = (uint8_t)(4 + rlen + slen);
+	der_put_integer(der, &pos, signature, num_bytes);
+	der_put_integer(der, &pos, signature + num_bytes, num_bytes);
+	*der_size = pos;
+	return 1;
+}
+
+/* Reads a strict DER INTEGER at der + *pos into the num_bytes big-endian out. */
+static int der_get_integer_strict(uint8_t *out, size_t num_bytes, const uint8_t *der, size_t der_size, size_t *pos) {
+	size_t len;
+
+	if (der_size - *pos < 2 || der[*pos] != 0x02) {
+		return 0;
+	}
+	len = der[*pos + 1];
+	*pos += 2;
+	if (len == 0 || len >= 0x80 || len > der_size - *pos) {
+		return 0;
+	}
+	if (der[*pos] & 0x80) {
+		return 0; /* negative */
+	}
+	if (len > 1 && der[*pos] == 0 && !(der[*pos + 1] & 0x80)) {
+		return 0; /* leading zero that is not needed for the sign */
+	}
+	if (der[*pos] == 0 && len > 1) {
+		++*pos;
+		--len;
+	}
+	if (len > num_bytes) {
+		return 0;
+	}
+	memset(out, 0, num_bytes - len);
+	memcpy(out + num_bytes - len, der + *pos, len);
+	*pos += len;
+	return 1;
+}
+
+int signature_der_decode_strict(uint8_t *signature, const uint8_t *der, size_t der_size, uECC_Curve curve) {
+	size_t num_bytes = (size_t)curve->num_bytes;
+	size_t pos		 = 2;
+
+	if (der_size < 2 || der[0] != 0x30 || der[1] >= 0x80 || (size_t)der[1] != der_size - 2) {
+		return 0;
+	}
+	if (!der_get_integer_strict(signature, num_bytes, der, der_size, &pos) ||
+		!der_get_integer_strict(signature + num_bytes, num_bytes, der, der_size, &pos)) {
+		return 0;
+	}
+	return pos == der_size;
+}
+
+/* Reads the length of a lax DER INTEGER at der + *pos. */
+static int der_get_length_lax(size_t *len, const uint8_t *der, size_t der_size, size_t *pos) {
+	size_t lenbyte;
+
+	if (*pos == der_size) {
+		return 0;
+	}
+	lenbyte = der[(*pos)++];
+	if (!(lenbyte & 0x80)) {
+		*len = lenbyte;
+		return 1;
+	}
+	lenbyte -= 0x80;
+	if (lenbyte > der_size - *pos) {
+		return 0;
+	}
+	while (lenbyte > 0 && der[*pos] == 0) {
+		++*pos;
+		--lenbyte;
+	}
+	if (lenbyte >= sizeof(size_t)) {
+		return 0;
+	}
+	*len = 0;
+	while (lenbyte > 0) {
+		*len = (*len << 8) + der[(*pos)++];
+		--lenbyte;
+	}
+	return 1;
+}
+
+int signature_der_decode_lax(uint8_t *signature, const uint8_t *der, size_t der_size, uECC_Curve curve) {
+	size_t num_bytes = (size_t)curve->num_bytes;
+	size_t pos		 = 0;
+	size_t rpos, rlen, spos, slen, lenbyte;
+	int overflow = 0;
+
+	memset(signature, 0, 2 * num_bytes);
+
+	/* Sequence tag byte */
+	if (pos == der_size || der[pos] != 0x30) {
+		return 0;
+	}
+	++pos;
+
+	/* Sequence length bytes; the value itself is ignored */
+	if (pos == der_size) {
+		return 0;
+	}
+	lenbyte = der[pos++];
+	if (lenbyte & 0x80) {
+		lenbyte -= 0x80;
+		if (lenbyte > der_size - pos) {
+			return 0;
+		}
+		pos += lenbyte;
+	}
+
+	/* Integer tag and length for R */
+	if (pos == der_size || der[pos] != 0x02) {
+		return 0;
+	}
+	++pos;
+	if (!der_get_length_lax(&rlen, der, der_size, &pos) || rlen > der_size - pos) {
+		return 0;
+	}
+	rpos = pos;
+	pos += rlen;
+
+	/* Integer tag and length for S */
+	if (pos == der_size || der[pos] != 0x02) {
+		return 0;
+	}
+	++pos;
+	if (!der_get_length_lax(&slen, der, der_size, &pos) || slen > der_size - pos) {
+		return 0;
+	}
+	spos = pos;
+
+	/* Ignore leading zeroes */
+	while (rlen > 0 && der[rpos] == 0) {
+		--rlen;
+		++rpos;
+	}
+	while (slen > 0 && der[spos] == 0) {
+		--slen;
+		++spos;
+	}
+
+	if (rlen > num_bytes || slen > num_bytes) {
+		overflow = 1;
+	}
+	if (!overflow) {
+		memcpy(signature + num_bytes - rlen, der + rpos, rlen);
+		memcpy(signature + 2 * num_bytes - slen, der + spos, slen);
+	}
+	return 1;
+}
+
+int signature_is_low_s(const uint8_t *signature, uECC_Curve curve) {
+	uECC_word_t s[uECC_MAX_WORDS];
+	uECC_word_t half[uECC_MAX_WORDS];
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+	s[num_n_words - 1] = 0;
+	uECC_vli_bytesToNative(s, signature + curve->num_bytes, curve->num_bytes);
+	uECC_vli_set(half, curve->n, num_n_words);
+	uECC_vli_rshift1(half, num_n_words);
+	return uECC_vli_cmp_unsafe(s, half, num_n_words) != 1;
+}
+
+int signature_normalize_s(uint8_t *signature, uint8_t *recid, uECC_Curve curve) {
+	uECC_word_t s[uECC_MAX_WORDS];
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+	if (signature_is_low_s(signature, curve)) {
+		return 0;
+	}
+	s[num_n_words - 1] = 0;
+	uECC_vli_bytesToNative(s, signature + curve->num_bytes, curve->num_bytes);
+	if (uECC_vli_cmp_unsafe(curve->n, s, num_n_words) != 1) {
+		return 0; /* s >= n is no valid s at all */
+	}
+	uECC_vli_sub(s, curve->n, s, num_n_words);
+	uECC_vli_nativeToBytes(signature + curve->num_bytes, curve->num_bytes, s);
+	if (recid) {
+		*recid ^= 1;
+	}
+	return 1;
+}
+
+int signature_compact_encode(uint8_t *compact, const uint8_t *signature, uint8_t recid, uECC_Curve curve) {
+	if (recid > 1 || !signature_is_low_s(signature, curve)) {
+		return 0;
+	}
+	memmove(compact, signature, 2 * (size_t)curve->num_bytes);
+	compact[curve->num_bytes] |= (uint8_t)(recid << 7);
+	return 1;
+}
+
+void signature_compact_decode(uint8_t *signature, uint8_t *recid, const uint8_t *compact, uECC_Curve curve) {
+	uint8_t parity = compact[curve->num_bytes] >> 7;
+
+	memmove(signature, compact, 2 * (size_t)curve->num_bytes);
+	signature[curve->num_bytes] &= 0x7f;
+	if (recid) {
+		*recid = parity;
+	}
+}
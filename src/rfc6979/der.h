@@ -0,0 +1,57 @@
+//
+//  der.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+// ---------------------------------------------------------------------
+//  adapted from bitcoin-core/secp256k1
+//  Copyright © 2013 Pieter Wuille. MIT software license
+// ---------------------------------------------------------------------
+
+#ifndef der_h
+#define der_h
+
+#include "../ecc/core.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Largest DER signature for a curve of num_bytes bytes: SEQUENCE of two INTEGERs, each with a
+   possible leading zero. 72 bytes for secp256k1. */
+#define SIGNATURE_DER_MAX_SIZE(num_bytes) (6 + 2 * ((num_bytes) + 1))
+
+/* All functions below work on the raw r || s signatures of uECC_sign_with_k() (2 * curve size
+   bytes) and on caller buffers only. */
+
+/* Encodes signature as a strict DER SEQUENCE { INTEGER r, INTEGER s } into der. On entry
+   *der_size is the size of der, on return the number of bytes written. Returns 1 on success, 0 if
+   der is too small. */
+int signature_der_encode(uint8_t *der, size_t *der_size, const uint8_t *signature, uECC_Curve curve);
+
+/* Decodes a strict DER signature: definite short-form lengths, minimally encoded non-negative
+   integers no longer than the curve size, and no trailing bytes. Returns 1 on success, 0 if der is
+   not strictly encoded. r and s are not range checked; verification rejects them. */
+int signature_der_decode_strict(uint8_t *signature, const uint8_t *der, size_t der_size, uECC_Curve curve);
+
+/* Decodes a DER signature as leniently as historic OpenSSL-based parsers did: long-form and
+   padded lengths, superfluous leading zeros, negative integers and trailing bytes are tolerated.
+   Integers too long for the curve produce an all-zero signature, which never verifies, rather than
+   an error. Returns 0 only if der cannot be parsed at all. */
+int signature_der_decode_lax(uint8_t *signature, const uint8_t *der, size_t der_size, uECC_Curve curve);
+
+/* Returns 1 if s is at most n / 2, 0 otherwise. */
+int signature_is_low_s(const uint8_t *signature, uECC_Curve curve);
+
+/* Replaces a high s by n - s, the other valid s for the same r. If recid is not NULL its parity
+   bit is flipped with it, since the change negates R. Returns 1 if signature was changed, 0 if s
+   was already low or is not below n. */
+int signature_normalize_s(uint8_t *signature, uint8_t *recid, uECC_Curve curve);
+
+/* Encodes signature and recid in the EIP-2098 compact form r || (recid << 255 | s). s must be low
+   and recid 0 or 1. Returns 1 on success, 0 otherwise. */
+int signature_compact_encode(uint8_t *compact, const uint8_t *signature, uint8_t recid, uECC_Curve curve);
+
+/* Splits an EIP-2098 compact signature into signature and recid. */
+void signature_compact_decode(uint8_t *signature, uint8_t *recid, const uint8_t *compact, uECC_Curve curve);
+
+#endif /* der_h */
@@ -0,0 +1,152 @@
+//
+//  key_cache.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#include "key_cache.h"
+
+#include <string.h>
+
+static uint64_t key_cache_hash(const uint8_t *key, unsigned key_size) {
+	uint64_t h = 0x9E3779B97F4A7C15ull ^ key_size;
+	uint64_t w;
+	unsigned i;
+	for (i = 0; i + 8 <= key_size; i += 8) {
+		memcpy(&w, key + i, 8);
+		h ^= w;
+		h *= 0xFF51AFD7ED558CCDull;
+		h ^= h >> 33;
+	}
+	for (; i < key_size; ++i) {
+		h ^= key[i];
+		h *= 0xFF51AFD7ED558CCDull;
+	}
+	h ^= h >> 33;
+	return h;
+}
+
+/* What a key is cached under: its serialized form. */
+typedef struct {
+	const uint8_t *key;
+	unsigned key_size;
+} key_cache_key;
+
+static int key_cache_match(const void *entry, const void *key) {
+	const key_cache_entry *e = (const key_cache_entry *)entry;
+	const key_cache_key *k	 = (const key_cache_key *)key;
+	return e->key_size == k->key_size && memcmp(e->key, k->key, k->key_size) == 0;
+}
+
+static void key_cache_wipe(void *entry) {
+	((key_cache_entry *)entry)->key_size = 0;
+}
+
+int key_cache_init(key_cache *cache, key_cache_entry *entries, size_t capacity, uECC_Curve curve) {
+	cache->curve = curve;
+	return lru_init(&cache->lru, entries, sizeof(*entries), capacity, key_cache_wipe);
+}
+
+void key_cache_destroy(key_cache *cache) {
+	lru_destroy(&cache->lru);
+}
+
+void key_cache_clear(key_cache *cache) {
+	lru_clear(&cache->lru);
+}
+
+void key_cache_stats(const key_cache *cache, uint64_t *hits, uint64_t *misses, uint64_t *evictions) {
+	lru_stats(&cache->lru, hits, misses, evictions);
+}
+
+/* Decompresses or converts public_key and validates it. Returns 1 if it is a valid point. */
+static int key_cache_parse(const uint8_t *public_key, unsigned key_size, uECC_word_t *point, uECC_Curve curve) {
+	uint8_t raw[uECC_MAX_WORDS * 2 * uECC_WORD_SIZE];
+	const uint8_t *xy = public_key;
+
+	if (key_size == (unsigned)curve->num_bytes + 1) {
+		/* uECC_decompress() already proves the point is on the curve. */
+		if (!uECC_decompress(public_key, raw, curve)) {
+			return 0;
+		}
+		xy = raw;
+	} else if (key_size != 2 * (unsigned)curve->num_bytes) {
+		return 0;
+	}
+
+	uECC_vli_bytesToNative(point, xy, curve->num_bytes);
+	uECC_vli_bytesToNative(point + curve->num_words, xy + curve->num_bytes, curve->num_bytes);
+	if (xy == public_key && !uECC_valid_point(point, curve)) {
+		return 0;
+	}
+	return 1;
+}
+
+int key_cache_lookup(
+	key_cache *cache, const uint8_t *public_key, unsigned key_size, uECC_word_t *point, uECC_word_t *point_plus_G
+) {
+	key_cache_key key	  = {public_key, key_size};
+	uECC_Curve curve	  = cache->curve;
+	wordcount_t num_words = curve->num_words;
+	key_cache_entry *entry;
+	lru_shard *shard;
+	uECC_word_t sum[uECC_MAX_WORDS * 2];
+	uint64_t h;
+
+	if (key_size > sizeof(entry->key)) {
+		return 0;
+	}
+
+	h	  = key_cache_hash(public_key, key_size);
+	shard = lru_shard_for(&cache->lru, h);
+
+	pthread_mutex_lock(&shard->lock);
+	entry = (key_cache_entry *)lru_get(shard, h, key_cache_match, &key);
+	if (entry) {
+		uECC_vli_set(point, entry->point, num_words * 2);
+		if (point_plus_G) {
+			uECC_vli_set(point_plus_G, entry->point_plus_G, num_words * 2);
+		}
+		pthread_mutex_unlock(&shard->lock);
+		return 1;
+	}
+	pthread_mutex_unlock(&shard->lock);
+
+	/* Parse without holding the lock; a concurrent miss on the same key computes the same value. */
+	if (!key_cache_parse(public_key, key_size, point, curve)) {
+		return 0;
+	}
+	EccPoint_add_G(sum, point, curve);
+	if (point_plus_G) {
+		uECC_vli_set(point_plus_G, sum, num_words * 2);
+	}
+
+	pthread_mutex_lock(&shard->lock);
+	entry = (key_cache_entry *)lru_put(shard, h, key_cache_match, &key);
+	if (entry) {
+		memcpy(entry->key, public_key, key_size);
+		entry->key_size = (uint8_t)key_size;
+		uECC_vli_set(entry->point, point, num_words * 2);
+		uECC_vli_set(entry->point_plus_G, sum, num_words * 2);
+	}
+	pthread_mutex_unlock(&shard->lock);
+	return 1;
+}
+
+int verify_rfc6979_key_cached(
+	key_cache *cache,
+	const uint8_t *public_key,
+	unsigned key_size,
+	const uint8_t *message_hash,
+	unsigned hash_size,
+	const uint8_t *signature
+) {
+	uECC_word_t point[uECC_MAX_WORDS * 2];
+	uECC_word_t point_plus_G[uECC_MAX_WORDS * 2];
+
+	if (!key_cache_lookup(cache, public_key, key_size, point, point_plus_G)) {
+		return 0;
+	}
+	return uECC_verify_native(point, point_plus_G, message_hash, hash_size, signature, cache->curve);
+}
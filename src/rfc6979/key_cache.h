@@ -0,0 +1,65 @@
+//
+//  key_cache.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#ifndef key_cache_h
+#define key_cache_h
+
+#include "lru.h"
+#include "verify.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Number of independently locked shards. */
+#define KEY_CACHE_SHARDS LRU_SHARDS
+
+/* One parsed public key. Entries are owned by the caller, as lru.h describes. */
+typedef struct {
+	lru_links links;
+	uint8_t key[64]; /* serialized key as passed in, compressed (33 bytes) or raw x || y (64 bytes) */
+	uint8_t key_size;
+	uECC_word_t point[uECC_MAX_WORDS * 2];		  /* validated native point */
+	uECC_word_t point_plus_G[uECC_MAX_WORDS * 2]; /* affine point + G, for uECC_verify_native() */
+} key_cache_entry;
+
+typedef struct {
+	lru_cache lru;
+	uECC_Curve curve;
+} key_cache;
+
+/* Sets up cache for keys on curve over capacity caller-provided entries, split evenly across the
+   shards. capacity must be at least KEY_CACHE_SHARDS. Returns 1 on success, 0 otherwise. */
+int key_cache_init(key_cache *cache, key_cache_entry *entries, size_t capacity, uECC_Curve curve);
+
+/* Drops every entry and releases the shard locks. The entries may be freed afterwards. */
+void key_cache_destroy(key_cache *cache);
+
+/* Drops every entry, keeping the counters. */
+void key_cache_clear(key_cache *cache);
+
+/* Sums the counters of all shards. Any output may be NULL. */
+void key_cache_stats(const key_cache *cache, uint64_t *hits, uint64_t *misses, uint64_t *evictions);
+
+/* Parses public_key, either compressed (curve size + 1 bytes) or raw x || y (2 * curve size bytes),
+   into point and, if point_plus_G is not NULL, the affine point + G. Keys seen before are served
+   from cache without decompressing or validating them again. Invalid keys are never cached.
+   Returns 1 if the key is valid, 0 otherwise. cache may be shared between threads. */
+int key_cache_lookup(
+	key_cache *cache, const uint8_t *public_key, unsigned key_size, uECC_word_t *point, uECC_word_t *point_plus_G
+);
+
+/* Same as verify_rfc6979(), taking the key through cache. public_key may be compressed. */
+int verify_rfc6979_key_cached(
+	key_cache *cache,
+	const uint8_t *public_key,
+	unsigned key_size,
+	const uint8_t *message_hash,
+	unsigned hash_size,
+	const uint8_t *signature
+);
+
+#endif /* key_cache_h */
@@ -0,0 +1,196 @@
+//
+//  lru.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#include "lru.h"
+
+static lru_links *lru_entry(const lru_shard *shard, uint32_t i) {
+	return (lru_links *)(shard->entries + (size_t)i * shard->entry_size);
+}
+
+static uint32_t lru_bucket(const lru_shard *shard, uint64_t hash) {
+	return (uint32_t)((hash >> 32) % shard->capacity);
+}
+
+static uint32_t lru_find(const lru_shard *shard, uint64_t hash, lru_match match, const void *key) {
+	uint32_t i = lru_entry(shard, lru_bucket(shard, hash))->bucket;
+	while (i != LRU_NONE) {
+		const lru_links *entry = lru_entry(shard, i);
+		if (entry->hash == hash && match(entry, key)) {
+			return i;
+		}
+		i = entry->chain_next;
+	}
+	return LRU_NONE;
+}
+
+static void lru_unlink(lru_shard *shard, uint32_t i) {
+	lru_links *entry = lru_entry(shard, i);
+	if (entry->lru_prev != LRU_NONE) {
+		lru_entry(shard, entry->lru_prev)->lru_next = entry->lru_next;
+	} else {
+		shard->lru_head = entry->lru_next;
+	}
+	if (entry->lru_next != LRU_NONE) {
+		lru_entry(shard, entry->lru_next)->lru_prev = entry->lru_prev;
+	} else {
+		shard->lru_tail = entry->lru_prev;
+	}
+}
+
+static void lru_push(lru_shard *shard, uint32_t i) {
+	lru_links *entry = lru_entry(shard, i);
+	entry->lru_prev	 = LRU_NONE;
+	entry->lru_next	 = shard->lru_head;
+	if (shard->lru_head != LRU_NONE) {
+		lru_entry(shard, shard->lru_head)->lru_prev = i;
+	} else {
+		shard->lru_tail = i;
+	}
+	shard->lru_head = i;
+}
+
+static void lru_chain_unlink(lru_shard *shard, uint32_t i) {
+	lru_links *entry = lru_entry(shard, i);
+	uint32_t *link	 = &lru_entry(shard, lru_bucket(shard, entry->hash))->bucket;
+	while (*link != i) {
+		link = &lru_entry(shard, *link)->chain_next;
+	}
+	*link = entry->chain_next;
+}
+
+/* Returns the least recently used entry to the free list, wiped. */
+static void lru_evict(lru_shard *shard) {
+	uint32_t i		 = shard->lru_tail;
+	lru_links *entry = lru_entry(shard, i);
+	lru_chain_unlink(shard, i);
+	lru_unlink(shard, i);
+	shard->wipe(entry);
+	entry->lru_next	 = shard->free_head;
+	shard->free_head = i;
+	shard->evictions++;
+}
+
+static void lru_shard_reset(lru_shard *shard) {
+	uint32_t i;
+	for (i = 0; i < shard->capacity; ++i) {
+		lru_links *entry = lru_entry(shard, i);
+		shard->wipe(entry);
+		entry->hash		  = 0;
+		entry->bucket	  = LRU_NONE;
+		entry->chain_next = LRU_NONE;
+		entry->lru_prev	  = LRU_NONE;
+		entry->lru_next	  = i + 1 < shard->capacity ? i + 1 : LRU_NONE;
+	}
+	shard->lru_head	 = LRU_NONE;
+	shard->lru_tail	 = LRU_NONE;
+	shard->free_head = 0;
+}
+
+int lru_init(lru_cache *cache, void *entries, size_t entry_size, size_t capacity, lru_wipe wipe) {
+	size_t per_shard = capacity / LRU_SHARDS;
+	int i;
+
+	if (per_shard == 0 || per_shard >= LRU_NONE) {
+		return 0;
+	}
+
+	for (i = 0; i < LRU_SHARDS; ++i) {
+		lru_shard *shard = &cache->shards[i];
+		if (pthread_mutex_init(&shard->lock, NULL) != 0) {
+			while (i-- > 0) {
+				pthread_mutex_destroy(&cache->shards[i].lock);
+			}
+			return 0;
+		}
+		shard->entries	  = (uint8_t *)entries + (size_t)i * per_shard * entry_size;
+		shard->entry_size = entry_size;
+		shard->wipe		  = wipe;
+		shard->capacity	  = (uint32_t)per_shard;
+		shard->hits		  = 0;
+		shard->misses	  = 0;
+		shard->evictions  = 0;
+		lru_shard_reset(shard);
+	}
+	return 1;
+}
+
+void lru_destroy(lru_cache *cache) {
+	int i;
+	for (i = 0; i < LRU_SHARDS; ++i) {
+		lru_shard_reset(&cache->shards[i]);
+		pthread_mutex_destroy(&cache->shards[i].lock);
+	}
+}
+
+void lru_clear(lru_cache *cache) {
+	int i;
+	for (i = 0; i < LRU_SHARDS; ++i) {
+		pthread_mutex_lock(&cache->shards[i].lock);
+		lru_shard_reset(&cache->shards[i]);
+		pthread_mutex_unlock(&cache->shards[i].lock);
+	}
+}
+
+void lru_stats(const lru_cache *cache, uint64_t *hits, uint64_t *misses, uint64_t *evictions) {
+	uint64_t h = 0, m = 0, e = 0;
+	int i;
+	for (i = 0; i < LRU_SHARDS; ++i) {
+		lru_shard *shard = (lru_shard *)&cache->shards[i];
+		pthread_mutex_lock(&shard->lock);
+		h += shard->hits;
+		m += shard->misses;
+		e += shard->evictions;
+		pthread_mutex_unlock(&shard->lock);
+	}
+	if (hits) {
+		*hits = h;
+	}
+	if (misses) {
+		*misses = m;
+	}
+	if (evictions) {
+		*evictions = e;
+	}
+}
+
+lru_shard *lru_shard_for(lru_cache *cache, uint64_t hash) {
+	return &cache->shards[hash & (LRU_SHARDS - 1)];
+}
+
+void *lru_get(lru_shard *shard, uint64_t hash, lru_match match, const void *key) {
+	uint32_t i = lru_find(shard, hash, match, key);
+	if (i == LRU_NONE) {
+		shard->misses++;
+		return NULL;
+	}
+	lru_unlink(shard, i);
+	lru_push(shard, i);
+	shard->hits++;
+	return lru_entry(shard, i);
+}
+
+void *lru_put(lru_shard *shard, uint64_t hash, lru_match match, const void *key) {
+	lru_links *entry, *head;
+	uint32_t i;
+
+	if (lru_find(shard, hash, match, key) != LRU_NONE) {
+		return NULL;
+	}
+	if (shard->free_head == LRU_NONE) {
+		lru_evict(shard);
+	}
+	i				 = shard->free_head;
+	entry			 = lru_entry(shard, i);
+	shard->free_head = entry->lru_next;
+
+	head			  = lru_entry(shard, lru_bucket(shard, hash));
+	entry->hash		  = hash;
+	entry->chain_next = head->bucket;
+	head->bucket	  = i;
+	lru_push(shard, i);
+	return entry;
+}
@@ -0,0 +1,85 @@
+//
+//  lru.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#ifndef lru_h
+#define lru_h
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* The sharded LRU map behind sign_cache and key_cache. Entries are owned by the caller and only
+   linked together by index, so a cache can live in static storage, on the heap or in shared
+   memory. Each entry type starts with an lru_links and adds its key and value; the map only
+   compares keys through a caller-supplied match function. */
+
+/* Number of independently locked shards. Must be a power of two. */
+#define LRU_SHARDS 16
+
+/* Marks the end of a chain or list of entries. */
+#define LRU_NONE UINT32_MAX
+
+/* The links every entry starts with. */
+typedef struct {
+	uint64_t hash;	 /* of the entry's key, to find its chain again when it is evicted */
+	uint32_t bucket; /* first entry of the hash chain whose bucket is this slot */
+	uint32_t chain_next;
+	uint32_t lru_prev;
+	uint32_t lru_next; /* also links the free list */
+} lru_links;
+
+/* Returns nonzero if entry holds key. */
+typedef int (*lru_match)(const void *entry, const void *key);
+
+/* Clears the key and value of an entry that is dropped. */
+typedef void (*lru_wipe)(void *entry);
+
+typedef struct {
+	pthread_mutex_t lock;
+	uint8_t *entries;
+	size_t entry_size;
+	lru_wipe wipe;
+	uint32_t capacity;
+	uint32_t lru_head; /* most recently used */
+	uint32_t lru_tail; /* least recently used, evicted first */
+	uint32_t free_head;
+	uint64_t hits;
+	uint64_t misses;
+	uint64_t evictions;
+} lru_shard;
+
+typedef struct {
+	lru_shard shards[LRU_SHARDS];
+} lru_cache;
+
+/* Sets up cache over capacity entries of entry_size bytes, split evenly across the shards.
+   capacity must be at least LRU_SHARDS. Returns 1 on success, 0 otherwise. */
+int lru_init(lru_cache *cache, void *entries, size_t entry_size, size_t capacity, lru_wipe wipe);
+
+/* Wipes every entry and releases the shard locks. */
+void lru_destroy(lru_cache *cache);
+
+/* Wipes every entry, keeping the counters. */
+void lru_clear(lru_cache *cache);
+
+/* Sums the counters of all shards. Any output may be NULL. */
+void lru_stats(const lru_cache *cache, uint64_t *hits, uint64_t *misses, uint64_t *evictions);
+
+/* Returns the shard that holds the keys hashing to hash. */
+lru_shard *lru_shard_for(lru_cache *cache, uint64_t hash);
+
+/* Looks key up in shard, whose lock the caller holds, and counts a hit or a miss. A hit becomes
+   the most recently used entry. Returns the entry, or NULL on a miss. */
+void *lru_get(lru_shard *shard, uint64_t hash, lru_match match, const void *key);
+
+/* Returns a free entry of shard, whose lock the caller holds, linked under hash as the most
+   recently used one, for the caller to fill with key and its value. Evicts the least recently
+   used entry if the shard is full. Returns NULL if key is already present, as after a concurrent
+   miss on the same key. */
+void *lru_put(lru_shard *shard, uint64_t hash, lru_match match, const void *key);
+
+#endif /* lru_h */
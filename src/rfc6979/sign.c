@@ -12,6 +12,29 @@
 // ---------------------------------------------------------------------
 
 #include "sign.h"
+#include "../ecc/curve.h"
+
+/* Reads a 32-byte big-endian scalar and returns 1 if it lies in [1, n - 1] for curve. */
+static int sign_read_scalar(uECC_word_t *native, const uint8_t *bytes, uECC_Curve curve) {
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+	uECC_vli_bytesToNative(native, bytes, 32);
+	return !uECC_vli_isZero(native, num_n_words) && uECC_vli_cmp_unsafe(curve->n, native, num_n_words) == 1;
+}
+
+/* RFC 6979 3.2.d feeds the nonce generator the message hash reduced modulo the order of the
+   curve being signed on. The nonce functions reduce modulo the secp256k1 order, which leaves
+   the result for any order below it, such as that of secp256r1, unchanged. */
+static void sign_reduce_hash(uint8_t *reduced, const uint8_t *message_hash, uECC_Curve curve) {
+	uECC_word_t h[uECC_MAX_WORDS];
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+	uECC_vli_bytesToNative(h, message_hash, 32);
+	if (uECC_vli_cmp_unsafe(curve->n, h, num_n_words) != 1) {
+		uECC_vli_sub(h, h, curve->n, num_n_words);
+	}
+	uECC_vli_nativeToBytes(reduced, 32, h);
+}
 
 int sign_rfc6979(
 	const uint8_t *private_key,
@@ -21,39 +44,29 @@ int sign_rfc6979(
 	uint8_t *signature,
 	uECC_Curve curve
 ) {
-	secp256k1_scalar sec, non, msg;
+	uECC_word_t sec[uECC_MAX_WORDS], non[uECC_MAX_WORDS];
+	unsigned char msg32[32];
 	int ret = 0;
 	int is_sec_valid;
 	unsigned char nonce32[32];
 	unsigned int count = 0;
-	/* Default initialization here is important so we won't pass uninit values to the cmov in the end */
-	// *r = secp256k1_scalar_zero;
-	// *s = secp256k1_scalar_zero;
 	if (recid) {
 		*recid = 0;
 	}
 
 	/* Fail if the secret key is invalid. */
-	is_sec_valid = secp256k1_scalar_set_b32_seckey(&sec, private_key);
-	secp256k1_scalar_cmov(&sec, &secp256k1_scalar_one, !is_sec_valid);
-	secp256k1_scalar_set_b32(&msg, message_hash, NULL);
+	is_sec_valid = sign_read_scalar(sec, private_key, curve);
+	sign_reduce_hash(msg32, message_hash, curve);
 	while (1) {
 		int is_nonce_valid;
-		ret = !!nonce_function_rfc6979(nonce32, message_hash, private_key, NULL, NULL, count);
+		ret = !!nonce_function_rfc6979(nonce32, msg32, private_key, NULL, NULL, count);
 		if (!ret) {
 			break;
 		}
-		is_nonce_valid = secp256k1_scalar_set_b32_seckey(&non, nonce32);
-		/* The nonce is still secret here, but it being invalid is is less likely than 1:2^255. */
-		// secp256k1_declassify(ctx, &is_nonce_valid, sizeof(is_nonce_valid));
+		is_nonce_valid = sign_read_scalar(non, nonce32, curve);
+		/* The nonce is still secret here, but it being invalid is is less likely than 1:2^32. */
 		if (is_nonce_valid) {
-			// uECC_word_t *a = (uECC_word_t *)non.d;
-			//			uECC_vli_bytesToNative(a, nonce32, 32);
-			//			secp256k1_scalar_get_b32(a, &non);
-			// ret = secp256k1_ecdsa_sig_sign(&ctx->ecmult_gen_ctx, r, s, &sec, &msg, &non, recid);
-
-			//			(uECC_word_t *)non.d
-			ret = uECC_sign_with_k(private_key, message_hash, hash_size, non.d, recid, signature, curve);
+			ret = uECC_sign_with_k(private_key, message_hash, hash_size, non, recid, signature, curve);
 			/* The final signature is no longer a secret, nor is the fact that we were successful or not. */
 			// secp256k1_declassify(ctx, &ret, sizeof(ret));
 			if (ret) {
@@ -67,14 +80,81 @@ int sign_rfc6979(
 	 * used as a branching variable. */
 	ret &= is_sec_valid;
 	memset(nonce32, 0, 32);
-	secp256k1_scalar_clear(&msg);
-	secp256k1_scalar_clear(&non);
-	secp256k1_scalar_clear(&sec);
-	//	 secp256k1_scalar_cmov(r, &secp256k1_scalar_zero, !ret);
-	//	 secp256k1_scalar_cmov(s, &secp256k1_scalar_zero, !ret);
-	// if (recid) {
-	// 	const int zero = 0;
-	// 	secp256k1_int_cmov(recid, &zero, !ret);
-	// }
+	memset(msg32, 0, 32);
+	memset(non, 0, sizeof(non));
+	memset(sec, 0, sizeof(sec));
+	return ret;
+}
+
+int sign_rfc6979_batch(
+	const uint8_t *private_key,
+	const uint8_t *message_hashes,
+	unsigned hash_size,
+	unsigned count,
+	uint8_t *recids,
+	uint8_t *signatures,
+	uECC_Curve curve
+) {
+	secp256k1_hmac_sha256 prefix;
+	uECC_word_t sec[uECC_MAX_WORDS];
+	uECC_word_t k[uECC_BATCH_SIZE][uECC_MAX_WORDS];
+	unsigned char nonce32[32];
+	unsigned char msg32[32];
+	unsigned done, i;
+	int ret = 1;
+	int is_sec_valid;
+	const unsigned sig_size = 2 * curve->num_bytes;
+
+	/* Fail if the secret key is invalid. */
+	is_sec_valid = sign_read_scalar(sec, private_key, curve);
+	nonce_function_rfc6979_precompute(&prefix, private_key);
+
+	for (done = 0; done < count; done += uECC_BATCH_SIZE) {
+		unsigned chunk = count - done < uECC_BATCH_SIZE ? count - done : uECC_BATCH_SIZE;
+		const uint8_t *hashes = message_hashes + (size_t)done * hash_size;
+
+		for (i = 0; i < chunk; ++i) {
+			unsigned int counter = 0;
+			sign_reduce_hash(msg32, hashes + (size_t)i * hash_size, curve);
+			while (1) {
+				nonce_function_rfc6979_prefixed(nonce32, &prefix, msg32, private_key, counter);
+				if (sign_read_scalar(k[i], nonce32, curve)) {
+					break;
+				}
+				counter++;
+			}
+		}
+
+		if (!uECC_sign_with_k_batch(
+				private_key,
+				hashes,
+				hash_size,
+				k,
+				chunk,
+				recids ? recids + done : NULL,
+				signatures + (size_t)done * sig_size,
+				curve
+			)) {
+			/* A nonce produced r == 0 or s == 0, which is less likely than 1:2^255. Redo the chunk
+			 * one signature at a time so that sign_rfc6979() can move on to the next nonce. */
+			for (i = 0; i < chunk; ++i) {
+				ret &= sign_rfc6979(
+					private_key,
+					hashes + (size_t)i * hash_size,
+					hash_size,
+					recids ? recids + done + i : NULL,
+					signatures + (size_t)(done + i) * sig_size,
+					curve
+				);
+			}
+		}
+	}
+
+	ret &= is_sec_valid;
+	memset(nonce32, 0, 32);
+	memset(k, 0, sizeof(k));
+	memset(msg32, 0, 32);
+	memset(sec, 0, sizeof(sec));
+	memset(&prefix, 0, sizeof(prefix));
 	return ret;
 }
@@ -31,4 +31,19 @@ int sign_rfc6979(
 	uECC_Curve curve
 );
 
+/* Signs count message hashes of hash_size bytes each, stored back to back, under one private key.
+   Produces the same signatures and recovery ids as calling sign_rfc6979() on every hash, but
+   validates the key and absorbs it into the nonce generator once, and shares the k*G and 1/k
+   inversions across uECC_BATCH_SIZE signatures. signatures receives count * 64 bytes; recids,
+   if not NULL, count bytes. Returns 1 if every hash was signed, 0 otherwise. */
+int sign_rfc6979_batch(
+	const uint8_t *private_key,
+	const uint8_t *message_hashes,
+	unsigned hash_size,
+	unsigned count,
+	uint8_t *recids,
+	uint8_t *signatures,
+	uECC_Curve curve
+);
+
 #endif /* sign_h */
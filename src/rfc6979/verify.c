@@ -26,3 +26,46 @@ int verify_rfc6979(
 int compute_public_key_rfc6979(const uint8_t *private_key, uint8_t *public_key, uECC_Curve curve) {
 	return uECC_compute_public_key(private_key, public_key, curve);
 }
+
+int compute_public_key_rfc6979_batch(
+	const uint8_t *private_keys, unsigned count, int compressed, uint8_t *public_keys, uint8_t *valid, uECC_Curve curve
+) {
+	return uECC_compute_public_key_batch(private_keys, count, compressed, public_keys, valid, curve);
+}
+
+int recover_rfc6979(
+	const uint8_t *message_hash,
+	unsigned hash_size,
+	const uint8_t *signature,
+	uint8_t recid,
+	uint8_t *public_key,
+	uECC_Curve curve
+) {
+	return uECC_recover(message_hash, hash_size, signature, recid, public_key, curve);
+}
+
+int recover_rfc6979_batch(
+	const uint8_t *message_hashes,
+	unsigned hash_size,
+	const uint8_t *signatures,
+	const uint8_t *recids,
+	unsigned count,
+	uint8_t *public_keys,
+	uint8_t *valid,
+	uECC_Curve curve
+) {
+	return uECC_recover_batch(message_hashes, hash_size, signatures, recids, count, public_keys, valid, curve);
+}
+
+int verify_rfc6979_batch(
+	const uint8_t *public_keys,
+	const uint8_t *message_hashes,
+	unsigned hash_size,
+	const uint8_t *signatures,
+	const uint8_t *recids,
+	unsigned count,
+	uint8_t *valid,
+	uECC_Curve curve
+) {
+	return uECC_verify_batch(public_keys, message_hashes, hash_size, signatures, recids, count, valid, curve);
+}
@@ -30,4 +30,53 @@ int verify_rfc6979(
 
 int compute_public_key_rfc6979(const uint8_t *private_key, uint8_t *public_key, uECC_Curve curve);
 
+/* Computes count public keys from count 32-byte private keys stored back to back, sharing the
+   final field inversions. Keys are written back to back, 33 bytes each if compressed is non-zero
+   and 64 bytes otherwise. valid, if not NULL, receives 1 for every computed key and 0 for every
+   private key outside [1, n-1]. Returns 1 if every key was computed, 0 otherwise. */
+int compute_public_key_rfc6979_batch(
+	const uint8_t *private_keys, unsigned count, int compressed, uint8_t *public_keys, uint8_t *valid, uECC_Curve curve
+);
+
+/* Recovers the 64-byte public key (x || y) that produced signature over message_hash, using the
+   recid returned by sign_rfc6979(). Returns 1 on success, 0 if nothing can be recovered. */
+int recover_rfc6979(
+	const uint8_t *message_hash,
+	unsigned hash_size,
+	const uint8_t *signature,
+	uint8_t recid,
+	uint8_t *public_key,
+	uECC_Curve curve
+);
+
+/* Recovers count public keys at once, as recover_rfc6979(). Hashes, 64-byte signatures and
+   64-byte public keys are stored back to back; recids holds one byte per signature. valid, if not
+   NULL, receives 1 for every recovered key and 0 for every rejected one. Returns 1 if every key
+   was recovered, 0 otherwise. */
+int recover_rfc6979_batch(
+	const uint8_t *message_hashes,
+	unsigned hash_size,
+	const uint8_t *signatures,
+	const uint8_t *recids,
+	unsigned count,
+	uint8_t *public_keys,
+	uint8_t *valid,
+	uECC_Curve curve
+);
+
+/* Verifies count signatures at once, as verify_rfc6979(). With the recids returned by
+   sign_rfc6979(), groups of signatures are checked together and only a failing group is verified
+   signature by signature; with recids NULL every signature is verified on its own. valid, if not
+   NULL, receives 1 for every valid signature and 0 otherwise. Returns 1 if all are valid. */
+int verify_rfc6979_batch(
+	const uint8_t *public_keys,
+	const uint8_t *message_hashes,
+	unsigned hash_size,
+	const uint8_t *signatures,
+	const uint8_t *recids,
+	unsigned count,
+	uint8_t *valid,
+	uECC_Curve curve
+);
+
 #endif /* verify_h */
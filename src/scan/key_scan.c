@@ -0,0 +1,332 @@
+//
+//  key_scan.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#include "key_scan.h"
+#include "../ecc/point.h"
+#include "../ecc/vli.h"
+#include "../keccak256/keccak256.h"
+
+#include <pthread.h>
+#include <string.h>
+
+/* State shared by the workers of one scan. */
+typedef struct {
+	const key_scan_context *context;
+	key_scan_callback callback;
+	void *user;
+	int hash_addresses;
+	pthread_mutex_t lock;
+	int stopped;
+} key_scan_shared;
+
+/* One worker's slice of the range. */
+typedef struct {
+	key_scan_shared *shared;
+	uECC_word_t start[uECC_MAX_WORDS];
+	uint64_t offset;
+	uint64_t count;
+	int ok;
+} key_scan_slice;
+
+/* Output of key_scan_range(), filled in by key_scan_copy(). */
+typedef struct {
+	uint8_t *public_keys;
+	uint8_t *addresses;
+	size_t public_key_size;
+} key_scan_buffers;
+
+static void key_scan_set_u64(uECC_word_t *vli, uint64_t value, wordcount_t num_words) {
+	wordcount_t i;
+	for (i = 0; i < num_words; ++i) {
+		vli[i] = (uECC_word_t)value;
+		/* Two shifts, as shifting by the full width of value is undefined when words are 64 bits. */
+		value >>= uECC_WORD_BITS - 1;
+		value >>= 1;
+	}
+}
+
+int key_scan_init(key_scan_context *context, uECC_Curve curve) {
+	uECC_word_t two[uECC_MAX_WORDS];
+	wordcount_t num_words = curve->num_words;
+	unsigned i;
+
+	context->curve = curve;
+	uECC_vli_set(context->table[0], curve->G, num_words * 2);
+	key_scan_set_u64(two, 2, BITS_TO_WORDS(curve->num_n_bits));
+	if (!EccPoint_compute_public_key(context->table[1], two, curve)) {
+		return 0;
+	}
+	for (i = 2; i <= KEY_SCAN_BLOCK; ++i) {
+		EccPoint_add_G(context->table[i], context->table[i - 1], curve);
+	}
+	return 1;
+}
+
+static int key_scan_is_stopped(key_scan_shared *shared) {
+	int stopped;
+	pthread_mutex_lock(&shared->lock);
+	stopped = shared->stopped;
+	pthread_mutex_unlock(&shared->lock);
+	return stopped;
+}
+
+/* Serializes count affine points and hands them to the callback. Returns 0 if the scan stops. */
+static int key_scan_emit(
+	key_scan_shared *shared, uint64_t offset, uECC_word_t (*points)[uECC_MAX_WORDS * 2], unsigned count
+) {
+	uint8_t public_keys[KEY_SCAN_BLOCK][uECC_MAX_WORDS * 2 * uECC_WORD_SIZE];
+	uint8_t addresses[KEY_SCAN_BLOCK][20];
+	uint8_t hashes[KEY_SCAN_BLOCK][32];
+	const uint8_t *inputs[KEY_SCAN_BLOCK] = {NULL};
+	size_t sizes[KEY_SCAN_BLOCK]		  = {0};
+	uECC_Curve curve	  = shared->context->curve;
+	wordcount_t num_bytes = curve->num_bytes;
+	unsigned i;
+
+	for (i = 0; i < count; ++i) {
+		uECC_vli_nativeToBytes(public_keys[i], num_bytes, points[i]);
+		uECC_vli_nativeToBytes(public_keys[i] + num_bytes, num_bytes, points[i] + curve->num_words);
+		inputs[i] = public_keys[i];
+		sizes[i]  = 2 * (size_t)num_bytes;
+	}
+	if (shared->hash_addresses) {
+		keccak256_batch(hashes[0], inputs, sizes, count);
+		for (i = 0; i < count; ++i) {
+			memcpy(addresses[i], hashes[i] + 12, 20);
+		}
+	}
+
+	/* Packed back to back for the callback, whatever the curve size. */
+	if (2 * num_bytes != (int)sizeof(public_keys[0])) {
+		for (i = 1; i < count; ++i) {
+			memmove((uint8_t *)public_keys + (size_t)i * 2 * num_bytes, public_keys[i], 2 * (size_t)num_bytes);
+		}
+	}
+
+	if (shared->callback(
+			shared->user, offset, count, (const uint8_t *)public_keys, shared->hash_addresses ? addresses[0] : NULL
+		)) {
+		pthread_mutex_lock(&shared->lock);
+		shared->stopped = 1;
+		pthread_mutex_unlock(&shared->lock);
+		return 0;
+	}
+	return 1;
+}
+
+/* Walks count keys from start. Keys up to KEY_SCAN_BLOCK + 1 come straight from the table. Every
+   later block adds G, 2G, ..., mG to the affine point of the key before it, so the m slopes
+   only need the inverses of x(iG) - x(base), which are computed together. The base key is above
+   KEY_SCAN_BLOCK and every sum stays below n, so no denominator is zero. */
+static int key_scan_walk(key_scan_shared *shared, const uECC_word_t *start, uint64_t offset, uint64_t count) {
+	const key_scan_context *context = shared->context;
+	uECC_Curve curve				= context->curve;
+	uECC_word_t points[KEY_SCAN_BLOCK][uECC_MAX_WORDS * 2];
+	uECC_word_t inverses[KEY_SCAN_BLOCK][uECC_MAX_WORDS];
+	uECC_word_t base[uECC_MAX_WORDS * 2];
+	uECC_word_t key[uECC_MAX_WORDS];
+	uECC_word_t lambda[uECC_MAX_WORDS];
+	uECC_word_t t[uECC_MAX_WORDS];
+	wordcount_t num_words	= curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+	uint64_t done			= 0;
+	unsigned m, i;
+
+	uECC_vli_set(key, start, num_n_words);
+	key_scan_set_u64(t, KEY_SCAN_BLOCK + 1, num_n_words);
+	if (uECC_vli_cmp_unsafe(key, t, num_n_words) != 1) {
+		/* key <= KEY_SCAN_BLOCK + 1 fits in the first word. */
+		uint64_t first = (uint64_t)key[0];
+		uint64_t last  = count < KEY_SCAN_BLOCK + 2 - first ? first - 1 + count : KEY_SCAN_BLOCK + 1;
+		while (first + done <= last) {
+			m = last - (first + done) + 1 < KEY_SCAN_BLOCK ? (unsigned)(last - (first + done) + 1) : KEY_SCAN_BLOCK;
+			for (i = 0; i < m; ++i) {
+				uECC_vli_set(points[i], context->table[first - 1 + done + i], num_words * 2);
+			}
+			if (!key_scan_emit(shared, offset + done, points, m)) {
+				return 0;
+			}
+			done += m;
+		}
+		uECC_vli_set(base, context->table[KEY_SCAN_BLOCK], num_words * 2);
+	} else {
+		/* The point of key - 1, which the first block adds G to. */
+		key_scan_set_u64(t, 1, num_n_words);
+		uECC_vli_sub(key, key, t, num_n_words);
+		if (!EccPoint_compute_public_key(base, key, curve)) {
+			return 0;
+		}
+	}
+
+	while (done < count) {
+		if (key_scan_is_stopped(shared)) {
+			return 0;
+		}
+		m = count - done < KEY_SCAN_BLOCK ? (unsigned)(count - done) : KEY_SCAN_BLOCK;
+		for (i = 0; i < m; ++i) {
+			uECC_vli_modSub(inverses[i], context->table[i], base, curve->p, num_words);
+		}
+		uECC_vli_modInv_batch_fast(inverses, m, curve);
+
+		for (i = 0; i < m; ++i) {
+			const uECC_word_t *q = context->table[i];
+			uECC_word_t *x		 = points[i];
+			uECC_word_t *y		 = points[i] + num_words;
+
+			/* lambda = (y_q - y_base) / (x_q - x_base) */
+			uECC_vli_modSub(t, q + num_words, base + num_words, curve->p, num_words);
+			uECC_vli_modMult_fast(lambda, t, inverses[i], curve);
+
+			/* x = lambda^2 - x_base - x_q */
+			uECC_vli_modSquare_fast(x, lambda, curve);
+			uECC_vli_modSub(x, x, base, curve->p, num_words);
+			uECC_vli_modSub(x, x, q, curve->p, num_words);
+
+			/* y = lambda * (x_base - x) - y_base */
+			uECC_vli_modSub(t, base, x, curve->p, num_words);
+			uECC_vli_modMult_fast(y, lambda, t, curve);
+			uECC_vli_modSub(y, y, base + num_words, curve->p, num_words);
+		}
+
+		if (!key_scan_emit(shared, offset + done, points, m)) {
+			return 0;
+		}
+		uECC_vli_set(base, points[m - 1], num_words * 2);
+		done += m;
+	}
+	return 1;
+}
+
+static void *key_scan_worker(void *arg) {
+	key_scan_slice *slice = (key_scan_slice *)arg;
+	slice->ok			  = key_scan_walk(slice->shared, slice->start, slice->offset, slice->count);
+	return NULL;
+}
+
+/* Checks that start_key and start_key + count - 1 lie in [1, n - 1], leaving start_key in start. */
+static int key_scan_check_range(uECC_word_t *start, const uint8_t *start_key, uint64_t count, uECC_Curve curve) {
+	uECC_word_t last[uECC_MAX_WORDS];
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+	if (count == 0) {
+		return 0;
+	}
+	start[num_n_words - 1] = 0;
+	uECC_vli_bytesToNative(start, start_key, BITS_TO_BYTES(curve->num_n_bits));
+	if (uECC_vli_isZero(start, num_n_words)) {
+		return 0;
+	}
+	key_scan_set_u64(last, count - 1, num_n_words);
+	if (uECC_vli_add(last, last, start, num_n_words)) {
+		return 0;
+	}
+	return uECC_vli_cmp_unsafe(curve->n, last, num_n_words) == 1;
+}
+
+int key_scan_parallel(
+	const key_scan_context *context,
+	const uint8_t *start_key,
+	uint64_t count,
+	unsigned threads,
+	int hash_addresses,
+	key_scan_callback callback,
+	void *user
+) {
+	key_scan_slice slices[KEY_SCAN_MAX_THREADS];
+	pthread_t workers[KEY_SCAN_MAX_THREADS];
+	key_scan_shared shared;
+	uECC_word_t step[uECC_MAX_WORDS];
+	wordcount_t num_n_words = BITS_TO_WORDS(context->curve->num_n_bits);
+	uint64_t per_thread;
+	unsigned started = 0;
+	unsigned i;
+	int ret = 1;
+
+	if (!key_scan_check_range(slices[0].start, start_key, count, context->curve)) {
+		return 0;
+	}
+	if (threads == 0) {
+		threads = 1;
+	}
+	if (threads > KEY_SCAN_MAX_THREADS) {
+		threads = KEY_SCAN_MAX_THREADS;
+	}
+
+	/* Slices are whole blocks, so only the last one can end in a partial block. */
+	per_thread = count / threads + (count % threads != 0);
+	per_thread = (per_thread + KEY_SCAN_BLOCK - 1) / KEY_SCAN_BLOCK * KEY_SCAN_BLOCK;
+	threads	   = (unsigned)((count + per_thread - 1) / per_thread);
+
+	shared.context		  = context;
+	shared.callback		  = callback;
+	shared.user			  = user;
+	shared.hash_addresses = hash_addresses;
+	shared.stopped		  = 0;
+	if (pthread_mutex_init(&shared.lock, NULL) != 0) {
+		return 0;
+	}
+
+	key_scan_set_u64(step, per_thread, num_n_words);
+	for (i = 0; i < threads; ++i) {
+		slices[i].shared = &shared;
+		slices[i].offset = (uint64_t)i * per_thread;
+		slices[i].count	 = count - slices[i].offset < per_thread ? count - slices[i].offset : per_thread;
+		slices[i].ok	 = 0;
+		if (i > 0) {
+			uECC_vli_add(slices[i].start, slices[i - 1].start, step, num_n_words);
+		}
+	}
+
+	/* The calling thread takes the first slice. */
+	for (i = 1; i < threads; ++i) {
+		if (pthread_create(&workers[i], NULL, key_scan_worker, &slices[i]) != 0) {
+			pthread_mutex_lock(&shared.lock);
+			shared.stopped = 1;
+			pthread_mutex_unlock(&shared.lock);
+			ret = 0;
+			break;
+		}
+		started = i;
+	}
+	if (ret) {
+		key_scan_worker(&slices[0]);
+	}
+	for (i = 1; i <= started; ++i) {
+		pthread_join(workers[i], NULL);
+	}
+	for (i = 0; ret && i < threads; ++i) {
+		ret = slices[i].ok;
+	}
+
+	pthread_mutex_destroy(&shared.lock);
+	return ret;
+}
+
+static int key_scan_copy(
+	void *user, uint64_t offset, unsigned count, const uint8_t *public_keys, const uint8_t *addresses
+) {
+	key_scan_buffers *buffers = (key_scan_buffers *)user;
+	memcpy(buffers->public_keys + offset * buffers->public_key_size, public_keys, count * buffers->public_key_size);
+	if (addresses) {
+		memcpy(buffers->addresses + offset * 20, addresses, (size_t)count * 20);
+	}
+	return 0;
+}
+
+int key_scan_range(
+	const key_scan_context *context,
+	const uint8_t *start_key,
+	uint64_t count,
+	uint8_t *public_keys,
+	uint8_t *addresses
+) {
+	key_scan_buffers buffers;
+	buffers.public_keys		= public_keys;
+	buffers.addresses		= addresses;
+	buffers.public_key_size = 2 * (size_t)context->curve->num_bytes;
+	return key_scan_parallel(context, start_key, count, 1, addresses != NULL, key_scan_copy, &buffers);
+}
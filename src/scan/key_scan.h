@@ -0,0 +1,73 @@
+//
+//  key_scan.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+//
+
+#ifndef key_scan_h
+#define key_scan_h
+
+#include "../ecc/core.h"
+#include "../ecc/curve.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Number of consecutive keys derived per field inversion. */
+#define KEY_SCAN_BLOCK uECC_BATCH_SIZE
+
+/* Most worker threads key_scan_parallel() starts. */
+#define KEY_SCAN_MAX_THREADS 64
+
+/* Read-only state shared by every scan over one curve: the affine multiples G, 2G, ...,
+   (KEY_SCAN_BLOCK + 1) * G. A context may be used by any number of threads at once. */
+typedef struct {
+	uECC_Curve curve;
+	uECC_word_t table[KEY_SCAN_BLOCK + 1][uECC_MAX_WORDS * 2];
+} key_scan_context;
+
+/* Receives the keys start + offset, ..., start + offset + count - 1 of a scan. public_keys holds
+   count raw public keys (X || Y) of 2 * curve->num_bytes bytes each, 64 on secp256k1. addresses
+   holds count 20-byte Ethereum addresses, the last 20 bytes of Keccak-256 of each public key, or
+   is NULL if the scan does not hash them. The buffers are only valid during the call. Return 0
+   to continue and non-zero to stop the scan. */
+typedef int (*key_scan_callback)(
+	void *user, uint64_t offset, unsigned count, const uint8_t *public_keys, const uint8_t *addresses
+);
+
+/* Builds the table for curve. Returns 1 on success, 0 otherwise. */
+int key_scan_init(key_scan_context *context, uECC_Curve curve);
+
+/* Computes the public keys of the count private keys start_key, start_key + 1, ..., which must
+   all lie in [1, n - 1]. Every key after the first costs one affine point addition, and the
+   additions of KEY_SCAN_BLOCK keys share one field inversion; only the first key goes through
+   the scalar multiplication ladder. public_keys receives the raw public keys and addresses, if
+   not NULL, 20 * count bytes, both laid out as for key_scan_callback.
+   Not constant time: the keys are treated as public, as they are in audits and range scans.
+   Returns 1 on success, 0 if the range is empty or leaves [1, n - 1]. */
+int key_scan_range(
+	const key_scan_context *context,
+	const uint8_t *start_key,
+	uint64_t count,
+	uint8_t *public_keys,
+	uint8_t *addresses
+);
+
+/* Scans the same range as key_scan_range() on threads worker threads (1 for the calling thread
+   only), each walking a disjoint slice of about count / threads keys. Every block of at most
+   KEY_SCAN_BLOCK keys is passed to callback, which may be called from several threads at once
+   and in no particular order. Addresses are computed if hash_addresses is non-zero.
+   Returns 1 if the whole range was scanned, 0 if the range is invalid, a thread could not be
+   started or callback stopped the scan. */
+int key_scan_parallel(
+	const key_scan_context *context,
+	const uint8_t *start_key,
+	uint64_t count,
+	unsigned threads,
+	int hash_addresses,
+	key_scan_callback callback,
+	void *user
+);
+
+#endif /* key_scan_h */
@@ -0,0 +1,331 @@
+//
+//  schnorr.c
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+// ---------------------------------------------------------------------
+//  adapted from bitcoin-core/secp256k1
+//  Copyright © 2020 Jonas Nick. MIT software license
+// ---------------------------------------------------------------------
+
+#include "schnorr.h"
+#include "../ecc/core.h"
+#include "../ecc/curve.h"
+#include "../ecc/point.h"
+#include "../ecc/vli.h"
+#include "../hmac/hash.h"
+
+#include <string.h>
+
+/* SHA256 states after absorbing SHA256(tag) || SHA256(tag) for the three BIP340 tags, so that a
+   tagged hash costs no more than a plain one. */
+static const uint32_t schnorr_aux_midstate[8] = {
+	0x24dd3219ul, 0x4eba7e70ul, 0xca0fabb9ul, 0x0fa3166dul, 0x3afbe4b1ul, 0x4c44df97ul, 0x4aac2739ul, 0x249e850aul
+};
+static const uint32_t schnorr_nonce_midstate[8] = {
+	0x46615b35ul, 0xf4bfbff7ul, 0x9f8dc671ul, 0x83627ab3ul, 0x60217180ul, 0x57358661ul, 0x21a29e54ul, 0x68b07b4cul
+};
+static const uint32_t schnorr_challenge_midstate[8] = {
+	0x9cecba11ul, 0x23925381ul, 0x11679112ul, 0xd1627e0ful, 0x97c87550ul, 0x003cc765ul, 0x90f61164ul, 0x33e9b66aul
+};
+
+/* Starts a tagged hash from its precomputed midstate. */
+static void schnorr_tagged(secp256k1_sha256 *sha, const uint32_t *midstate) {
+	memcpy(sha->s, midstate, sizeof(sha->s));
+	sha->bytes = 64;
+}
+
+/* Reduces a 256-bit hash or encoding below n. One subtraction is enough since 2^256 < 2n. */
+static void schnorr_reduce(uECC_word_t *native, const uint8_t *bytes, uECC_Curve curve) {
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+	uECC_vli_bytesToNative(native, bytes, 32);
+	if (uECC_vli_cmp_unsafe(curve->n, native, num_n_words) != 1) {
+		uECC_vli_sub(native, native, curve->n, num_n_words);
+	}
+}
+
+/* e = int(hash_BIP0340/challenge(r || P.x || message)) mod n */
+static void schnorr_challenge(
+	uECC_word_t *e,
+	const uint8_t *r,
+	const uint8_t *xonly_public_key,
+	const uint8_t *message,
+	size_t message_size,
+	uECC_Curve curve
+) {
+	secp256k1_sha256 sha;
+	uint8_t hash[32];
+
+	schnorr_tagged(&sha, schnorr_challenge_midstate);
+	secp256k1_sha256_write(&sha, r, 32);
+	secp256k1_sha256_write(&sha, xonly_public_key, 32);
+	secp256k1_sha256_write(&sha, message, message_size);
+	secp256k1_sha256_finalize(&sha, hash);
+	schnorr_reduce(e, hash, curve);
+}
+
+/* Sets point to the point with x coordinate x and an even y. Returns 0 if there is none. */
+static int schnorr_lift_x(uECC_word_t *point, const uint8_t *x, uECC_Curve curve) {
+	uint8_t compressed[33];
+	uint8_t public_key[64];
+
+	compressed[0] = 0x02;
+	memcpy(compressed + 1, x, 32);
+	if (!uECC_decompress(compressed, public_key, curve)) {
+		return 0;
+	}
+	uECC_vli_bytesToNative(point, public_key, 32);
+	uECC_vli_bytesToNative(point + curve->num_words, public_key + 32, 32);
+	return 1;
+}
+
+/* Reads the secret scalar of private_key and its public point. Returns 0 if the key is invalid. */
+static int schnorr_keypair(uECC_word_t *d, uECC_word_t *P, const uint8_t *private_key, uECC_Curve curve) {
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+	uECC_vli_bytesToNative(d, private_key, 32);
+	if (uECC_vli_isZero(d, num_n_words) || uECC_vli_cmp(curve->n, d, num_n_words) != 1) {
+		return 0;
+	}
+	return (int)EccPoint_compute_public_key(P, d, curve);
+}
+
+int schnorr_xonly_public_key(uint8_t *xonly_public_key, int *parity, const uint8_t *private_key) {
+	uECC_Curve curve = uECC_secp256k1();
+	uECC_word_t d[uECC_MAX_WORDS];
+	uECC_word_t P[uECC_MAX_WORDS * 2];
+	int ret;
+
+	ret = schnorr_keypair(d, P, private_key, curve);
+	if (ret) {
+		uECC_vli_nativeToBytes(xonly_public_key, 32, P);
+		if (parity) {
+			*parity = (int)(P[curve->num_words] & 1);
+		}
+	}
+	secp256k1_memclear(d, sizeof(d));
+	return ret;
+}
+
+int schnorr_sign(
+	uint8_t *signature,
+	const uint8_t *message,
+	size_t message_size,
+	const uint8_t *private_key,
+	const uint8_t *aux_rand
+) {
+	static const uint8_t zero_aux[32] = {0};
+	uECC_Curve curve = uECC_secp256k1();
+	uECC_word_t d[uECC_MAX_WORDS], k[uECC_MAX_WORDS], e[uECC_MAX_WORDS];
+	uECC_word_t P[uECC_MAX_WORDS * 2], R[uECC_MAX_WORDS * 2];
+	uint8_t px[32], t[32], hash[32];
+	secp256k1_sha256 sha;
+	wordcount_t num_words	= curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+	int ret					= 0;
+	int i;
+
+	if (!schnorr_keypair(d, P, private_key, curve)) {
+		goto done;
+	}
+	/* Sign with the key whose public point has an even y, the one the x-only key stands for. */
+	if (P[num_words] & 1) {
+		uECC_vli_sub(d, curve->n, d, num_n_words);
+	}
+	uECC_vli_nativeToBytes(px, 32, P);
+
+	/* t = bytes(d) xor hash_BIP0340/aux(a); k = int(hash_BIP0340/nonce(t || P.x || m)) mod n */
+	schnorr_tagged(&sha, schnorr_aux_midstate);
+	secp256k1_sha256_write(&sha, aux_rand ? aux_rand : zero_aux, 32);
+	secp256k1_sha256_finalize(&sha, hash);
+	uECC_vli_nativeToBytes(t, 32, d);
+	for (i = 0; i < 32; ++i) {
+		t[i] ^= hash[i];
+	}
+	schnorr_tagged(&sha, schnorr_nonce_midstate);
+	secp256k1_sha256_write(&sha, t, 32);
+	secp256k1_sha256_write(&sha, px, 32);
+	secp256k1_sha256_write(&sha, message, message_size);
+	secp256k1_sha256_finalize(&sha, hash);
+	schnorr_reduce(k, hash, curve);
+	if (uECC_vli_isZero(k, num_n_words) || !EccPoint_compute_public_key(R, k, curve)) {
+		goto done;
+	}
+	if (R[num_words] & 1) {
+		uECC_vli_sub(k, curve->n, k, num_n_words);
+	}
+
+	/* sig = bytes(R.x) || bytes((k + e*d) mod n) */
+	uECC_vli_nativeToBytes(signature, 32, R);
+	schnorr_challenge(e, signature, px, message, message_size, curve);
+	uECC_vli_modMult(e, e, d, curve->n, num_n_words);
+	uECC_vli_modAdd(e, e, k, curve->n, num_n_words);
+	uECC_vli_nativeToBytes(signature + 32, 32, e);
+	ret = 1;
+
+done:
+	secp256k1_memclear(d, sizeof(d));
+	secp256k1_memclear(k, sizeof(k));
+	secp256k1_memclear(t, sizeof(t));
+	secp256k1_memclear(hash, sizeof(hash));
+	return ret;
+}
+
+/* Reads r and s from signature, rejecting r >= p and s >= n. */
+static int schnorr_read_signature(uECC_word_t *r, uECC_word_t *s, const uint8_t *signature, uECC_Curve curve) {
+	uECC_vli_bytesToNative(r, signature, 32);
+	uECC_vli_bytesToNative(s, signature + 32, 32);
+	return uECC_vli_cmp_unsafe(curve->p, r, curve->num_words) == 1 &&
+		   uECC_vli_cmp_unsafe(curve->n, s, BITS_TO_WORDS(curve->num_n_bits)) == 1;
+}
+
+int schnorr_verify(
+	const uint8_t *signature,
+	const uint8_t *message,
+	size_t message_size,
+	const uint8_t *xonly_public_key
+) {
+	uECC_Curve curve = uECC_secp256k1();
+	uECC_word_t P[uECC_MAX_WORDS * 2], sum[uECC_MAX_WORDS * 2];
+	uECC_word_t r[uECC_MAX_WORDS], s[uECC_MAX_WORDS], e[uECC_MAX_WORDS];
+	uECC_word_t X[uECC_MAX_WORDS], Y[uECC_MAX_WORDS], Z[uECC_MAX_WORDS];
+	wordcount_t num_words	= curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+	if (!schnorr_lift_x(P, xonly_public_key, curve) || !schnorr_read_signature(r, s, signature, curve)) {
+		return 0;
+	}
+
+	/* R = s*G - e*P */
+	schnorr_challenge(e, signature, xonly_public_key, message, message_size, curve);
+	if (!uECC_vli_isZero(e, num_n_words)) {
+		uECC_vli_sub(e, curve->n, e, num_n_words);
+	}
+	if (uECC_vli_equal(P, curve->G, num_words)) {
+		/* P is G itself (G has an even y), which Shamir's trick cannot add to G; use (s - e)*G. */
+		uECC_vli_modAdd(s, s, e, curve->n, num_n_words);
+		uECC_vli_clear(e, num_n_words);
+		uECC_vli_set(sum, curve->G, num_words * 2);
+	} else {
+		EccPoint_add_G(sum, P, curve);
+	}
+	EccPoint_mult_shamir(X, Y, Z, s, e, P, sum, curve);
+	if (uECC_vli_isZero(Z, num_words)) {
+		return 0;
+	}
+	uECC_vli_modInv(Z, Z, curve->p, num_words);
+	apply_z(X, Y, Z, curve);
+
+	/* Accept only if R has an even y and R.x == r. */
+	return !(Y[0] & 1) && uECC_vli_equal(X, r, num_words);
+}
+
+int schnorr_verify_batch(
+	const uint8_t *signatures,
+	const uint8_t *messages,
+	size_t message_size,
+	const uint8_t *xonly_public_keys,
+	unsigned count,
+	uint8_t *valid
+) {
+	uECC_Curve curve = uECC_secp256k1();
+	EccPoint_msm_term terms[2 * SCHNORR_VERIFY_GROUP];
+	uECC_word_t scalars[2 * SCHNORR_VERIFY_GROUP][uECC_MAX_WORDS];
+	uECC_word_t R0[uECC_MAX_WORDS * 2];
+	uECC_word_t r[uECC_MAX_WORDS], s[uECC_MAX_WORDS];
+	uECC_word_t e[uECC_MAX_WORDS], a[uECC_MAX_WORDS];
+	uECC_word_t X[uECC_MAX_WORDS], Y[uECC_MAX_WORDS], Z[uECC_MAX_WORDS];
+	uint8_t ok[SCHNORR_VERIFY_GROUP];
+	uint8_t seed[32];
+	uint8_t weight[16];
+	secp256k1_sha256 sha;
+	unsigned done, i, t, used;
+	int batched;
+	int ret					= 1;
+	wordcount_t num_words	= curve->num_words;
+	wordcount_t num_n_words = BITS_TO_WORDS(curve->num_n_bits);
+
+	for (done = 0; done < count; done += SCHNORR_VERIFY_GROUP) {
+		unsigned chunk		= count - done < SCHNORR_VERIFY_GROUP ? count - done : SCHNORR_VERIFY_GROUP;
+		const uint8_t *sigs = signatures + (size_t)done * 64;
+		const uint8_t *msgs = messages + (size_t)done * message_size;
+		const uint8_t *keys = xonly_public_keys + (size_t)done * 32;
+
+		/* The weights are bound to every input of the group, so they cannot be chosen before
+		   the signatures they are meant to cancel. */
+		secp256k1_sha256_initialize(&sha);
+		secp256k1_sha256_write(&sha, sigs, (size_t)chunk * 64);
+		secp256k1_sha256_write(&sha, msgs, (size_t)chunk * message_size);
+		secp256k1_sha256_write(&sha, keys, (size_t)chunk * 32);
+		secp256k1_sha256_finalize(&sha, seed);
+
+		/* terms[0] is G; every signature adds its P and, after the first, its R. */
+		memset(ok, 0, sizeof(ok));
+		uECC_vli_clear(scalars[0], num_n_words);
+		t	 = 1;
+		used = 0;
+		for (i = 0; i < chunk; ++i) {
+			uECC_word_t *P = terms[t].table[0];
+			uECC_word_t *R = used ? terms[t + 1].table[0] : R0;
+
+			if (!schnorr_lift_x(P, keys + (size_t)i * 32, curve) ||
+				!schnorr_read_signature(r, s, sigs + (size_t)i * 64, curve) ||
+				!schnorr_lift_x(R, sigs + (size_t)i * 64, curve)) {
+				continue; /* left to schnorr_verify() */
+			}
+			ok[i] = 1;
+
+			if (used) {
+				secp256k1_sha256_batch_weight(weight, seed, i);
+				uECC_vli_clear(a, num_n_words);
+				uECC_vli_bytesToNative(a, weight, 16);
+			} else {
+				uECC_vli_clear(a, num_n_words);
+				a[0] = 1;
+			}
+			uECC_vli_modMult(s, s, a, curve->n, num_n_words);
+			uECC_vli_modAdd(scalars[0], scalars[0], s, curve->n, num_n_words);
+
+			schnorr_challenge(
+				e, sigs + (size_t)i * 64, keys + (size_t)i * 32, msgs + (size_t)i * message_size, message_size, curve
+			);
+			uECC_vli_modMult(scalars[t], e, a, curve->n, num_n_words);
+			if (!uECC_vli_isZero(scalars[t], num_n_words)) {
+				uECC_vli_sub(scalars[t], curve->n, scalars[t], num_n_words);
+			}
+			if (used) {
+				uECC_vli_sub(scalars[t + 1], curve->n, a, num_n_words);
+				t += 2;
+			} else {
+				t += 1;
+			}
+			++used;
+		}
+
+		batched = used != 0;
+		if (batched) {
+			uECC_vli_set(terms[0].table[0], curve->G, num_words * 2);
+			EccPoint_msm_init(terms, scalars, t, curve);
+			batched = EccPoint_msm(X, Y, Z, terms, t, curve);
+		}
+		if (batched) {
+			apply_z(R0, R0 + num_words, Z, curve);
+			batched = uECC_vli_equal(X, R0, num_words) && uECC_vli_equal(Y, R0 + num_words, num_words);
+		}
+
+		/* A failed group check only says that some signature is bad; find out which. */
+		for (i = 0; i < chunk; ++i) {
+			uint8_t v = batched && ok[i];
+			if (!v) {
+				v = (uint8_t)schnorr_verify(
+					sigs + (size_t)i * 64, msgs + (size_t)i * message_size, message_size, keys + (size_t)i * 32
+				);
+			}
+			if (valid) {
+				valid[done + i] = v;
+			}
+			ret &= v;
+		}
+	}
+	return ret;
+}
@@ -0,0 +1,64 @@
+//
+//  schnorr.h
+//
+//  Created by walteh on 2026-10-19.
+//  Copyright © 2026 Walter Scott. All rights reserved.
+// ---------------------------------------------------------------------
+//  adapted from bitcoin-core/secp256k1
+//  Copyright © 2020 Jonas Nick. MIT software license
+// ---------------------------------------------------------------------
+//
+//  BIP340 Schnorr signatures over secp256k1
+//
+
+#ifndef schnorr_h
+#define schnorr_h
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Number of signatures folded into one multi-scalar check by schnorr_verify_batch(). */
+#define SCHNORR_VERIFY_GROUP 16
+
+/* Computes the 32-byte x-only public key of private_key. parity, if not NULL, receives 1 if the
+   full public key has an odd y coordinate, in which case signing uses the negated key. Returns 1
+   on success, 0 if private_key is not a valid key. */
+int schnorr_xonly_public_key(uint8_t *xonly_public_key, int *parity, const uint8_t *private_key);
+
+/* Creates the 64-byte BIP340 signature of the message_size bytes of message. aux_rand is 32 bytes
+   of fresh randomness mixed into the nonce, or NULL for the all-zero value, which still gives
+   safe deterministic signatures. Returns 1 on success, 0 if private_key is not a valid key. */
+int schnorr_sign(
+	uint8_t *signature,
+	const uint8_t *message,
+	size_t message_size,
+	const uint8_t *private_key,
+	const uint8_t *aux_rand
+);
+
+/* Verifies a BIP340 signature against a 32-byte x-only public key. Returns 1 if the signature is
+   valid, 0 otherwise. */
+int schnorr_verify(
+	const uint8_t *signature,
+	const uint8_t *message,
+	size_t message_size,
+	const uint8_t *xonly_public_key
+);
+
+/* Verifies count signatures, each over message_size bytes, as schnorr_verify().
+
+   Up to SCHNORR_VERIFY_GROUP signatures are checked together with one multi-scalar
+   multiplication: with weights a_i derived from a hash of the whole group, a_0 = 1, the group is
+   accepted if (sum a_i*s_i)*G - sum a_i*e_i*P_i - sum_{i>0} a_i*R_i == R_0. A group that fails
+   falls back to single verification, so valid, if not NULL, receives the individual result of
+   every signature. Returns 1 if all signatures are valid, 0 otherwise. */
+int schnorr_verify_batch(
+	const uint8_t *signatures,
+	const uint8_t *messages,
+	size_t message_size,
+	const uint8_t *xonly_public_keys,
+	unsigned count,
+	uint8_t *valid
+);
+
+#endif /* schnorr_h */
@@ -43,9 +43,7 @@ public enum Strategy {
 		switch self {
 		case .Standard_SHA3_256: return { message in MicroDeterministicECDSA.hash(.SHA3, 256, message) }
 		case .EthereumRecoverable, .EthereumTransaction: return { message in MicroDeterministicECDSA.hash(.Keccak256, 256, message) }
-		case .EthereumMessage: return { message in
-				MicroDeterministicECDSA.hash(.Keccak256, 256, "\u{19}Ethereum Signed Message:\n\(message.count)".data(using: .ascii)! + message)
-			}
+		case .EthereumMessage: return { message in MicroDeterministicECDSA.hashEthereumMessage(message) }
 		}
 	}
 
@@ -106,6 +104,19 @@ public func hash(_ algo: HashingAlgorithm, _ bits: Int32, _ data: Data) -> Data
 	}
 }
 
+/// Keccak-256 of the signed-message prefix followed by message, streamed so the message is never copied.
+public func hashEthereumMessage(_ message: Data) -> Data {
+	let prefix = "\u{19}Ethereum Signed Message:\n\(message.count)".data(using: .ascii)!
+	var ctx = keccak256_ctx()
+	keccak256_init(&ctx)
+	prefix.withUnsafeBytes { keccak256_update(&ctx, $0.bindMemory(to: UInt8.self).baseAddress, $0.count) }
+	message.withUnsafeBytes { keccak256_update(&ctx, $0.bindMemory(to: UInt8.self).baseAddress, $0.count) }
+
+	var result = Data(count: 32)
+	result.withUnsafeMutableBytes { keccak256_final(&ctx, $0.bindMemory(to: UInt8.self).baseAddress) }
+	return result
+}
+
 public func sign(message: Data, privateKey: Data, on: Curve, as strategy: Strategy) throws -> Signature {
 	let sig: UnsafeMutablePointer<UInt8> = .allocate(capacity: 64)
 	defer { sig.deallocate() }
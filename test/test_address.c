@@ -0,0 +1,123 @@
+#include "../src/ecc/core.h"
+#include "../src/ethereum/address.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define KEYS 70
+
+static void from_hex(uint8_t *out, const char *hex) {
+	for (size_t i = 0; hex[2 * i]; i++) {
+		unsigned v;
+		sscanf(hex + 2 * i, "%2x", &v);
+		out[i] = (uint8_t)v;
+	}
+}
+
+int main() {
+	static const char *private_hex[] = {
+		"0000000000000000000000000000000000000000000000000000000000000001",
+		"0000000000000000000000000000000000000000000000000000000000000002",
+		"fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364140",
+		"c85ef7d79691fe79573b1a7064c19c1a9819ebdbd1faaab1a8ec92344438aaf4",
+		"0000000000000000000000000000000000000000000000000000000000000000",
+		"fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141",
+	};
+	static const char *checksummed[] = {
+		"0x7E5F4552091A69125d5DfCb7b8C2659029395Bdf",
+		"0x2B5AD5c4795c026514f8317c7a215E218DcCD6cF",
+		"0x80C0dbf239224071c59dD8970ab9d542E3414aB2",
+		"0xCD2a3d9F938E13CD947Ec05AbC7FE734Df8DD826",
+		"0x0000000000000000000000000000000000000000",
+		"0x0000000000000000000000000000000000000000",
+	};
+	static const char *eip55[] = {
+		"0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed",
+		"0xfB6916095ca1df60bB79Ce92cE3Ea74c37c5d359",
+		"0xdbF03B407c01E7cD3CBea99509d93f8DDDC8C6FB",
+		"0xD1220A0cf47c7B9Be7A2E6BA89F429762e7b9aDb",
+	};
+	uint8_t private_keys[KEYS][32], compressed[KEYS][33], raw[KEYS][64], uncompressed[KEYS][65];
+	uint8_t addresses[4][KEYS][20], valid[KEYS], bytes[4][20];
+	char hex[KEYS][ETHEREUM_ADDRESS_HEX_SIZE + 1];
+	int failed = 0;
+
+	// Private keys, including 1 and n - 1, whose keys are G and -G, and two invalid ones
+	for (int i = 0; i < 6; i++) {
+		from_hex(private_keys[i], private_hex[i]);
+	}
+	if (ethereum_addresses(addresses[0][0], private_keys[0], 6, ETHEREUM_KEY_PRIVATE, valid)) {
+		printf("Test failed: accepted invalid private keys\n");
+		failed = 1;
+	}
+	ethereum_addresses_to_hex(hex[0], addresses[0][0], 6);
+	for (int i = 0; i < 6; i++) {
+		if (valid[i] != (i < 4) || strcmp(hex[i], checksummed[i]) != 0) {
+			printf("Test failed: private key %d gave %s\n", i, hex[i]);
+			failed = 1;
+		}
+	}
+
+	// The checksum examples of EIP-55
+	for (int i = 0; i < 4; i++) {
+		from_hex(bytes[i], eip55[i] + 2);
+	}
+	ethereum_addresses_to_hex(hex[0], bytes[0], 4);
+	for (int i = 0; i < 4; i++) {
+		if (strcmp(hex[i], eip55[i]) != 0) {
+			printf("Test failed: checksummed %s as %s\n", eip55[i], hex[i]);
+			failed = 1;
+		}
+	}
+
+	// Every format gives the same addresses, across several batches
+	for (int i = 0; i < KEYS; i++) {
+		from_hex(private_keys[i], private_hex[3]);
+		private_keys[i][31] ^= (uint8_t)i;
+		private_keys[i][7] ^= (uint8_t)(i * 11);
+		uECC_compute_public_key(private_keys[i], raw[i], uECC_secp256k1());
+		uECC_compress(raw[i], compressed[i], uECC_secp256k1());
+		uncompressed[i][0] = 0x04;
+		memcpy(uncompressed[i] + 1, raw[i], 64);
+	}
+	if (!ethereum_addresses(addresses[0][0], private_keys[0], KEYS, ETHEREUM_KEY_PRIVATE, NULL) ||
+		!ethereum_addresses(addresses[1][0], compressed[0], KEYS, ETHEREUM_KEY_COMPRESSED, NULL) ||
+		!ethereum_addresses(addresses[2][0], raw[0], KEYS, ETHEREUM_KEY_RAW, NULL) ||
+		!ethereum_addresses(addresses[3][0], uncompressed[0], KEYS, ETHEREUM_KEY_UNCOMPRESSED, NULL)) {
+		printf("Test failed: rejected valid public keys\n");
+		failed = 1;
+	}
+	for (int f = 1; f < 4; f++) {
+		if (memcmp(addresses[f], addresses[0], sizeof(addresses[0])) != 0) {
+			printf("Test failed: format %d disagrees with the private keys\n", f);
+			failed = 1;
+		}
+	}
+	if (!ethereum_address(bytes[0], uncompressed[KEYS - 1], ETHEREUM_KEY_UNCOMPRESSED) ||
+		memcmp(bytes[0], addresses[0][KEYS - 1], 20) != 0) {
+		printf("Test failed: single address\n");
+		failed = 1;
+	}
+
+	// Malformed public keys in the middle of valid ones
+	compressed[1][0] = 0x05;
+	uncompressed[1][0] ^= 0x06;
+	raw[1][63] ^= 1;
+	if (ethereum_addresses(addresses[1][0], compressed[0], 3, ETHEREUM_KEY_COMPRESSED, valid) || valid[1] ||
+		!valid[0] || !valid[2] || ethereum_addresses(addresses[2][0], raw[0], 3, ETHEREUM_KEY_RAW, valid) ||
+		valid[1] || ethereum_addresses(addresses[3][0], uncompressed[0], 3, ETHEREUM_KEY_UNCOMPRESSED, valid) ||
+		valid[1]) {
+		printf("Test failed: accepted a malformed public key\n");
+		failed = 1;
+	}
+	memset(bytes[0], 0, 20);
+	if (memcmp(addresses[1][1], bytes[0], 20) != 0 || memcmp(addresses[1][2], addresses[0][2], 20) != 0) {
+		printf("Test failed: malformed keys disturbed the batch\n");
+		failed = 1;
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
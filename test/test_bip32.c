@@ -0,0 +1,117 @@
+#include "../src/bip32/bip32.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static void from_hex(uint8_t *out, const char *hex) {
+	for (size_t i = 0; hex[2 * i]; i++) {
+		unsigned v;
+		sscanf(hex + 2 * i, "%2x", &v);
+		out[i] = (uint8_t)v;
+	}
+}
+
+static int check_node(const char *label, const bip32_node *node, const char *chain, const char *key, const char *pub) {
+	uint8_t expected[33];
+	int ok = 1;
+	from_hex(expected, chain);
+	ok &= memcmp(node->chain_code, expected, 32) == 0;
+	from_hex(expected, key);
+	ok &= memcmp(node->private_key, expected, 32) == 0;
+	from_hex(expected, pub);
+	ok &= memcmp(node->public_key, expected, 33) == 0;
+	if (!ok) {
+		printf("Test failed: %s.\n", label);
+	}
+	return !ok;
+}
+
+enum { RANGE = 40 };
+
+int main() {
+	int failed = 0;
+	uint8_t seed[16];
+	bip32_node master, node, pub;
+	static bip32_node priv_children[RANGE], pub_children[RANGE];
+	uint8_t valid[RANGE];
+
+	// BIP32 test vector 1
+	from_hex(seed, "000102030405060708090a0b0c0d0e0f");
+	if (!bip32_from_seed(&master, seed, sizeof(seed))) {
+		printf("Test failed: master key.\n");
+		return 1;
+	}
+	failed |= check_node(
+		"m",
+		&master,
+		"873dff81c02f525623fd1fe5167eac3a55a049de3d314bb42ee227ffed37d508",
+		"e8f32e723decf4051aefac8e2c93c9c5b214313817cdb01a1494b917c8436b35",
+		"0339a36013301597daef41fbe593a02cc513d0b55527ec2df1050e2e8ff49c85c2"
+	);
+	if (!bip32_derive_path(&node, &master, "m/0'/1/2'/2/1000000000") || node.depth != 5 ||
+		node.child_number != 1000000000) {
+		printf("Test failed: path derivation.\n");
+		failed = 1;
+	}
+	failed |= check_node(
+		"m/0'/1/2'/2/1000000000",
+		&node,
+		"c783e67b921d2beb8f6b389cc646d7263b4145701dadd2161548a8b078e65e9e",
+		"471b76e389e528d6de6d816857e012c5455051cad6660850e58372a6c3e6e7c8",
+		"022a471424da5e657499d1ff51cb43c47481a03b1e77f951fe64cec9f5a48f7011"
+	);
+
+	// Public derivation of a range agrees with private derivation
+	bip32_derive_path(&node, &master, "m/0h/1");
+	failed |= check_node(
+		"m/0h/1",
+		&node,
+		"2a7857631386ba23dacac34180dd1983734e444fdbf774041578e9b6adb37c19",
+		"3c6cb8d0f6a264c91ea8b5030fadaa8e538b020f0a387421a12de9319dc93368",
+		"03501e454bf00751f24b1b489aa925215d66af2234e3891c3b21a52bedb3cd711c"
+	);
+	bip32_neuter(&pub, &node);
+	if (!bip32_derive_range(priv_children, &node, 0, RANGE, valid) ||
+		!bip32_derive_range(pub_children, &pub, 0, RANGE, valid)) {
+		printf("Test failed: range derivation.\n");
+		failed = 1;
+	}
+	for (int i = 0; i < RANGE; i++) {
+		bip32_node single;
+		bip32_derive_child(&single, &pub, (uint32_t)i);
+		if (memcmp(priv_children[i].public_key, pub_children[i].public_key, 33) != 0 ||
+			memcmp(priv_children[i].chain_code, pub_children[i].chain_code, 32) != 0 ||
+			memcmp(single.public_key, pub_children[i].public_key, 33) != 0 || pub_children[i].has_private) {
+			printf("Test failed: range child %d.\n", i);
+			failed = 1;
+		}
+	}
+
+	// Public keys cannot derive hardened children; malformed paths are rejected
+	if (bip32_derive_child(&node, &pub, BIP32_HARDENED) || bip32_derive_path(&node, &master, "m/0'/") ||
+		bip32_derive_path(&node, &master, "m/x") || bip32_derive_path(&node, &master, "m/2147483648") ||
+		bip32_derive_range(priv_children, &master, BIP32_HARDENED - 1, 2, valid)) {
+		printf("Test failed: invalid derivations accepted.\n");
+		failed = 1;
+	}
+
+	// A public parent with a malformed key derives nothing
+	bip32_neuter(&pub, &master);
+	pub.public_key[0] = 0x05;
+	memset(valid, 1, sizeof(valid));
+	if (bip32_derive_child(&node, &pub, 0) || bip32_derive_range(pub_children, &pub, 0, RANGE, valid)) {
+		printf("Test failed: child of an invalid public key.\n");
+		failed = 1;
+	}
+	for (int i = 0; i < RANGE; i++) {
+		if (valid[i] || pub_children[i].public_key[0] != 0) {
+			printf("Test failed: child %d of an invalid public key.\n", i);
+			failed = 1;
+		}
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
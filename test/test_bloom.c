@@ -0,0 +1,127 @@
+#include "../src/ethereum/bloom.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BLOOMS 500
+
+static uint8_t blooms[BLOOMS][BLOOM_SIZE];
+static size_t matches[BLOOMS];
+
+static void from_hex(uint8_t *out, const char *hex) {
+	for (size_t i = 0; hex[2 * i]; i++) {
+		unsigned v;
+		sscanf(hex + 2 * i, "%2x", &v);
+		out[i] = (uint8_t)v;
+	}
+}
+
+static uint32_t next(uint32_t *x) {
+	*x ^= *x << 13;
+	*x ^= *x >> 17;
+	*x ^= *x << 5;
+	return *x;
+}
+
+int main() {
+	// The nonzero bytes of the bloom of one ERC-20 Transfer log
+	static const uint8_t expected[][2] = {
+		{2, 0x04}, {50, 0x40}, {56, 0x10}, {75, 0x08}, {93, 0x80}, {123, 0x10}, {195, 0x02}, {216, 0x80}, {241, 0x10}
+	};
+	uint8_t address[20], topics[2][32], bloom[BLOOM_SIZE], other[BLOOM_SIZE], query[BLOOM_SIZE];
+	uint8_t items[70][32];
+	const uint8_t *pointers[70];
+	size_t sizes[70], count, expected_count;
+	uint32_t x = 1;
+	int failed = 0;
+
+	from_hex(address, "5aaeb6053f3e94c9b9a09f33669435e7ef1beaed");
+	from_hex(topics[0], "ddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef");
+	memset(topics[1], 0, 12);
+	memcpy(topics[1] + 12, address, 20);
+	memset(bloom, 0, BLOOM_SIZE);
+	memset(other, 0, BLOOM_SIZE);
+	for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+		other[expected[i][0]] = expected[i][1];
+	}
+	bloom_add_logs(bloom, address, 1, topics[0], 2);
+	if (memcmp(bloom, other, BLOOM_SIZE) != 0) {
+		printf("Test failed: Transfer log bloom\n");
+		failed = 1;
+	}
+
+	// Many items at once set the same bits as one at a time
+	memset(bloom, 0, BLOOM_SIZE);
+	memset(other, 0, BLOOM_SIZE);
+	for (int i = 0; i < 70; i++) {
+		for (int j = 0; j < 32; j++) {
+			items[i][j] = (uint8_t)next(&x);
+		}
+		pointers[i] = items[i];
+		sizes[i]	= i % 2 ? 32 : 20;
+		bloom_add(other, &pointers[i], &sizes[i], 1);
+	}
+	bloom_add(bloom, pointers, sizes, 70);
+	if (memcmp(bloom, other, BLOOM_SIZE) != 0) {
+		printf("Test failed: batched bloom\n");
+		failed = 1;
+	}
+	memset(other, 0, BLOOM_SIZE);
+	bloom_add_logs(other, items[0], 35, items[0], 35);
+	memset(bloom, 0, BLOOM_SIZE);
+	for (int i = 0; i < 70; i++) {
+		sizes[i]	= i < 35 ? 20 : 32;
+		pointers[i] = i < 35 ? items[0] + 20 * i : items[0] + 32 * (i - 35);
+	}
+	bloom_add(bloom, pointers, sizes, 70);
+	if (memcmp(bloom, other, BLOOM_SIZE) != 0) {
+		printf("Test failed: addresses and topics\n");
+		failed = 1;
+	}
+
+	// Blocks of random logs, every seventh also holding the Transfer log; the filter agrees with
+	// bloom_contains() and finds every block with the log
+	memset(query, 0, BLOOM_SIZE);
+	bloom_add_logs(query, address, 1, topics[0], 1);
+	expected_count = 0;
+	for (int i = 0; i < BLOOMS; i++) {
+		memset(blooms[i], 0, BLOOM_SIZE);
+		for (int log = 0; log < 1 + i % 30; log++) {
+			for (int j = 0; j < 32; j++) {
+				items[0][j] = (uint8_t)next(&x);
+				items[1][j] = (uint8_t)next(&x);
+			}
+			memset(bloom, 0, BLOOM_SIZE);
+			bloom_add_logs(bloom, items[0], 1, items[1], 1);
+			bloom_merge(blooms[i], bloom);
+		}
+		if (i % 7 == 0) {
+			memset(bloom, 0, BLOOM_SIZE);
+			bloom_add_logs(bloom, address, 1, topics[0], 2);
+			bloom_merge(blooms[i], bloom);
+		}
+	}
+	count = bloom_filter(matches, blooms[0], BLOOMS, query);
+	for (size_t i = 0, m = 0; i < BLOOMS; i++) {
+		if (bloom_contains(blooms[i], query)) {
+			if (m >= count || matches[m++] != i) {
+				printf("Test failed: filter missed block %zu\n", i);
+				failed = 1;
+				break;
+			}
+			expected_count++;
+		} else if (i % 7 == 0) {
+			printf("Test failed: block %zu does not contain its log\n", i);
+			failed = 1;
+		}
+	}
+	if (count != expected_count || count < (BLOOMS + 6) / 7) {
+		printf("Test failed: filter found %zu blocks, %zu expected\n", count, expected_count);
+		failed = 1;
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
@@ -0,0 +1,132 @@
+#include "../src/ethereum/create2.h"
+#include "../src/keccak256/keccak256.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static void from_hex(uint8_t *out, const char *hex) {
+	for (size_t i = 0; hex[2 * i]; i++) {
+		unsigned v;
+		sscanf(hex + 2 * i, "%2x", &v);
+		out[i] = (uint8_t)v;
+	}
+}
+
+/* The last byte is 0x42 and the first digit 7. */
+static int ends_in_42(void *user, const uint8_t *address) {
+	(void)user;
+	return address[19] == 0x42 && (address[0] & 0xf0) == 0x70;
+}
+
+static int check_search(
+	const char *name,
+	create2_predicate predicate,
+	void *user,
+	uint64_t max_attempts,
+	uint64_t attempt,
+	const char *salt_hex,
+	const char *address_hex
+) {
+	uint8_t deployer[20], init_code[4], init_code_hash[32], salt[32], expected_salt[32], expected[20], address[20];
+	create2_stats stats;
+	int failed = 0;
+
+	from_hex(deployer, "deadbeef00000000000000000000000000000000");
+	from_hex(init_code, "deadbeef");
+	keccak256_raw(init_code_hash, 32, init_code, 4, 1, 256);
+	if (salt_hex) {
+		from_hex(expected_salt, salt_hex);
+		from_hex(expected, address_hex);
+	}
+	for (unsigned threads = 1; threads <= 4; threads += 3) {
+		memset(salt, 0x11, 32);
+		if (create2_search(salt, address, deployer, init_code_hash, max_attempts, threads, predicate, user, &stats) !=
+			(salt_hex != NULL)) {
+			printf("Test failed: %s search with %u threads\n", name, threads);
+			failed = 1;
+		} else if (salt_hex && (memcmp(salt, expected_salt, 32) != 0 || memcmp(address, expected, 20) != 0)) {
+			printf("Test failed: %s search with %u threads found another salt\n", name, threads);
+			failed = 1;
+		} else if (stats.attempts <= attempt || (!salt_hex && stats.attempts != max_attempts)) {
+			printf("Test failed: %s search with %u threads counted %llu attempts\n",
+				   name,
+				   threads,
+				   (unsigned long long)stats.attempts);
+			failed = 1;
+		}
+	}
+	printf("%s: %.0f attempts per second\n", name, stats.attempts_per_second);
+	return failed;
+}
+
+int main() {
+	static const char *vectors[][4] = {
+		// deployer, salt, init code, address: the examples of EIP-1014
+		{"0000000000000000000000000000000000000000",
+		 "0000000000000000000000000000000000000000000000000000000000000000",
+		 "00",
+		 "4d1a2e2bb4f88f0250f26ffff098b0b30b26bf38"},
+		{"deadbeef00000000000000000000000000000000",
+		 "0000000000000000000000000000000000000000000000000000000000000000",
+		 "00",
+		 "b928f69bb1d91cd65274e3c79d8986362984fda3"},
+		{"00000000000000000000000000000000deadbeef",
+		 "00000000000000000000000000000000000000000000000000000000cafebabe",
+		 "deadbeef",
+		 "60f3f640a8508fc6a86d45df051962668e1e8ac7"},
+	};
+	uint8_t deployer[20], salt[32], init_code[4], init_code_hash[32], expected[20], address[20];
+	create2_pattern pattern;
+	int failed = 0;
+
+	for (int i = 0; i < 3; i++) {
+		from_hex(deployer, vectors[i][0]);
+		from_hex(salt, vectors[i][1]);
+		from_hex(init_code, vectors[i][2]);
+		from_hex(expected, vectors[i][3]);
+		keccak256_raw(init_code_hash, 32, init_code, strlen(vectors[i][2]) / 2, 1, 256);
+		create2_address(address, deployer, salt, init_code_hash);
+		if (memcmp(address, expected, 20) != 0) {
+			printf("Test failed: CREATE2 address %d\n", i);
+			failed = 1;
+		}
+	}
+
+	// Patterns
+	from_hex(expected, "c0dea0e8c5a481a4d1f4d7807c240daf616cf2eb");
+	if (!create2_pattern_prefix(&pattern, "0xC0dEa") || !create2_pattern_match(&pattern, expected) ||
+		!create2_pattern_prefix(&pattern, "c0dea0e8c5a481a4d1f4d7807c240daf616cf2eb") ||
+		!create2_pattern_match(&pattern, expected) || !create2_pattern_prefix(&pattern, "c0deb") ||
+		create2_pattern_match(&pattern, expected) || create2_pattern_prefix(&pattern, "c0dg") ||
+		create2_pattern_prefix(&pattern, "c0dea0e8c5a481a4d1f4d7807c240daf616cf2eb0")) {
+		printf("Test failed: patterns\n");
+		failed = 1;
+	}
+
+	// The lowest matching salt, whatever the number of threads
+	create2_pattern_prefix(&pattern, "c0de");
+	failed |= check_search(
+		"prefix",
+		create2_pattern_match,
+		&pattern,
+		UINT64_MAX,
+		62734,
+		"111111111111111111111111111111111111111f061211111111111111111111",
+		"c0dea0e8c5a481a4d1f4d7807c240daf616cf2eb"
+	);
+	failed |= check_search(
+		"predicate",
+		ends_in_42,
+		NULL,
+		100000,
+		1753,
+		"11111111111111111111111111111111111111ea171111111111111111111111",
+		"7dfb94eeacd44549fb130a7ad556384e7ca8e842"
+	);
+	failed |= check_search("exhausted", ends_in_42, NULL, 1000, 0, NULL, NULL);
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
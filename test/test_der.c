@@ -0,0 +1,104 @@
+#include "../src/rfc6979/der.h"
+#include "../src/rfc6979/sign.h"
+#include "../src/rfc6979/verify.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static void from_hex(uint8_t *out, const char *hex) {
+	for (size_t i = 0; hex[2 * i]; i++) {
+		unsigned v;
+		sscanf(hex + 2 * i, "%2x", &v);
+		out[i] = (uint8_t)v;
+	}
+}
+
+int main() {
+	uECC_Curve curve = uECC_secp256k1();
+	int failed		 = 0;
+	uint8_t sig[64], decoded[64], compact[64], der[SIGNATURE_DER_MAX_SIZE(32)], expected[64];
+	uint8_t private_key[32], public_key[64], hash[32];
+	size_t der_size;
+	uint8_t recid;
+
+	// EIP-2098 test vector with yParity = 1
+	from_hex(sig, "9328da16089fcba9bececa81663203989f2df5fe1faa6291a45381c81bd17f76"
+				  "139c6d6b623b42da56557e5e734a43dc83345ddfadec52cbe24d0cc64f550793");
+	from_hex(expected, "9328da16089fcba9bececa81663203989f2df5fe1faa6291a45381c81bd17f76"
+					   "939c6d6b623b42da56557e5e734a43dc83345ddfadec52cbe24d0cc64f550793");
+	if (!signature_compact_encode(compact, sig, 1, curve) || memcmp(compact, expected, 64) != 0) {
+		printf("Test failed: compact encode.\n");
+		failed = 1;
+	}
+	signature_compact_decode(decoded, &recid, compact, curve);
+	if (recid != 1 || memcmp(decoded, sig, 64) != 0) {
+		printf("Test failed: compact decode.\n");
+		failed = 1;
+	}
+
+	// DER round trips for signatures with and without padded integers
+	for (int i = 0; i < 32; i++) {
+		private_key[i] = (uint8_t)(i + 1);
+	}
+	compute_public_key_rfc6979(private_key, public_key, curve);
+	for (int m = 0; m < 16; m++) {
+		memset(hash, m, 32);
+		sign_rfc6979(private_key, hash, 32, &recid, sig, curve);
+		der_size = sizeof(der);
+		if (!signature_der_encode(der, &der_size, sig, curve) ||
+			!signature_der_decode_strict(decoded, der, der_size, curve) || memcmp(decoded, sig, 64) != 0 ||
+			!signature_der_decode_lax(decoded, der, der_size, curve) || memcmp(decoded, sig, 64) != 0) {
+			printf("Test failed: DER round trip for message %d.\n", m);
+			failed = 1;
+		}
+		if (!signature_is_low_s(sig, curve) || signature_normalize_s(sig, &recid, curve)) {
+			printf("Test failed: low s for message %d.\n", m);
+			failed = 1;
+		}
+	}
+
+	// High s: normalizing flips the recid and keeps the signature valid
+	uint8_t high[64];
+	uint8_t key[64];
+	memcpy(high, sig, 64);
+	from_hex(expected, "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141");
+	{
+		uECC_word_t n[uECC_MAX_WORDS], s[uECC_MAX_WORDS];
+		uECC_vli_bytesToNative(n, expected, 32);
+		uECC_vli_bytesToNative(s, sig + 32, 32);
+		uECC_vli_sub(s, n, s, 4);
+		uECC_vli_nativeToBytes(high + 32, 32, s);
+	}
+	uint8_t high_recid = recid ^ 1;
+	if (signature_is_low_s(high, curve) || !verify_rfc6979(public_key, hash, 32, high, curve) ||
+		signature_compact_encode(compact, high, 0, curve) || !signature_normalize_s(high, &high_recid, curve) ||
+		memcmp(high, sig, 64) != 0 || high_recid != recid || !recover_rfc6979(hash, 32, high, high_recid, key, curve) ||
+		memcmp(key, public_key, 64) != 0) {
+		printf("Test failed: normalize.\n");
+		failed = 1;
+	}
+
+	// Strict rejects what lax accepts
+	const uint8_t padded[] = {0x30, 0x08, 0x02, 0x03, 0x00, 0x00, 0x01, 0x02, 0x01, 0x02};
+	const uint8_t negative[] = {0x30, 0x06, 0x02, 0x01, 0x81, 0x02, 0x01, 0x02};
+	const uint8_t long_form[] = {0x30, 0x81, 0x06, 0x02, 0x81, 0x01, 0x01, 0x02, 0x01, 0x02};
+	const uint8_t trailing[] = {0x30, 0x06, 0x02, 0x01, 0x01, 0x02, 0x01, 0x02, 0x00};
+	const uint8_t *lax_only[] = {padded, negative, long_form, trailing};
+	const size_t lax_sizes[]  = {sizeof(padded), sizeof(negative), sizeof(long_form), sizeof(trailing)};
+	for (int i = 0; i < 4; i++) {
+		if (signature_der_decode_strict(decoded, lax_only[i], lax_sizes[i], curve) ||
+			!signature_der_decode_lax(decoded, lax_only[i], lax_sizes[i], curve)) {
+			printf("Test failed: DER strictness case %d.\n", i);
+			failed = 1;
+		}
+	}
+	if (!signature_der_decode_lax(decoded, padded, sizeof(padded), curve) || decoded[31] != 1 || decoded[63] != 2) {
+		printf("Test failed: lax values.\n");
+		failed = 1;
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
@@ -0,0 +1,126 @@
+#include "../src/hmac/hash.h"
+#include "../src/rfc6979/verify.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+enum { PEERS = 36 };
+
+int main() {
+	uECC_Curve curve = uECC_secp256k1();
+	int failed		 = 0;
+
+	static uint8_t peer_private[PEERS * 32], peer_raw[PEERS * 64], peer_compressed[PEERS * 33], peer_x[PEERS * 32];
+	static uint8_t secrets[PEERS * 32], valid[PEERS];
+	uint8_t private_key[32], public_key[64], compressed[33];
+	uint8_t expected[32], secret[32];
+	secp256k1_sha256 sha;
+
+	for (int i = 0; i < 32; i++) {
+		private_key[i] = (uint8_t)(0xa5 ^ i);
+	}
+	compute_public_key_rfc6979(private_key, public_key, curve);
+	uECC_compress(public_key, compressed, curve);
+	for (int m = 0; m < PEERS; m++) {
+		for (int i = 0; i < 32; i++) {
+			peer_private[m * 32 + i] = (uint8_t)(m * 9 + i + 1);
+		}
+		compute_public_key_rfc6979(peer_private + m * 32, peer_raw + m * 64, curve);
+		uECC_compress(peer_raw + m * 64, peer_compressed + m * 33, curve);
+		memcpy(peer_x + m * 32, peer_raw + m * 64, 32);
+	}
+
+	// Raw x matches uECC_shared_secret for every key form
+	uECC_shared_secret(peer_raw, private_key, expected, curve);
+	if (!uECC_ecdh(peer_raw, 64, private_key, uECC_ECDH_X, secret, curve) || memcmp(secret, expected, 32) != 0 ||
+		!uECC_ecdh(peer_compressed, 33, private_key, uECC_ECDH_X, secret, curve) || memcmp(secret, expected, 32) != 0 ||
+		!uECC_ecdh(peer_x, 32, private_key, uECC_ECDH_X, secret, curve) || memcmp(secret, expected, 32) != 0) {
+		printf("Test failed: raw x.\n");
+		failed = 1;
+	}
+
+	// Hashed x, and the compressed-point hash agrees from both sides
+	secp256k1_sha256_initialize(&sha);
+	secp256k1_sha256_write(&sha, expected, 32);
+	secp256k1_sha256_finalize(&sha, expected);
+	if (!uECC_ecdh(peer_x, 32, private_key, uECC_ECDH_SHA256_X, secret, curve) || memcmp(secret, expected, 32) != 0) {
+		printf("Test failed: hashed x.\n");
+		failed = 1;
+	}
+	uECC_ecdh(compressed, 33, peer_private, uECC_ECDH_SHA256_COMPRESSED, expected, curve);
+	if (!uECC_ecdh(peer_raw, 64, private_key, uECC_ECDH_SHA256_COMPRESSED, secret, curve) ||
+		memcmp(secret, expected, 32) != 0 ||
+		uECC_ecdh(peer_x, 32, private_key, uECC_ECDH_SHA256_COMPRESSED, secret, curve)) {
+		printf("Test failed: hashed compressed point.\n");
+		failed = 1;
+	}
+
+	// Batch agrees with the single path and flags broken keys
+	peer_compressed[4 * 33] = 0x05;
+	peer_compressed[30 * 33 + 1] ^= 0xff;
+	int batch_ok = uECC_ecdh_batch(
+		peer_compressed, 33, PEERS, private_key, uECC_ECDH_SHA256_COMPRESSED, secrets, valid, curve
+	);
+	for (int m = 0; m < PEERS; m++) {
+		const uint8_t *peer = peer_compressed + m * 33;
+		int expect_valid	= uECC_ecdh(peer, 33, private_key, uECC_ECDH_SHA256_COMPRESSED, secret, curve);
+		if (m == 4 && expect_valid) {
+			printf("Test failed: bad prefix accepted.\n");
+			failed = 1;
+		}
+		if (valid[m] != expect_valid || (expect_valid && memcmp(secrets + m * 32, secret, 32) != 0)) {
+			printf("Test failed: batch entry %d.\n", m);
+			failed = 1;
+		}
+	}
+	if (batch_ok) {
+		printf("Test failed: batch accepted invalid keys.\n");
+		failed = 1;
+	}
+
+	// The x-only ladder agrees with the co-Z one, entry for entry, on both curves
+	for (int c = 0; c < 2; c++) {
+		uECC_Curve other = c ? uECC_secp256r1() : curve;
+		static uint8_t keys[PEERS * 64], xz_secrets[PEERS * 32], xz_valid[PEERS];
+		for (int m = 0; m < PEERS; m++) {
+			compute_public_key_rfc6979(peer_private + m * 32, keys + m * 64, other);
+		}
+		keys[7 * 64 + 40] ^= 0x01;
+		uECC_ecdh_batch(keys, 64, PEERS, private_key, uECC_ECDH_SHA256_X, secrets, valid, other);
+		uECC_ecdh_batch(
+			keys, 64, PEERS, private_key, uECC_ECDH_SHA256_X | uECC_ECDH_XZ_LADDER, xz_secrets, xz_valid, other
+		);
+		if (memcmp(secrets, xz_secrets, sizeof(xz_secrets)) != 0 || memcmp(valid, xz_valid, PEERS) != 0 ||
+			xz_valid[7]) {
+			printf("Test failed: x-only ladder on curve %d.\n", c);
+			failed = 1;
+		}
+	}
+
+	// Private keys 1 and n - 1 give the peer's x, which only the x-only ladder can compute
+	{
+		static const uint8_t edge_keys[2][32] = {
+			{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1},
+			{0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe,
+			 0xba, 0xae, 0xdc, 0xe6, 0xaf, 0x48, 0xa0, 0x3b, 0xbf, 0xd2, 0x5e, 0x8c, 0xd0, 0x36, 0x41, 0x40},
+		};
+		for (int e = 0; e < 2; e++) {
+			if (!uECC_ecdh(peer_x, 32, edge_keys[e], uECC_ECDH_X | uECC_ECDH_XZ_LADDER, secret, curve) ||
+				memcmp(secret, peer_x, 32) != 0 || uECC_ecdh(peer_x, 32, edge_keys[e], uECC_ECDH_X, secret, curve)) {
+				printf("Test failed: edge private key %d.\n", e);
+				failed = 1;
+			}
+		}
+	}
+
+	// The x-only ladder has no point to compress
+	if (uECC_ecdh(peer_raw, 64, private_key, uECC_ECDH_SHA256_COMPRESSED | uECC_ECDH_XZ_LADDER, secret, curve)) {
+		printf("Test failed: compressed hash from the x-only ladder.\n");
+		failed = 1;
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
@@ -0,0 +1,202 @@
+#include "../src/ethereum/eip712.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static void from_hex(uint8_t *out, const char *hex) {
+	for (size_t i = 0; hex[2 * i]; i++) {
+		unsigned v;
+		sscanf(hex + 2 * i, "%2x", &v);
+		out[i] = (uint8_t)v;
+	}
+}
+
+static int check(const char *label, const uint8_t *actual, const char *hex) {
+	uint8_t expected[32];
+	from_hex(expected, hex);
+	if (memcmp(actual, expected, 32) != 0) {
+		printf("Test failed: %s\n", label);
+		return 1;
+	}
+	return 0;
+}
+
+static const eip712_member domain_members[] = {
+	{"name", "string"}, {"version", "string"}, {"chainId", "uint256"}, {"verifyingContract", "address"}
+};
+
+int main() {
+	int failed = 0;
+	uint8_t out[32], contract[20], cow[20], bob[20], dead[20], b0b[20], b0b0[20];
+	eip712_schema schema;
+	eip712_domain domain;
+	static const uint8_t one[] = {0x01};
+
+	from_hex(contract, "CcCCccccCCCCcCCCCCCcCcCccCcCCCcCcccccccC");
+	from_hex(cow, "CD2a3d9F938E13CD947Ec05AbC7FE734Df8DD826");
+	from_hex(bob, "bBbBBBBbbBBBbbbBbbBbbbbBBbBbbbbBbBbbBBbB");
+	from_hex(dead, "DeaDbeefdEAdbeefdEadbEEFdeadbeEFdEaDbeeF");
+	from_hex(b0b, "B0BdaBea57B0BDABeA57b0bdABEA57b0BDabEa57");
+	from_hex(b0b0, "B0B0b0b0b0b0B000000000000000000000000000");
+
+	eip712_value domain_items[] = {
+		EIP712_TEXT("Ether Mail"), EIP712_TEXT("1"), EIP712_DATA(one, 1), EIP712_DATA(contract, 20)
+	};
+	eip712_value domain_value = EIP712_ITEMS(domain_items, 4);
+
+	// The example of the EIP-712 specification
+	{
+		static const eip712_member person[] = {{"name", "string"}, {"wallet", "address"}};
+		static const eip712_member mail[]	= {{"from", "Person"}, {"to", "Person"}, {"contents", "string"}};
+		const eip712_type types[]			= {
+			  {"Mail", mail, 3}, {"EIP712Domain", domain_members, 4}, {"Person", person, 2}
+		  };
+
+		eip712_value from_items[] = {EIP712_TEXT("Cow"), EIP712_DATA(cow, 20)};
+		eip712_value to_items[]	  = {EIP712_TEXT("Bob"), EIP712_DATA(bob, 20)};
+		eip712_value mail_items[] = {
+			EIP712_ITEMS(from_items, 2), EIP712_ITEMS(to_items, 2), EIP712_TEXT("Hello, Bob!")
+		};
+		eip712_value message	  = EIP712_ITEMS(mail_items, 3);
+
+		if (!eip712_compile(&schema, types, 3) || !eip712_domain_init(&domain, &schema, &domain_value) ||
+			!eip712_hash_struct(out, &schema, eip712_find_type(&schema, "Mail"), &message)) {
+			printf("Test failed: the specification example was rejected\n");
+			return 1;
+		}
+		failed |= check(
+			"Mail typeHash", schema.type_hashes[0], "a0cedeb2dc280ba39b857546d74f5549c3a1d7bdc2dd96bf881f76108e23dac2"
+		);
+		failed |= check(
+			"domain separator", domain.separator, "f2cee375fa42b42143804025fc449deafd50cc031ca257e0b194a650a912090f"
+		);
+		failed |= check("Mail hashStruct", out, "c52c0ee5d84264471806290a3f2c4cecfc5490626bf912d01f240d7a274b371e");
+		eip712_digest(out, &domain, &schema, 0, &message);
+		failed |= check("Mail digest", out, "be609aee343fb3c4b28e1df9e632fca64fcfaede20f02e86244efddf30957bd2");
+	}
+
+	// Arrays of structs and of addresses, and every atomic type in a nested struct
+	{
+		static const eip712_member person[] = {{"name", "string"}, {"wallets", "address[]"}};
+		static const eip712_member mail[]	= {{"from", "Person"}, {"to", "Person[]"}, {"contents", "string"}};
+		static const eip712_member order[]	= {
+			 {"mail", "Mail"},
+			 {"delta", "int8"},
+			 {"salt", "bytes32"},
+			 {"flag", "bool"},
+			 {"grid", "uint16[2][]"},
+			 {"blob", "bytes"},
+			 {"small", "bytes3"},
+		 };
+		const eip712_type types[] = {
+			{"EIP712Domain", domain_members, 4}, {"Order", order, 7}, {"Person", person, 2}, {"Mail", mail, 3}
+		};
+		static const uint8_t minus_five[] = {0xfb}, yes[] = {1}, small[] = {0xab, 0xcd, 0xef};
+		static const uint8_t n0[] = {0}, n1[] = {1}, n2[] = {2}, n7[] = {7};
+		static const uint8_t n300[] = {1, 0x2c}, n65535[] = {0xff, 0xff};
+		uint8_t salt[32], blob[200];
+		int mail_type, order_type;
+
+		for (int i = 0; i < 200; i++) {
+			blob[i] = (uint8_t)i;
+			if (i < 32) {
+				salt[i] = (uint8_t)i;
+			}
+		}
+
+		eip712_value cow_wallets[]	= {EIP712_DATA(cow, 20), EIP712_DATA(dead, 20)};
+		eip712_value bob_wallets[]	= {EIP712_DATA(bob, 20), EIP712_DATA(b0b, 20), EIP712_DATA(b0b0, 20)};
+		eip712_value from_items[]	= {EIP712_TEXT("Cow"), EIP712_ITEMS(cow_wallets, 2)};
+		eip712_value bob_items[]	= {EIP712_TEXT("Bob"), EIP712_ITEMS(bob_wallets, 3)};
+		eip712_value to_list[]		= {EIP712_ITEMS(bob_items, 2)};
+		eip712_value mail_items[]	= {
+			  EIP712_ITEMS(from_items, 2), EIP712_ITEMS(to_list, 1), EIP712_TEXT("Hello, Bob!")
+		  };
+		eip712_value row0[]			= {EIP712_DATA(n1, 1), EIP712_DATA(n2, 1)};
+		eip712_value row1[]			= {EIP712_DATA(n65535, 2), EIP712_DATA(n0, 1)};
+		eip712_value row2[]			= {EIP712_DATA(n7, 1), EIP712_DATA(n300, 2)};
+		eip712_value grid[]			= {EIP712_ITEMS(row0, 2), EIP712_ITEMS(row1, 2), EIP712_ITEMS(row2, 2)};
+		eip712_value order_items[]	= {
+			 EIP712_ITEMS(mail_items, 3),
+			 EIP712_DATA(minus_five, 1),
+			 EIP712_DATA(salt, 32),
+			 EIP712_DATA(yes, 1),
+			 EIP712_ITEMS(grid, 3),
+			 EIP712_DATA(blob, 200),
+			 EIP712_DATA(small, 3),
+		 };
+		eip712_value mail_value	 = EIP712_ITEMS(mail_items, 3);
+		eip712_value order_value = EIP712_ITEMS(order_items, 7);
+
+		if (!eip712_compile(&schema, types, 4) || !eip712_domain_init(&domain, &schema, &domain_value)) {
+			printf("Test failed: the array schema was rejected\n");
+			return 1;
+		}
+		mail_type  = eip712_find_type(&schema, "Mail");
+		order_type = eip712_find_type(&schema, "Order");
+		if (!eip712_digest(out, &domain, &schema, mail_type, &mail_value)) {
+			printf("Test failed: Mail with arrays was rejected\n");
+			failed = 1;
+		}
+		failed |= check("Mail with arrays", out, "a85c2e2b118698e88db68a8105b794a8cc7cec074e89ef991cb4f5f533819cc2");
+		if (!eip712_digest(out, &domain, &schema, order_type, &order_value)) {
+			printf("Test failed: Order was rejected\n");
+			failed = 1;
+		}
+		failed |= check("Order", out, "c0dff7214bec6576f4710b19b1dd26213b5af01aead82d992a651ff4c4120856");
+
+		// Values that do not fit their types
+		{
+			static const uint8_t plus_128[] = {0x00, 0x80}, two[] = {2};
+			eip712_value bad_row[]			= {EIP712_DATA(n1, 1)};
+			order_items[1]					= (eip712_value)EIP712_DATA(plus_128, 2);
+			if (eip712_digest(out, &domain, &schema, order_type, &order_value)) {
+				printf("Test failed: accepted 128 as an int8\n");
+				failed = 1;
+			}
+			order_items[1] = (eip712_value)EIP712_DATA(minus_five, 1);
+			order_items[3] = (eip712_value)EIP712_DATA(two, 1);
+			if (eip712_digest(out, &domain, &schema, order_type, &order_value)) {
+				printf("Test failed: accepted 2 as a bool\n");
+				failed = 1;
+			}
+			order_items[3] = (eip712_value)EIP712_DATA(yes, 1);
+			grid[1]		   = (eip712_value)EIP712_ITEMS(bad_row, 1);
+			if (eip712_digest(out, &domain, &schema, order_type, &order_value)) {
+				printf("Test failed: accepted a uint16[2] of one element\n");
+				failed = 1;
+			}
+			grid[1]		   = (eip712_value)EIP712_ITEMS(row1, 2);
+			order_items[6] = (eip712_value)EIP712_DATA(salt, 4);
+			if (eip712_digest(out, &domain, &schema, order_type, &order_value)) {
+				printf("Test failed: accepted four bytes as a bytes3\n");
+				failed = 1;
+			}
+			order_items[6] = (eip712_value)EIP712_DATA(small, 3);
+			if (!eip712_digest(out, &domain, &schema, order_type, &order_value)) {
+				printf("Test failed: Order rejected after the rejections\n");
+				failed = 1;
+			}
+			failed |= check("Order again", out, "c0dff7214bec6576f4710b19b1dd26213b5af01aead82d992a651ff4c4120856");
+		}
+	}
+
+	// Schemas that cannot compile
+	{
+		static const eip712_member unknown[] = {{"to", "Account"}};
+		static const eip712_member wide[]	 = {{"value", "uint264"}};
+		static const eip712_member zero[]	 = {{"values", "uint8[0]"}};
+		const eip712_type bad[][1]			 = {{{"Unknown", unknown, 1}}, {{"Wide", wide, 1}}, {{"Zero", zero, 1}}};
+		for (int i = 0; i < 3; i++) {
+			if (eip712_compile(&schema, bad[i], 1)) {
+				printf("Test failed: compiled %s\n", bad[i][0].name);
+				failed = 1;
+			}
+		}
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
@@ -3,6 +3,47 @@
 #include <stdio.h>
 #include <string.h>
 
+static void from_hex(uint8_t *out, const char *hex) {
+	for (size_t i = 0; hex[2 * i]; i++) {
+		unsigned v;
+		sscanf(hex + 2 * i, "%2x", &v);
+		out[i] = (uint8_t)v;
+	}
+}
+
+// Lengths around the lane size and the 136-byte rate, over the bytes 7 * i + 1
+static int check_block_boundaries(void) {
+	static const struct {
+		size_t length;
+		const char *digest;
+	} vectors[] = {
+		{0, "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470"},
+		{1, "5fe7f977e71dba2ea1a68e21057beebb9be2ac30c6410aa38d4f3fbe41dcffd2"},
+		{7, "1eb981577b2375d7dd0359ecc85b47203b55c4d93cba44c2ae2bcdffb3b7a71a"},
+		{8, "b1b6aa05565f4a78622216360371679c8f4dcdb352106217eccce1a91fd53633"},
+		{135, "34bd7bed52ea092f88bc887256e7f06500ee814afa9a5566e22030af2ef1c5c0"},
+		{136, "2b31811a93dfc4bdc41b6aa7790e784b987c25a2c8a0e101cfa694552dc8ae39"},
+		{137, "a6103b089a404974c2b460048bfddd45108748fbdd9bad451f54d1fe95f8f284"},
+		{271, "3915ac0d86093104c62ea954228b28802e32a97eaaf854cccaaf526dd14f919e"},
+		{272, "415fd325cae3a2f957fea2770d710027317ced7e7266a59905102c14fdb9959a"},
+		{300, "c679632f366575cf2a1dad1f4a5de16e09def44390e346ad45cca63f4509c93f"},
+	};
+	uint8_t input[300], expected[32], output[32];
+	int failed = 0;
+
+	for (int i = 0; i < (int)sizeof(input); i++) {
+		input[i] = (uint8_t)(7 * i + 1);
+	}
+	for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+		from_hex(expected, vectors[i].digest);
+		if (keccak256_raw(output, 32, input, vectors[i].length, 1, 256) != 0 || memcmp(output, expected, 32) != 0) {
+			printf("Test failed: keccak256 of %zu bytes\n", vectors[i].length);
+			failed = 1;
+		}
+	}
+	return failed;
+}
+
 int main() {
 	// Test input data
 	const uint8_t input[] = "hello";
@@ -17,7 +58,7 @@ int main() {
 	int result = keccak256_raw(output, sizeof(output), input, strlen((const char *)input), 1, 256);
 
 	// Check the result
-	if (result == 0 && memcmp(output, expected_output, sizeof(output)) == 0) {
+	if (check_block_boundaries() == 0 && result == 0 && memcmp(output, expected_output, sizeof(output)) == 0) {
 		printf("Test passed.\n");
 		return 0;
 	} else {
@@ -0,0 +1,50 @@
+#include "../src/keccak256/keccak256.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MESSAGES 41
+
+int main() {
+	static const unsigned widths[] = {1, 4, 8};
+	static const size_t counts[]   = {0, 1, 3, 5, 9, MESSAGES};
+	uint8_t data[MESSAGES][420];
+	const uint8_t *inputs[MESSAGES];
+	size_t sizes[MESSAGES];
+	uint8_t expected[32 * MESSAGES], output[32 * MESSAGES];
+	int failed = 0;
+
+	// Lengths around the 136-byte rate mixed with short and empty messages
+	for (int m = 0; m < MESSAGES; m++) {
+		for (int i = 0; i < (int)sizeof(data[m]); i++) {
+			data[m][i] = (uint8_t)(m * 13 + i * 29 + 7);
+		}
+		inputs[m] = data[m];
+		sizes[m]  = (size_t)(m % 3 == 0 ? 135 + m % 5 : (m * 37) % 420);
+		keccak256_raw(expected + 32 * m, 32, inputs[m], sizes[m], 1, 256);
+	}
+
+	for (size_t w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+		for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+			memset(output, 0xaa, sizeof(output));
+			keccak256_batch_width(output, inputs, sizes, counts[c], widths[w]);
+			int overrun = counts[c] < MESSAGES && output[32 * counts[c]] != 0xaa;
+			if (memcmp(output, expected, 32 * counts[c]) != 0 || overrun) {
+				printf("Test failed: %zu messages over %u lanes\n", counts[c], widths[w]);
+				failed = 1;
+			}
+		}
+	}
+
+	memset(output, 0, sizeof(output));
+	keccak256_batch(output, inputs, sizes, MESSAGES);
+	if (memcmp(output, expected, sizeof(expected)) != 0) {
+		printf("Test failed: keccak256_batch with %u lanes\n", keccak256_batch_lanes());
+		failed = 1;
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
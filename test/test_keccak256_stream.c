@@ -0,0 +1,89 @@
+#include "../src/keccak256/keccak256.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static void from_hex(uint8_t *out, const char *hex) {
+	for (size_t i = 0; hex[2 * i]; i++) {
+		unsigned v;
+		sscanf(hex + 2 * i, "%2x", &v);
+		out[i] = (uint8_t)v;
+	}
+}
+
+int main() {
+	int failed = 0;
+	uint8_t input[700], expected[32], output[32];
+	keccak256_ctx ctx, prefix;
+
+	for (int i = 0; i < (int)sizeof(input); i++) {
+		input[i] = (uint8_t)(i * 31 + 5);
+	}
+
+	// Every length, fed in pieces of every size from 1 to 11 bytes
+	for (size_t length = 0; length < sizeof(input); length++) {
+		keccak256_raw(expected, 32, input, length, 1, 256);
+		for (size_t step = 1; step <= 11; step++) {
+			keccak256_init(&ctx);
+			for (size_t i = 0; i < length; i += step) {
+				keccak256_update(&ctx, input + i, length - i < step ? length - i : step);
+			}
+			keccak256_final(&ctx, output);
+			if (memcmp(output, expected, 32) != 0) {
+				printf("Test failed: %zu bytes in steps of %zu\n", length, step);
+				failed = 1;
+				break;
+			}
+		}
+	}
+
+	// A midstate cloned after every prefix length finishes two different messages
+	for (size_t split = 0; split <= 300; split++) {
+		keccak256_init(&prefix);
+		keccak256_update(&prefix, input, split);
+		for (size_t end = split + 150; end <= split + 400; end += 250) {
+			keccak256_clone(&ctx, &prefix);
+			keccak256_update(&ctx, input + split, end - split);
+			keccak256_final(&ctx, output);
+			keccak256_raw(expected, 32, input, end, 1, 256);
+			if (memcmp(output, expected, 32) != 0) {
+				printf("Test failed: midstate after %zu bytes\n", split);
+				failed = 1;
+			}
+		}
+	}
+
+	// The Ethereum signed-message hash, gathered from its prefix and the message
+	{
+		static const char prefix_text[] = "\x19"
+										  "Ethereum Signed Message:\n5";
+		keccak256_chunk chunks[2] = {
+			{(const uint8_t *)prefix_text, sizeof(prefix_text) - 1},
+			{(const uint8_t *)"hello", 5},
+		};
+		from_hex(expected, "50b2c43fd39106bafbba0da34fc430e1f91e3c96ea2acee2bc34119f92b37750");
+		keccak256_gather(output, chunks, 2);
+		if (memcmp(output, expected, 32) != 0) {
+			printf("Test failed: gathered Ethereum message hash\n");
+			failed = 1;
+		}
+	}
+
+	// Uneven chunks, including empty ones, across block boundaries
+	{
+		keccak256_chunk chunks[5] = {
+			{input, 3}, {input + 3, 0}, {input + 3, 200}, {input + 203, 133}, {input + 336, 364},
+		};
+		keccak256_raw(expected, 32, input, sizeof(input), 1, 256);
+		keccak256_gather(output, chunks, 5);
+		if (memcmp(output, expected, 32) != 0) {
+			printf("Test failed: uneven chunks\n");
+			failed = 1;
+		}
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
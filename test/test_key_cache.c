@@ -0,0 +1,110 @@
+#include "../src/rfc6979/key_cache.h"
+#include "../src/rfc6979/sign.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+enum { KEYS = 40 };
+
+static key_cache cache;
+static key_cache_entry entries[KEY_CACHE_SHARDS * 4];
+static key_cache small;
+static key_cache_entry small_entries[KEY_CACHE_SHARDS];
+static uint8_t raw[KEYS][64], compressed[KEYS][33], signatures[KEYS][64];
+
+int main() {
+	uECC_Curve curve = uECC_secp256k1();
+	uECC_word_t point[uECC_MAX_WORDS * 2], other[uECC_MAX_WORDS * 2];
+	uint8_t private_key[32], hash[32], bad[64], recid;
+	uint64_t hits, misses, evictions;
+	int failed = 0;
+
+	for (int i = 0; i < 32; i++) {
+		hash[i] = (uint8_t)(i * 3);
+	}
+	for (int k = 0; k < KEYS; k++) {
+		memset(private_key, k + 1, 32);
+		compute_public_key_rfc6979(private_key, raw[k], curve);
+		uECC_compress(raw[k], compressed[k], curve);
+		sign_rfc6979(private_key, hash, 32, &recid, signatures[k], curve);
+	}
+	if (!key_cache_init(&cache, entries, sizeof(entries) / sizeof(entries[0]), curve) ||
+		!key_cache_init(&small, small_entries, KEY_CACHE_SHARDS, curve)) {
+		printf("Test failed: init.\n");
+		return 1;
+	}
+
+	// Raw and compressed forms are cached apart but give the same point, cached the second time
+	for (int pass = 0; pass < 2; pass++) {
+		if (!key_cache_lookup(&cache, raw[0], 64, point, NULL) ||
+			!key_cache_lookup(&cache, compressed[0], 33, other, NULL) ||
+			memcmp(point, other, sizeof(point)) != 0) {
+			printf("Test failed: raw and compressed keys on pass %d.\n", pass);
+			failed = 1;
+		}
+	}
+	key_cache_stats(&cache, &hits, &misses, &evictions);
+	if (hits != 2 || misses != 2) {
+		printf("Test failed: counters after lookups.\n");
+		failed = 1;
+	}
+
+	// Invalid keys are rejected every time, never from the cache
+	memcpy(bad, raw[0], 64);
+	bad[63] ^= 1;
+	for (int pass = 0; pass < 2; pass++) {
+		if (key_cache_lookup(&cache, bad, 64, point, NULL) || key_cache_lookup(&cache, bad, 33, point, NULL) ||
+			key_cache_lookup(&cache, raw[0], 65, point, NULL)) {
+			printf("Test failed: accepted an invalid key on pass %d.\n", pass);
+			failed = 1;
+		}
+	}
+	key_cache_stats(&cache, &hits, &misses, NULL);
+	if (hits != 2) {
+		printf("Test failed: an invalid key was cached.\n");
+		failed = 1;
+	}
+
+	// Verification agrees with verify_rfc6979() in both forms, for good and bad signatures, with one
+	// entry per shard so that keys keep evicting each other
+	for (int pass = 0; pass < 2; pass++) {
+		for (int k = 0; k < KEYS; k++) {
+			uint8_t signature[64];
+			memcpy(signature, signatures[k], 64);
+			signature[k % 64] ^= (uint8_t)(k % 3 == 0);
+			int expected = verify_rfc6979(raw[k], hash, 32, signature, curve);
+			if (verify_rfc6979_key_cached(&small, raw[k], 64, hash, 32, signature) != expected ||
+				verify_rfc6979_key_cached(&small, compressed[k], 33, hash, 32, signature) != expected ||
+				verify_rfc6979_key_cached(&cache, compressed[k], 33, hash, 32, signature) != expected ||
+				expected != (k % 3 != 0)) {
+				printf("Test failed: verification of key %d on pass %d.\n", k, pass);
+				failed = 1;
+			}
+		}
+	}
+	key_cache_stats(&small, &hits, &misses, &evictions);
+	if (hits + misses != 4 * KEYS || evictions == 0 || evictions + KEY_CACHE_SHARDS < misses) {
+		printf("Test failed: evictions in full shards.\n");
+		failed = 1;
+	}
+
+	// Cleared entries are parsed again
+	{
+		uint64_t before;
+		key_cache_clear(&cache);
+		key_cache_stats(&cache, NULL, &before, NULL);
+		key_cache_lookup(&cache, raw[0], 64, point, NULL);
+		key_cache_stats(&cache, NULL, &misses, NULL);
+		if (misses != before + 1) {
+			printf("Test failed: hit after clear.\n");
+			failed = 1;
+		}
+	}
+
+	key_cache_destroy(&cache);
+	key_cache_destroy(&small);
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
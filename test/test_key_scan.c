@@ -0,0 +1,144 @@
+#include "../src/ecc/vli.h"
+#include "../src/keccak256/keccak256.h"
+#include "../src/rfc6979/verify.h"
+#include "../src/scan/key_scan.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+enum { COUNT = 100, PARALLEL_COUNT = 1000 };
+
+static void add_u32(uint8_t *key, uint32_t value) {
+	for (int i = 31; i >= 0 && value; i--) {
+		value += key[i];
+		key[i] = (uint8_t)value;
+		value >>= 8;
+	}
+}
+
+static uint8_t parallel_keys[PARALLEL_COUNT * 64];
+static uint8_t parallel_addresses[PARALLEL_COUNT * 20];
+
+static int collect(void *user, uint64_t offset, unsigned count, const uint8_t *public_keys, const uint8_t *addresses) {
+	(void)user;
+	memcpy(parallel_keys + offset * 64, public_keys, (size_t)count * 64);
+	memcpy(parallel_addresses + offset * 20, addresses, (size_t)count * 20);
+	return 0;
+}
+
+static int stop(void *user, uint64_t offset, unsigned count, const uint8_t *public_keys, const uint8_t *addresses) {
+	(void)offset, (void)count, (void)public_keys, (void)addresses;
+	return ++*(int *)user >= 3;
+}
+
+int main() {
+	uECC_Curve curve = uECC_secp256k1();
+	int failed		 = 0;
+	key_scan_context context;
+
+	static uint8_t keys[COUNT * 64], addresses[COUNT * 20], expected[64], hash[32];
+	uint8_t start[32], key[32];
+
+	if (!key_scan_init(&context, curve)) {
+		printf("Test failed: init.\n");
+		return 1;
+	}
+
+	// From key 1 through the table prefix into the block additions; key 1 is G itself
+	memset(start, 0, 32);
+	start[31] = 1;
+	if (!key_scan_range(&context, start, COUNT, keys, addresses)) {
+		printf("Test failed: scan from 1.\n");
+		failed = 1;
+	}
+	uECC_vli_nativeToBytes(expected, 32, curve->G);
+	uECC_vli_nativeToBytes(expected + 32, 32, curve->G + curve->num_words);
+	if (memcmp(keys, expected, 64) != 0) {
+		printf("Test failed: key 1.\n");
+		failed = 1;
+	}
+	memcpy(key, start, 32);
+	for (int i = 1; i < COUNT; i++) {
+		add_u32(key, 1);
+		compute_public_key_rfc6979(key, expected, curve);
+		keccak256_raw(hash, 32, expected, 64, 1, 256);
+		if (memcmp(keys + i * 64, expected, 64) != 0 || memcmp(addresses + i * 20, hash + 12, 20) != 0) {
+			printf("Test failed: key %d.\n", i + 1);
+			failed = 1;
+		}
+	}
+
+	// An arbitrary start
+	for (int i = 0; i < 32; i++) {
+		start[i] = (uint8_t)(i * 37 + 11);
+	}
+	if (!key_scan_range(&context, start, COUNT, keys, NULL)) {
+		printf("Test failed: scan from an arbitrary key.\n");
+		failed = 1;
+	}
+	memcpy(key, start, 32);
+	for (int i = 0; i < COUNT; i++) {
+		compute_public_key_rfc6979(key, expected, curve);
+		if (memcmp(keys + i * 64, expected, 64) != 0) {
+			printf("Test failed: arbitrary key %d.\n", i);
+			failed = 1;
+		}
+		add_u32(key, 1);
+	}
+
+	// Split over threads, each slice reported block by block
+	if (!key_scan_parallel(&context, start, PARALLEL_COUNT, 4, 1, collect, NULL)) {
+		printf("Test failed: parallel scan.\n");
+		failed = 1;
+	}
+	memcpy(key, start, 32);
+	for (int i = 0; i < PARALLEL_COUNT; i += 97) {
+		compute_public_key_rfc6979(key, expected, curve);
+		keccak256_raw(hash, 32, expected, 64, 1, 256);
+		if (memcmp(parallel_keys + i * 64, expected, 64) != 0 ||
+			memcmp(parallel_addresses + i * 20, hash + 12, 20) != 0) {
+			printf("Test failed: parallel key %d.\n", i);
+			failed = 1;
+		}
+		add_u32(key, 97);
+	}
+	int calls = 0;
+	if (key_scan_parallel(&context, start, PARALLEL_COUNT, 1, 0, stop, &calls) || calls != 3) {
+		printf("Test failed: stopping a scan.\n");
+		failed = 1;
+	}
+
+	// The range may end at n - 1, whose point is -G, but not go past it
+	const uint8_t n_minus_40[32] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+									0xff, 0xff, 0xff, 0xff, 0xfe, 0xba, 0xae, 0xdc, 0xe6, 0xaf, 0x48,
+									0xa0, 0x3b, 0xbf, 0xd2, 0x5e, 0x8c, 0xd0, 0x36, 0x41, 0x19};
+	if (!key_scan_range(&context, n_minus_40, 40, keys, NULL) || key_scan_range(&context, n_minus_40, 41, keys, NULL)) {
+		printf("Test failed: end of the range.\n");
+		failed = 1;
+	}
+	uECC_word_t minus_y[4];
+	uECC_vli_sub(minus_y, curve->p, curve->G + curve->num_words, curve->num_words);
+	uECC_vli_nativeToBytes(expected, 32, curve->G);
+	uECC_vli_nativeToBytes(expected + 32, 32, minus_y);
+	if (memcmp(keys + 39 * 64, expected, 64) != 0) {
+		printf("Test failed: key n - 1.\n");
+		failed = 1;
+	}
+	memcpy(key, n_minus_40, 32);
+	compute_public_key_rfc6979(key, expected, curve);
+	if (memcmp(keys, expected, 64) != 0) {
+		printf("Test failed: key n - 40.\n");
+		failed = 1;
+	}
+
+	memset(start, 0, 32);
+	if (key_scan_range(&context, start, 1, keys, NULL) || key_scan_range(&context, n_minus_40, 0, keys, NULL)) {
+		printf("Test failed: empty or zero range accepted.\n");
+		failed = 1;
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
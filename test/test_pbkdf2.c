@@ -0,0 +1,91 @@
+#include "../src/bip32/bip39.h"
+#include "../src/hmac/pbkdf2.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static void from_hex(uint8_t *out, const char *hex) {
+	for (size_t i = 0; hex[2 * i]; i++) {
+		unsigned v;
+		sscanf(hex + 2 * i, "%2x", &v);
+		out[i] = (uint8_t)v;
+	}
+}
+
+int main() {
+	int failed = 0;
+	uint8_t out[100], expected[100], seeds[64 * 5], seed[64];
+
+	// One iteration and a two-block output that is not a multiple of 64 bytes
+	from_hex(expected, "867f70cf1ade02cff3752599a3a53dc4af34c7a669815ae5d513554e1c8cf252"
+					   "c02d470a285a0501bad999bfe943c08f050235d7d68b1da55e63f73b60a57fce");
+	pbkdf2_hmac_sha512((const uint8_t *)"password", 8, (const uint8_t *)"salt", 4, 1, out, 64);
+	if (memcmp(out, expected, 64) != 0) {
+		printf("Test failed: one iteration.\n");
+		failed = 1;
+	}
+	from_hex(expected, "e1d9c16aa681708a45f5c7c4e215ceb66e011a2e9f0040713f18aefdb866d53c"
+					   "f76cab2868a39b9f7840edce4fef5a82be67335c77a6068e04112754f27ccf4e"
+					   "473e311ad827b68945f4e2dddb204c78e40e2495141e411cd272d020640d673c"
+					   "d34aa29f");
+	pbkdf2_hmac_sha512((const uint8_t *)"password", 8, (const uint8_t *)"salt", 4, 2, out, 100);
+	if (memcmp(out, expected, 100) != 0) {
+		printf("Test failed: two blocks.\n");
+		failed = 1;
+	}
+
+	// BIP39 reference vectors
+	const char *mnemonics[5] = {
+		"abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about",
+		"legal winner thank year wave sausage worth useful legal winner thank yellow",
+		"abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about",
+		"legal winner thank year wave sausage worth useful legal winner thank yellow",
+		"abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about",
+	};
+	const char *passphrases[5] = {"TREZOR", "TREZOR", NULL, "TREZOR", ""};
+	const char *seed_hex[3]	   = {
+		   "c55257c360c07c72029aebc1b53c05ed0362ada38ead3e3e9efa3708e53495531f09a6987599d18264c1e1c92f2cf141"
+		   "630c7a3c4ab7c81b2f001698e7463b04",
+		   "2e8905819b8723fe2c1d161860e5ee1830318dbf49a83bd451cfb8440c28bd6fa457fe1296106559a3c80937a1c1069be3"
+		   "a3a5bd381ee6260e8d9739fce1f607",
+		   "5eb00bbddcf069084889a8ab9155568165f5c453ccb85e70811aaed6f6da5fc19a5ac40b389cd370d086206dec8aa6c43d"
+		   "aea6690f20ad3d8d48b2d2ce9e38e4",
+	   };
+	const int seed_of[5] = {0, 1, 2, 1, 2};
+
+	if (!bip39_mnemonic_to_seed(seed, mnemonics[0], "TREZOR")) {
+		printf("Test failed: seed.\n");
+		failed = 1;
+	}
+	from_hex(expected, seed_hex[0]);
+	if (memcmp(seed, expected, 64) != 0) {
+		printf("Test failed: seed value.\n");
+		failed = 1;
+	}
+
+	// Five seeds fill one group of lanes and part of the next
+	if (!bip39_mnemonic_to_seed_multi(seeds, mnemonics, passphrases, 5)) {
+		printf("Test failed: multi seed.\n");
+		failed = 1;
+	}
+	for (int i = 0; i < 5; i++) {
+		from_hex(expected, seed_hex[seed_of[i]]);
+		if (memcmp(seeds + 64 * i, expected, 64) != 0) {
+			printf("Test failed: multi seed %d.\n", i);
+			failed = 1;
+		}
+	}
+
+	char long_passphrase[BIP39_PASSPHRASE_MAX + 2];
+	memset(long_passphrase, 'a', sizeof(long_passphrase) - 1);
+	long_passphrase[sizeof(long_passphrase) - 1] = 0;
+	if (bip39_mnemonic_to_seed(seed, mnemonics[0], long_passphrase)) {
+		printf("Test failed: long passphrase accepted.\n");
+		failed = 1;
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
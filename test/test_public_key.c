@@ -0,0 +1,111 @@
+#include "../src/rfc6979/verify.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+enum { COUNT = 24 };
+
+int main() {
+	uECC_Curve curve = uECC_secp256k1();
+	int failed		 = 0;
+
+	static uint8_t keys[COUNT * 64], compressed[COUNT * 33], decompressed[COUNT * 64], valid[COUNT];
+	static uint8_t private_keys[COUNT * 32], derived[COUNT * 64];
+
+	for (int m = 0; m < COUNT; m++) {
+		for (int i = 0; i < 32; i++) {
+			private_keys[m * 32 + i] = (uint8_t)(m * 5 + i + 1);
+		}
+		compute_public_key_rfc6979(private_keys + m * 32, keys + m * 64, curve);
+		uECC_compress(keys + m * 64, compressed + m * 33, curve);
+	}
+
+	// Batch derivation matches the single path, raw and compressed
+	if (!compute_public_key_rfc6979_batch(private_keys, COUNT, 0, derived, valid, curve) ||
+		memcmp(derived, keys, sizeof(keys)) != 0 ||
+		!compute_public_key_rfc6979_batch(private_keys, COUNT, 1, derived, valid, curve) ||
+		memcmp(derived, compressed, sizeof(compressed)) != 0) {
+		printf("Test failed: batch derivation.\n");
+		failed = 1;
+	}
+	// Key 0 is out of range and may not spoil the shared inversion; 1 and n - 1, which the ladder
+	// cannot compute, give G and -G on both paths
+	const uint8_t n_minus_1[32] = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+								   0xff, 0xff, 0xff, 0xff, 0xfe, 0xba, 0xae, 0xdc, 0xe6, 0xaf, 0x48,
+								   0xa0, 0x3b, 0xbf, 0xd2, 0x5e, 0x8c, 0xd0, 0x36, 0x41, 0x40};
+	const uint8_t G[33] = {0x02, 0x79, 0xbe, 0x66, 0x7e, 0xf9, 0xdc, 0xbb, 0xac, 0x55, 0xa0, 0x62,
+						   0x95, 0xce, 0x87, 0x0b, 0x07, 0x02, 0x9b, 0xfc, 0xdb, 0x2d, 0xce, 0x28,
+						   0xd9, 0x59, 0xf2, 0x81, 0x5b, 0x16, 0xf8, 0x17, 0x98};
+	uint8_t edge[64], edge_compressed[33];
+	memset(private_keys + 6 * 32, 0, 32);
+	memset(private_keys + 9 * 32, 0, 32);
+	private_keys[9 * 32 + 31] = 1;
+	memcpy(private_keys + 10 * 32, n_minus_1, 32);
+	if (compute_public_key_rfc6979_batch(private_keys, COUNT, 1, derived, valid, curve) || valid[6] || !valid[5] ||
+		!valid[9] || !valid[10] || memcmp(derived + 7 * 33, compressed + 7 * 33, 33) != 0 ||
+		memcmp(derived + 9 * 33, G, 33) != 0 || derived[10 * 33] != 0x03 ||
+		memcmp(derived + 10 * 33 + 1, G + 1, 32) != 0 || memcmp(derived + 11 * 33, compressed + 11 * 33, 33) != 0) {
+		printf("Test failed: batch derivation of edge and invalid keys.\n");
+		failed = 1;
+	}
+	for (int m = 9; m <= 10; m++) {
+		if (!compute_public_key_rfc6979(private_keys + m * 32, edge, curve)) {
+			printf("Test failed: single derivation of edge key %d.\n", m);
+			failed = 1;
+			continue;
+		}
+		uECC_compress(edge, edge_compressed, curve);
+		if (memcmp(edge_compressed, derived + m * 33, 33) != 0) {
+			printf("Test failed: single and batch derivation of edge key %d disagree.\n", m);
+			failed = 1;
+		}
+	}
+
+	// Round trip through the single and the batch path
+	if (!uECC_decompress(compressed, decompressed, curve) || memcmp(decompressed, keys, 64) != 0) {
+		printf("Test failed: decompress.\n");
+		failed = 1;
+	}
+	if (!uECC_decompress_batch(compressed, COUNT, decompressed, valid, curve) ||
+		memcmp(decompressed, keys, sizeof(keys)) != 0) {
+		printf("Test failed: batch decompress.\n");
+		failed = 1;
+	}
+	if (!uECC_valid_public_key_batch(keys, COUNT, valid, curve)) {
+		printf("Test failed: batch rejected valid keys.\n");
+		failed = 1;
+	}
+
+	// Bad prefix, x = 5 is not on secp256k1, x >= p
+	compressed[3 * 33] = 0x04;
+	memset(compressed + 8 * 33 + 1, 0, 32);
+	compressed[8 * 33 + 32] = 5;
+	memset(compressed + 12 * 33 + 1, 0xff, 32);
+	if (uECC_decompress_batch(compressed, COUNT, decompressed, valid, curve)) {
+		printf("Test failed: batch decompressed invalid keys.\n");
+		failed = 1;
+	}
+	for (int m = 0; m < COUNT; m++) {
+		int expect_valid = m != 3 && m != 8 && m != 12;
+		if (valid[m] != expect_valid || (expect_valid && memcmp(decompressed + m * 64, keys + m * 64, 64) != 0)) {
+			printf("Test failed: batch decompress entry %d.\n", m);
+			failed = 1;
+		}
+	}
+	keys[17 * 64 + 63] ^= 1;
+	if (uECC_valid_public_key_batch(keys, COUNT, valid, curve)) {
+		printf("Test failed: batch accepted an invalid key.\n");
+		failed = 1;
+	}
+	for (int m = 0; m < COUNT; m++) {
+		if (valid[m] != (m != 17)) {
+			printf("Test failed: batch validation entry %d.\n", m);
+			failed = 1;
+		}
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
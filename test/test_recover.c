@@ -0,0 +1,151 @@
+#include "../src/keccak256/keccak256.h"
+#include "../src/rfc6979/sign.h"
+#include "../src/rfc6979/verify.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static void print_hex(const char *label, const uint8_t *data, size_t len) {
+	printf("%s: ", label);
+	for (size_t i = 0; i < len; i++) {
+		printf("%02x", data[i]);
+	}
+	printf("\n");
+}
+
+int main() {
+	uECC_Curve curve = uECC_secp256k1();
+	int failed		 = 0;
+
+	// Ethereum personal message "hello" signed with the key used by the Swift tests
+	// 9132d6636365fae74dc42f75f9d8fecadb5501bfea7cc30ca97535668fc473f1
+	// 0611fd476150a39b64d1a7b4cca564d756a76673be3cc64e4dc8cd7423831900 v = 27
+	const uint8_t message[]		 = "\x19" "Ethereum Signed Message:\n5hello";
+	const uint8_t signature[64]	 = {0x91, 0x32, 0xd6, 0x63, 0x63, 0x65, 0xfa, 0xe7, 0x4d, 0xc4, 0x2f, 0x75, 0xf9,
+									0xd8, 0xfe, 0xca, 0xdb, 0x55, 0x01, 0xbf, 0xea, 0x7c, 0xc3, 0x0c, 0xa9, 0x75,
+									0x35, 0x66, 0x8f, 0xc4, 0x73, 0xf1, 0x06, 0x11, 0xfd, 0x47, 0x61, 0x50, 0xa3,
+									0x9b, 0x64, 0xd1, 0xa7, 0xb4, 0xcc, 0xa5, 0x64, 0xd7, 0x56, 0xa7, 0x66, 0x73,
+									0xbe, 0x3c, 0xc6, 0x4e, 0x4d, 0xc8, 0xcd, 0x74, 0x23, 0x83, 0x19, 0x00};
+	const uint8_t expected_address[20] = {0xab, 0xa7, 0x92, 0x10, 0xc7, 0x5e, 0x82, 0xda, 0xeb, 0x27,
+										  0x53, 0xca, 0x82, 0xa7, 0xa4, 0x1f, 0x3d, 0xb0, 0x5d, 0x78};
+	uint8_t hash[32];
+	uint8_t public_key[64];
+	uint8_t address[32];
+
+	keccak256_raw(hash, 32, message, sizeof(message) - 1, 1, 256);
+	if (!recover_rfc6979(hash, 32, signature, 27 - 27, public_key, curve)) {
+		printf("Test failed: recovery rejected a valid signature.\n");
+		failed = 1;
+	} else {
+		keccak256_raw(address, 32, public_key, 64, 1, 256);
+		if (memcmp(address + 12, expected_address, 20) != 0) {
+			printf("Test failed: recovered the wrong key.\n");
+			print_hex("Expected address", expected_address, 20);
+			print_hex("Actual address", address + 12, 20);
+			failed = 1;
+		}
+	}
+
+	// Round trip: every signature must recover the signing key and carry a low s
+	uint8_t private_key[32];
+	uint8_t expected_key[64];
+	uint8_t sig[64];
+	uint8_t recid;
+	for (int i = 0; i < 32; i++) {
+		private_key[i] = (uint8_t)(i + 1);
+	}
+	compute_public_key_rfc6979(private_key, expected_key, curve);
+	for (int m = 0; m < 16; m++) {
+		for (int i = 0; i < 32; i++) {
+			hash[i] = (uint8_t)(m * 7 + i);
+		}
+		if (!sign_rfc6979(private_key, hash, 32, &recid, sig, curve)) {
+			printf("Test failed: signing message %d.\n", m);
+			failed = 1;
+			continue;
+		}
+		if (sig[32] & 0x80) {
+			printf("Test failed: high s for message %d.\n", m);
+			failed = 1;
+		}
+		if (!recover_rfc6979(hash, 32, sig, recid, public_key, curve) ||
+			memcmp(public_key, expected_key, 64) != 0) {
+			printf("Test failed: round trip for message %d.\n", m);
+			print_hex("Expected key", expected_key, 64);
+			print_hex("Actual key", public_key, 64);
+			failed = 1;
+		}
+		if (recover_rfc6979(hash, 32, sig, recid ^ 1, public_key, curve) &&
+			memcmp(public_key, expected_key, 64) == 0) {
+			printf("Test failed: wrong recid recovered the key for message %d.\n", m);
+			failed = 1;
+		}
+	}
+
+	// Batch recovery must agree with the single path and flag broken entries
+	enum { BATCH = 40 };
+	static uint8_t hashes[BATCH * 32], sigs[BATCH * 64], recids[BATCH], keys[BATCH * 64], valid[BATCH];
+	for (int m = 0; m < BATCH; m++) {
+		for (int i = 0; i < 32; i++) {
+			hashes[m * 32 + i] = (uint8_t)(m * 11 + i);
+		}
+		sign_rfc6979(private_key, hashes + m * 32, 32, recids + m, sigs + m * 64, curve);
+	}
+	memset(sigs + 5 * 64 + 32, 0, 32); // s = 0
+	recids[9] = 4;
+	if (recover_rfc6979_batch(hashes, 32, sigs, recids, BATCH, keys, valid, curve)) {
+		printf("Test failed: batch accepted invalid entries.\n");
+		failed = 1;
+	}
+	for (int m = 0; m < BATCH; m++) {
+		int expect_valid = m != 5 && m != 9;
+		if (valid[m] != expect_valid || (expect_valid && memcmp(keys + m * 64, expected_key, 64) != 0)) {
+			printf("Test failed: batch entry %d.\n", m);
+			failed = 1;
+		}
+	}
+
+	// Signatures with k = 1 and k = n - 1, whose R is G and -G and whose r is G.x, are valid
+	static const uint8_t k_one[64] = {
+		0x79, 0xbe, 0x66, 0x7e, 0xf9, 0xdc, 0xbb, 0xac, 0x55, 0xa0, 0x62, 0x95, 0xce, 0x87, 0x0b, 0x07,
+		0x02, 0x9b, 0xfc, 0xdb, 0x2d, 0xce, 0x28, 0xd9, 0x59, 0xf2, 0x81, 0x5b, 0x16, 0xf8, 0x17, 0x98,
+		0x4f, 0xea, 0x9c, 0x26, 0x95, 0xa1, 0x9f, 0xea, 0x72, 0x94, 0x8b, 0x3e, 0xda, 0xf4, 0x9d, 0x0f,
+		0x87, 0xee, 0xeb, 0xdc, 0x4d, 0xb6, 0x65, 0x1f, 0x8a, 0x13, 0xd8, 0x9b, 0x37, 0xe7, 0xcc, 0x11};
+	static const uint8_t k_minus_one[64] = {
+		0x79, 0xbe, 0x66, 0x7e, 0xf9, 0xdc, 0xbb, 0xac, 0x55, 0xa0, 0x62, 0x95, 0xce, 0x87, 0x0b, 0x07,
+		0x02, 0x9b, 0xfc, 0xdb, 0x2d, 0xce, 0x28, 0xd9, 0x59, 0xf2, 0x81, 0x5b, 0x16, 0xf8, 0x17, 0x98,
+		0xb0, 0x15, 0x63, 0xd9, 0x6a, 0x5e, 0x60, 0x15, 0x8d, 0x6b, 0x74, 0xc1, 0x25, 0x0b, 0x62, 0xef,
+		0x32, 0xbf, 0xf1, 0x0a, 0x61, 0x92, 0x3b, 0x1c, 0x35, 0xbe, 0x85, 0xf1, 0x98, 0x4e, 0x75, 0x30};
+	for (int i = 0; i < 32; i++) {
+		hash[i] = (uint8_t)(5 * i + 3);
+	}
+	if (!recover_rfc6979(hash, 32, k_one, 0, public_key, curve) || memcmp(public_key, expected_key, 64) != 0 ||
+		!recover_rfc6979(hash, 32, k_minus_one, 1, public_key, curve) ||
+		memcmp(public_key, expected_key, 64) != 0) {
+		printf("Test failed: signatures with R = +-G.\n");
+		failed = 1;
+	}
+	memcpy(hashes, hash, 32);
+	memcpy(hashes + 2 * 32, hash, 32);
+	memcpy(sigs, k_one, 64);
+	memcpy(sigs + 2 * 64, k_minus_one, 64);
+	recids[0] = 0;
+	recids[2] = 1;
+	sign_rfc6979(private_key, hashes + 5 * 32, 32, recids + 5, sigs + 5 * 64, curve);
+	sign_rfc6979(private_key, hashes + 9 * 32, 32, recids + 9, sigs + 9 * 64, curve);
+	if (!recover_rfc6979_batch(hashes, 32, sigs, recids, BATCH, keys, valid, curve)) {
+		printf("Test failed: batch rejected signatures with R = +-G.\n");
+		failed = 1;
+	}
+	for (int m = 0; m < BATCH; m++) {
+		if (!valid[m] || memcmp(keys + m * 64, expected_key, 64) != 0) {
+			printf("Test failed: batch entry %d with R = +-G.\n", m);
+			failed = 1;
+		}
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
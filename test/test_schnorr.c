@@ -0,0 +1,149 @@
+#include "../src/schnorr/schnorr.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+enum { COUNT = 40 };
+
+static void from_hex(uint8_t *out, const char *hex) {
+	for (size_t i = 0; hex[2 * i]; i++) {
+		unsigned v;
+		sscanf(hex + 2 * i, "%2x", &v);
+		out[i] = (uint8_t)v;
+	}
+}
+
+typedef struct {
+	const char *private_key;
+	const char *aux_rand;
+	const char *message;
+	const char *public_key;
+	const char *signature;
+} vector;
+
+int main() {
+	int failed = 0;
+	uint8_t private_key[32], aux_rand[32], message[64], public_key[32], signature[64], expected[64];
+
+	// BIP340 test vectors 0 and 1, an empty message and a message that is not 32 bytes long
+	const vector vectors[4] = {
+		{"0000000000000000000000000000000000000000000000000000000000000003",
+		 "0000000000000000000000000000000000000000000000000000000000000000",
+		 "0000000000000000000000000000000000000000000000000000000000000000",
+		 "f9308a019258c31049344f85f89d5229b531c845836f99b08601f113bce036f9",
+		 "e907831f80848d1069a5371b402410364bdf1c5f8307b0084c55f1ce2dca8215"
+		 "25f66a4a85ea8b71e482a74f382d2ce5ebeee8fdb2172f477df4900d310536c0"},
+		{"b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef",
+		 "0000000000000000000000000000000000000000000000000000000000000001",
+		 "243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89",
+		 "dff1d77f2a671c5f36183726db2341be58feae1da2deced843240f7b502ba659",
+		 "6896bd60eeae296db48a229ff71dfe071bde413e6d43f917dc8dcf8c78de3341"
+		 "8906d11ac976abccb20b091292bff4ea897efcb639ea871cfa95f6de339e4b0a"},
+		{"0340034003400340034003400340034003400340034003400340034003400340",
+		 "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+		 "",
+		 "778caa53b4393ac467774d09497a87224bf9fab6f6e68b23086497324d6fd117",
+		 "7cfbfdfd905c8fe069127663fd53508240585529cf818ef785742a97e622fcd2"
+		 "c6379f570b1f1f34a22f2fe61ef003ed3e6461f02cf0e16f5779b21bfccfe127"},
+		{"0000000000000000000000000000000000000000000000000000000000000005",
+		 "0000000000000000000000000000000000000000000000000000000000000007",
+		 "68656c6c6f207363686e6f72722c207661726961626c65206c656e677468",
+		 "2f8bde4d1a07209355b4a7250a5c5128e88b84bddc619ab7cba8d569b240efe4",
+		 "5a542c79c2ee9bce247c6701170109f454f334c05c25f4f414b112408a8aea99"
+		 "1fbf73400b1c33d3f6eb7d66d1f7434aa148ad5c34bbbf4daa96ca458c3097c8"},
+	};
+	for (int v = 0; v < 4; v++) {
+		size_t message_size = strlen(vectors[v].message) / 2;
+		from_hex(private_key, vectors[v].private_key);
+		from_hex(aux_rand, vectors[v].aux_rand);
+		from_hex(message, vectors[v].message);
+		from_hex(expected, vectors[v].public_key);
+		if (!schnorr_xonly_public_key(public_key, NULL, private_key) || memcmp(public_key, expected, 32) != 0) {
+			printf("Test failed: public key %d.\n", v);
+			failed = 1;
+		}
+		from_hex(expected, vectors[v].signature);
+		if (!schnorr_sign(signature, message, message_size, private_key, aux_rand) ||
+			memcmp(signature, expected, 64) != 0) {
+			printf("Test failed: signature %d.\n", v);
+			failed = 1;
+		}
+		if (!schnorr_verify(signature, message, message_size, public_key)) {
+			printf("Test failed: verify %d.\n", v);
+			failed = 1;
+		}
+	}
+
+	// Tampered message, s >= n, r >= p and a key that is not an x coordinate
+	from_hex(private_key, vectors[1].private_key);
+	from_hex(message, vectors[1].message);
+	from_hex(public_key, vectors[1].public_key);
+	from_hex(signature, vectors[1].signature);
+	message[0] ^= 1;
+	if (schnorr_verify(signature, message, 32, public_key)) {
+		printf("Test failed: tampered message accepted.\n");
+		failed = 1;
+	}
+	message[0] ^= 1;
+	from_hex(expected, "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141");
+	memcpy(signature + 32, expected, 32);
+	if (schnorr_verify(signature, message, 32, public_key)) {
+		printf("Test failed: s = n accepted.\n");
+		failed = 1;
+	}
+	from_hex(signature, vectors[1].signature);
+	memset(signature, 0xff, 32);
+	if (schnorr_verify(signature, message, 32, public_key)) {
+		printf("Test failed: r >= p accepted.\n");
+		failed = 1;
+	}
+	from_hex(signature, vectors[1].signature);
+	from_hex(public_key, "eefdea4cdb677750a420fee807eacf21eb9898ae79b9768766e4faa04a2d4a34");
+	if (schnorr_verify(signature, message, 32, public_key)) {
+		printf("Test failed: key off the curve accepted.\n");
+		failed = 1;
+	}
+
+	// The key of private key 1 is G itself
+	memset(message, 0x11, 32);
+	from_hex(public_key, "79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798");
+	from_hex(signature, "96f6ba5f9ccb87ed07573765cc7f02199869dd59ae5c30cea1560fecd93d02bb"
+						"a7136696869da47349dd2abf85942ee1eef05152b39ec70483bf6249d21af98e");
+	if (!schnorr_verify(signature, message, 32, public_key)) {
+		printf("Test failed: verify with the generator as key.\n");
+		failed = 1;
+	}
+
+	// Batch verification, with one and then two bad signatures in different groups
+	static uint8_t keys[COUNT * 32], messages[COUNT * 32], signatures[COUNT * 64];
+	uint8_t valid[COUNT];
+	for (int m = 0; m < COUNT; m++) {
+		for (int i = 0; i < 32; i++) {
+			private_key[i]		   = (uint8_t)(m * 13 + i + 1);
+			messages[m * 32 + i] = (uint8_t)(m * 7 + i * 3);
+		}
+		schnorr_xonly_public_key(keys + m * 32, NULL, private_key);
+		schnorr_sign(signatures + m * 64, messages + m * 32, 32, private_key, NULL);
+	}
+	if (!schnorr_verify_batch(signatures, messages, 32, keys, COUNT, valid)) {
+		printf("Test failed: batch rejected valid signatures.\n");
+		failed = 1;
+	}
+	signatures[5 * 64 + 40] ^= 1;
+	memcpy(keys + 33 * 32, keys + 34 * 32, 32);
+	if (schnorr_verify_batch(signatures, messages, 32, keys, COUNT, valid) || valid[5] || valid[33]) {
+		printf("Test failed: batch accepted bad signatures.\n");
+		failed = 1;
+	}
+	for (int m = 0; m < COUNT; m++) {
+		if (m != 5 && m != 33 && !valid[m]) {
+			printf("Test failed: batch rejected signature %d.\n", m);
+			failed = 1;
+		}
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
@@ -0,0 +1,101 @@
+#include "../src/rfc6979/der.h"
+#include "../src/rfc6979/sign.h"
+#include "../src/rfc6979/verify.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+enum { COUNT = 20 };
+
+static void from_hex(uint8_t *out, const char *hex) {
+	for (size_t i = 0; hex[2 * i]; i++) {
+		unsigned v;
+		sscanf(hex + 2 * i, "%2x", &v);
+		out[i] = (uint8_t)v;
+	}
+}
+
+int main() {
+	uECC_Curve curve = uECC_secp256r1();
+	int failed		 = 0;
+	uint8_t private_key[32], public_key[64], expected[64], signature[64], recovered[64], hash[32];
+	uint8_t compressed[33];
+	uint8_t recid;
+
+	// RFC 6979 A.2.5: P-256 key pair
+	from_hex(private_key, "c9afa9d845ba75166b5c215767b1d6934e50c3db36e89b127b8a622b120f6721");
+	from_hex(expected, "60fed4ba255a9d31c961eb74c6356d68c049b8923b61fa6ce669622e60f29fb6"
+					   "7903fe1008b8bc99a41ae9e95628bc64f2f1b20c2d7e9f5177a3c294d4462299");
+	if (!compute_public_key_rfc6979(private_key, public_key, curve) || memcmp(public_key, expected, 64) != 0) {
+		printf("Test failed: public key.\n");
+		failed = 1;
+	}
+	uECC_compress(public_key, compressed, curve);
+	if (!uECC_decompress(compressed, recovered, curve) || memcmp(recovered, public_key, 64) != 0) {
+		printf("Test failed: decompress.\n");
+		failed = 1;
+	}
+
+	// With SHA-256 of "sample" (s normalized to n - s) and of "test"
+	const char *hashes[2] = {
+		"af2bdbe1aa9b6ec1e2ade1d694f41fc71a831d0268e9891562113d8a62add1bf",
+		"9f86d081884c7d659a2feaa0c55ad015a3bf4f1b2b0b822cd15d6c15b0f00a08",
+	};
+	const char *signatures[2] = {
+		"efd48b2aacb6a8fd1140dd9cd45e81d69d2c877b56aaf991c34d0ea84eaf3716"
+		"0834e36ad29a83bf2bc9385e491d6099c8fdf9d1ed67aa7ea5f51f93782857a9",
+		"f1abb023518351cd71d881567b1ea663ed3efcf6c5132b354f28d3b0b7d38367"
+		"019f4113742a2b14bd25926b49c649155f267e60d3814b4c0cc84250e46f0083",
+	};
+	for (int v = 0; v < 2; v++) {
+		from_hex(hash, hashes[v]);
+		from_hex(expected, signatures[v]);
+		if (!sign_rfc6979(private_key, hash, 32, &recid, signature, curve) || memcmp(signature, expected, 64) != 0) {
+			printf("Test failed: signature %d.\n", v);
+			failed = 1;
+		}
+		if (!signature_is_low_s(signature, curve) || !verify_rfc6979(public_key, hash, 32, signature, curve)) {
+			printf("Test failed: verify %d.\n", v);
+			failed = 1;
+		}
+		if (!recover_rfc6979(hash, 32, signature, recid, recovered, curve) || memcmp(recovered, public_key, 64) != 0) {
+			printf("Test failed: recover %d.\n", v);
+			failed = 1;
+		}
+		hash[0] ^= 1;
+		if (verify_rfc6979(public_key, hash, 32, signature, curve)) {
+			printf("Test failed: tampered hash %d accepted.\n", v);
+			failed = 1;
+		}
+	}
+
+	// Batch signing and verification share the secp256k1 machinery
+	static uint8_t keys[COUNT * 64], hash_list[COUNT * 32], sigs[COUNT * 64], batch_sigs[COUNT * 64];
+	uint8_t recids[COUNT], batch_recids[COUNT], valid[COUNT];
+	for (int m = 0; m < COUNT; m++) {
+		for (int i = 0; i < 32; i++) {
+			hash_list[m * 32 + i] = (uint8_t)(m * 11 + i);
+		}
+		memcpy(keys + m * 64, public_key, 64);
+		sign_rfc6979(private_key, hash_list + m * 32, 32, recids + m, sigs + m * 64, curve);
+	}
+	if (!sign_rfc6979_batch(private_key, hash_list, 32, COUNT, batch_recids, batch_sigs, curve) ||
+		memcmp(batch_sigs, sigs, sizeof(sigs)) != 0 || memcmp(batch_recids, recids, COUNT) != 0) {
+		printf("Test failed: batch signing.\n");
+		failed = 1;
+	}
+	if (!verify_rfc6979_batch(keys, hash_list, 32, sigs, recids, COUNT, valid, curve)) {
+		printf("Test failed: batch verify.\n");
+		failed = 1;
+	}
+	sigs[7 * 64 + 3] ^= 1;
+	if (verify_rfc6979_batch(keys, hash_list, 32, sigs, recids, COUNT, valid, curve) || valid[7] || !valid[8]) {
+		printf("Test failed: batch verify with a bad signature.\n");
+		failed = 1;
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
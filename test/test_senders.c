@@ -0,0 +1,180 @@
+#include "../src/ethereum/address.h"
+#include "../src/ethereum/rlp.h"
+#include "../src/ethereum/transaction.h"
+#include "../src/keccak256/keccak256.h"
+#include "../src/rfc6979/sign.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TRANSACTIONS 100
+#define KEYS 5
+
+static uint8_t body[TRANSACTIONS * 600];
+static uint8_t items[TRANSACTIONS * 600];
+static uint8_t senders[TRANSACTIONS][20];
+static uint8_t valid[TRANSACTIONS];
+
+static void from_hex(uint8_t *out, const char *hex) {
+	for (size_t i = 0; hex[2 * i]; i++) {
+		unsigned v;
+		sscanf(hex + 2 * i, "%2x", &v);
+		out[i] = (uint8_t)v;
+	}
+}
+
+/* Signs the typed transaction type || rlp([fields..., y, r, s]), whose unsigned fields are given
+   encoded, for a type transaction_sign() does not build. Returns the size written to out. */
+static size_t sign_typed(uint8_t *out, uint8_t type, const char *fields_hex, const uint8_t *key) {
+	uint8_t fields[256], signature[64], hash[32], recid;
+	size_t size = strlen(fields_hex) / 2, at;
+
+	from_hex(fields, fields_hex);
+	out[0] = type;
+	at	   = 1 + rlp_put_header(out + 1, size, RLP_LIST);
+	memcpy(out + at, fields, size);
+	keccak256_raw(hash, 32, out, at + size, 1, 256);
+	sign_rfc6979(key, hash, 32, &recid, signature, uECC_secp256k1());
+
+	/* The y parity, then r and s without their leading zeros. */
+	size += rlp_put_uint(fields + size, recid);
+	for (int half = 0; half < 2; half++) {
+		size_t skip = 0;
+		while (signature[32 * half + skip] == 0) {
+			skip++;
+		}
+		size += rlp_put_string(fields + size, signature + 32 * half + skip, 32 - skip);
+	}
+	at = 1 + rlp_put_header(out + 1, size, RLP_LIST);
+	memcpy(out + at, fields, size);
+	return at + size;
+}
+
+/* Recovers the senders of body with threads threads and compares them to the keys that signed. */
+static int check_senders(const char *name, size_t size, uint8_t addresses[KEYS][20], unsigned threads, size_t bad) {
+	size_t count;
+	int ok = transaction_senders(senders[0], valid, &count, TRANSACTIONS, body, size, threads);
+
+	if (ok != (bad == TRANSACTIONS) || count != TRANSACTIONS) {
+		printf("Test failed: %s returned %d for %zu transactions\n", name, ok, count);
+		return 1;
+	}
+	for (size_t i = 0; i < TRANSACTIONS; i++) {
+		static const uint8_t zero[20] = {0};
+		if (i == bad ? valid[i] || memcmp(senders[i], zero, 20) != 0
+					 : !valid[i] || memcmp(senders[i], addresses[i % KEYS], 20) != 0) {
+			printf("Test failed: %s sender %zu\n", name, i);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+int main() {
+	static uint8_t data[300];
+	uint8_t keys[KEYS][32], addresses[KEYS][20], to[20], storage_key[32], out[600], v;
+	size_t offsets[TRANSACTIONS], sizes[TRANSACTIONS], size = 0, header, count;
+	static const char blob_fields[] = "018001028252089435353535353535353535353535353535353535358080c003"
+									  "e1a001ababababababababababababababababababababababababababababab"
+									  "abab";
+	static const char set_code_fields[] = "0105010282c3509435353535353535353535353535353535353535358080c0db"
+										  "da0194353535353535353535353535353535353535353580800101";
+	transaction_access access;
+	transaction tx;
+	int failed = 0;
+
+	from_hex(keys[0], "4646464646464646464646464646464646464646464646464646464646464646");
+	from_hex(keys[1], "4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318");
+	for (int k = 2; k < KEYS; k++) {
+		memset(keys[k], 0x11 * k, 32);
+	}
+	for (int k = 0; k < KEYS; k++) {
+		ethereum_address(addresses[k], keys[k], ETHEREUM_KEY_PRIVATE);
+	}
+	for (int i = 0; i < 300; i++) {
+		data[i] = (uint8_t)(i * 7);
+	}
+	memset(to, 0x35, 20);
+	memset(storage_key, 0x01, 32);
+	access.address			 = to;
+	access.storage_keys		 = storage_key;
+	access.storage_key_count = 1;
+
+	// Legacy transactions with and without a chain id, EIP-2930 and EIP-1559 ones, some creating
+	// contracts, and an EIP-4844 blob and an EIP-7702 set-code transaction, which have more fields,
+	// in a block body where typed transactions are strings
+	for (int i = 0; i < TRANSACTIONS; i++) {
+		memset(&tx, 0, sizeof(tx));
+		tx.type				   = (transaction_type)(i % 3);
+		tx.chain_id			   = i % 4 == 0 && tx.type == TRANSACTION_LEGACY ? 0 : 1 + (uint64_t)i * 1000;
+		tx.nonce			   = (uint64_t)i;
+		tx.gas_limit		   = 21000 + (uint64_t)i;
+		tx.to				   = i % 7 ? to : NULL;
+		tx.data				   = data;
+		tx.data_size		   = (size_t)(i * 3);
+		tx.access_list		   = &access;
+		tx.access_list_count   = (size_t)(i % 2);
+		tx.gas_price[31]	   = (uint8_t)i;
+		tx.max_fee_per_gas[30] = 1;
+		tx.value[24]		   = (uint8_t)(i + 1);
+		sizes[i]			   = transaction_sign(out, sizeof(out), &tx, keys[i % KEYS]);
+		offsets[i]			   = size;
+		if (i == 40) {
+			sizes[i] = sign_typed(out, 3, blob_fields, keys[i % KEYS]);
+		} else if (i == 80) {
+			sizes[i] = sign_typed(out, 4, set_code_fields, keys[i % KEYS]);
+		}
+		if (out[0] < RLP_LIST) {
+			size += rlp_put_header(items + size, sizes[i], RLP_STRING);
+		}
+		memcpy(items + size, out, sizes[i]);
+		size += sizes[i];
+	}
+	header = rlp_put_header(body, size, RLP_LIST);
+	memcpy(body + header, items, size);
+	size += header;
+
+	failed |= check_senders("one thread", size, addresses, 1, TRANSACTIONS);
+	failed |= check_senders("four threads", size, addresses, 4, TRANSACTIONS);
+
+	// A legacy transaction with a v of neither form loses only its own sender
+	v = body[header + offsets[12] + sizes[12] - 67];
+	body[header + offsets[12] + sizes[12] - 67] = 29;
+	failed |= check_senders("invalid v", size, addresses, 3, 12);
+	body[header + offsets[12] + sizes[12] - 67] = v;
+
+	// So does one whose r starts with a zero byte, which consensus rules reject
+	v = body[header + offsets[12] + sizes[12] - 65];
+	body[header + offsets[12] + sizes[12] - 65] = 0;
+	failed |= check_senders("zero-padded r", size, addresses, 3, 12);
+	body[header + offsets[12] + sizes[12] - 65] = v;
+
+	// A truncated body, more transactions than fit and non-canonical headers are rejected
+	if (transaction_senders(senders[0], valid, &count, TRANSACTIONS, body, size - 1, 2) ||
+		transaction_senders(senders[0], valid, &count, TRANSACTIONS - 1, body, size, 2)) {
+		printf("Test failed: accepted a malformed body\n");
+		failed = 1;
+	}
+	{
+		static const char *rejected[] = {"8105", "b80505050505", "b9003a", "8201", "f800", "c3c0c0"};
+		size_t offset, length;
+		for (size_t i = 0; i < sizeof(rejected) / sizeof(rejected[0]); i++) {
+			size_t bytes = strlen(rejected[i]) / 2;
+			from_hex(out, rejected[i]);
+			if (rlp_read_header(out, bytes, &offset, &length)) {
+				printf("Test failed: accepted header %s\n", rejected[i]);
+				failed = 1;
+			}
+		}
+		if (rlp_read_header((const uint8_t *)"\x05", 1, &offset, &length) != RLP_STRING || offset != 0 ||
+			length != 1) {
+			printf("Test failed: single byte header\n");
+			failed = 1;
+		}
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
@@ -0,0 +1,64 @@
+#include "../src/rfc6979/sign.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// More than two batches of uECC_BATCH_SIZE, the last one partial
+enum { COUNT = 2 * uECC_BATCH_SIZE + 11 };
+
+static void from_hex(uint8_t *out, const char *hex) {
+	for (size_t i = 0; hex[2 * i]; i++) {
+		unsigned v;
+		sscanf(hex + 2 * i, "%2x", &v);
+		out[i] = (uint8_t)v;
+	}
+}
+
+int main() {
+	uECC_Curve curve = uECC_secp256k1();
+	static uint8_t hashes[COUNT * 32], signatures[COUNT * 64], expected[COUNT * 64];
+	uint8_t recids[COUNT], expected_recids[COUNT], private_key[32];
+	int failed = 0;
+
+	from_hex(private_key, "4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318");
+	for (int m = 0; m < COUNT; m++) {
+		for (int i = 0; i < 32; i++) {
+			hashes[m * 32 + i] = (uint8_t)(m * 13 + i * 7);
+		}
+		if (!sign_rfc6979(private_key, hashes + m * 32, 32, expected_recids + m, expected + m * 64, curve)) {
+			printf("Test failed: signing message %d.\n", m);
+			failed = 1;
+		}
+	}
+
+	// The batch gives the same signatures and recids as signing one hash at a time
+	memset(recids, 0xff, sizeof(recids));
+	if (!sign_rfc6979_batch(private_key, hashes, 32, COUNT, recids, signatures, curve) ||
+		memcmp(signatures, expected, sizeof(expected)) != 0 || memcmp(recids, expected_recids, COUNT) != 0) {
+		printf("Test failed: batch signatures.\n");
+		failed = 1;
+	}
+	memset(signatures, 0, sizeof(signatures));
+	if (!sign_rfc6979_batch(private_key, hashes + 32, 32, COUNT - 1, NULL, signatures, curve) ||
+		memcmp(signatures, expected + 64, (COUNT - 1) * 64) != 0) {
+		printf("Test failed: batch signatures without recids.\n");
+		failed = 1;
+	}
+
+	// Keys 0 and n are rejected
+	memset(private_key, 0, 32);
+	if (sign_rfc6979_batch(private_key, hashes, 32, COUNT, recids, signatures, curve)) {
+		printf("Test failed: batch signed with key 0.\n");
+		failed = 1;
+	}
+	from_hex(private_key, "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141");
+	if (sign_rfc6979_batch(private_key, hashes, 32, COUNT, recids, signatures, curve)) {
+		printf("Test failed: batch signed with key n.\n");
+		failed = 1;
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
@@ -0,0 +1,170 @@
+#include "../src/rfc6979/cache.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+enum { HASHES = 64, THREADS = 4, ROUNDS = 20 };
+
+static sign_cache cache;
+static sign_cache_entry entries[SIGN_CACHE_SHARDS * 4];
+static sign_cache one_per_shard;
+static sign_cache_entry one_per_shard_entries[SIGN_CACHE_SHARDS];
+static uint8_t private_key[32];
+static uint8_t hashes[HASHES][32];
+static uint8_t expected[HASHES][64];
+static uint8_t expected_recids[HASHES];
+
+static void from_hex(uint8_t *out, const char *hex) {
+	for (size_t i = 0; hex[2 * i]; i++) {
+		unsigned v;
+		sscanf(hex + 2 * i, "%2x", &v);
+		out[i] = (uint8_t)v;
+	}
+}
+
+/* Signs hash m through c and compares the result with sign_rfc6979(). */
+static int check_sign(sign_cache *c, int m) {
+	uint8_t signature[64], recid = 0xff;
+	return sign_rfc6979_cached(c, 7, private_key, hashes[m], 32, &recid, signature, uECC_secp256k1()) &&
+		   memcmp(signature, expected[m], 64) == 0 && recid == expected_recids[m];
+}
+
+static void *sign_same_pair(void *arg) {
+	uintptr_t failed = 0;
+	(void)arg;
+	for (int round = 0; round < ROUNDS; round++) {
+		failed |= !check_sign(&one_per_shard, 0);
+	}
+	return (void *)failed;
+}
+
+int main() {
+	uECC_Curve curve = uECC_secp256k1();
+	uint64_t hits, misses, evictions, before;
+	uint8_t signature[64], expected_signature[64], recid, expected_recid;
+	int failed = 0, same_shard[2], found = 0;
+
+	from_hex(private_key, "4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318");
+	for (int m = 0; m < HASHES; m++) {
+		for (int i = 0; i < 32; i++) {
+			hashes[m][i] = (uint8_t)(m * 31 + i);
+		}
+		sign_rfc6979(private_key, hashes[m], 32, &expected_recids[m], expected[m], curve);
+	}
+	if (!sign_cache_init(&cache, entries, sizeof(entries) / sizeof(entries[0])) ||
+		!sign_cache_init(&one_per_shard, one_per_shard_entries, SIGN_CACHE_SHARDS)) {
+		printf("Test failed: init.\n");
+		return 1;
+	}
+
+	// A miss, then a hit with the same signature and recid
+	for (int pass = 0; pass < 2; pass++) {
+		for (int m = 0; m < 10; m++) {
+			if (!check_sign(&cache, m)) {
+				printf("Test failed: signature %d on pass %d.\n", m, pass);
+				failed = 1;
+			}
+		}
+	}
+	sign_cache_stats(&cache, &hits, &misses, &evictions);
+	if (hits != 10 || misses != 10 || evictions != 0) {
+		printf("Test failed: counters after hits.\n");
+		failed = 1;
+	}
+
+	// The same handle and hash on another curve is another signature, also cached on its own
+	sign_rfc6979(private_key, hashes[0], 32, &expected_recid, expected_signature, uECC_secp256r1());
+	for (int pass = 0; pass < 2; pass++) {
+		if (!sign_rfc6979_cached(&cache, 7, private_key, hashes[0], 32, &recid, signature, uECC_secp256r1()) ||
+			memcmp(signature, expected_signature, 64) != 0 || recid != expected_recid || !check_sign(&cache, 0)) {
+			printf("Test failed: secp256k1 and secp256r1 signatures mixed up on pass %d.\n", pass);
+			failed = 1;
+		}
+	}
+
+	// Cleared entries are gone but the counters stay
+	sign_cache_clear(&cache);
+	check_sign(&cache, 0);
+	sign_cache_stats(&cache, &hits, &misses, &evictions);
+	if (hits != 13 || misses != 12) {
+		printf("Test failed: hit after clear.\n");
+		failed = 1;
+	}
+
+	// Shards do not depend on the capacity, so a cache with one entry per shard finds two hashes
+	// that share the shard of hash 0: signing one evicts hash 0
+	for (int m = 1; m < HASHES && found < 2; m++) {
+		sign_cache_clear(&one_per_shard);
+		check_sign(&one_per_shard, 0);
+		sign_cache_stats(&one_per_shard, NULL, NULL, &before);
+		check_sign(&one_per_shard, m);
+		sign_cache_stats(&one_per_shard, NULL, NULL, &evictions);
+		if (evictions == before + 1) {
+			same_shard[found++] = m;
+		}
+	}
+	if (found < 2) {
+		printf("Test failed: no eviction in a full shard.\n");
+		return 1;
+	}
+
+	// With two entries per shard, hash 0 and another fill the shard; once hash 0 is used again, a
+	// third hash evicts the other one, the least recently used
+	{
+		sign_cache two;
+		static sign_cache_entry two_entries[SIGN_CACHE_SHARDS * 2];
+		uint64_t two_hits, two_misses, two_evictions;
+
+		sign_cache_init(&two, two_entries, SIGN_CACHE_SHARDS * 2);
+		failed |= !check_sign(&two, 0);
+		failed |= !check_sign(&two, same_shard[0]);
+		failed |= !check_sign(&two, 0);				// hit; same_shard[0] is now the oldest
+		failed |= !check_sign(&two, same_shard[1]); // evicts same_shard[0]
+		sign_cache_stats(&two, &two_hits, &two_misses, &two_evictions);
+		if (two_hits != 1 || two_misses != 3 || two_evictions != 1) {
+			printf("Test failed: counters of a full shard.\n");
+			failed = 1;
+		}
+		failed |= !check_sign(&two, 0);				// still cached
+		failed |= !check_sign(&two, same_shard[0]); // evicted, signed again
+		sign_cache_stats(&two, &two_hits, &two_misses, &two_evictions);
+		if (two_hits != 2 || two_misses != 4 || two_evictions != 2) {
+			printf("Test failed: least recently used entry was not evicted.\n");
+			failed = 1;
+		}
+		sign_cache_destroy(&two);
+	}
+
+	// Threads missing on the same pair at once all get the right signature, and it is stored once
+	{
+		pthread_t threads[THREADS];
+		void *result;
+		sign_cache_clear(&one_per_shard);
+		sign_cache_stats(&one_per_shard, NULL, NULL, &before);
+		for (int t = 0; t < THREADS; t++) {
+			pthread_create(&threads[t], NULL, sign_same_pair, NULL);
+		}
+		for (int t = 0; t < THREADS; t++) {
+			pthread_join(threads[t], &result);
+			if (result) {
+				printf("Test failed: concurrent signature.\n");
+				failed = 1;
+			}
+		}
+		sign_cache_stats(&one_per_shard, &hits, &misses, &evictions);
+		if (evictions != before) {
+			printf("Test failed: concurrent misses stored the pair twice.\n");
+			failed = 1;
+		}
+	}
+
+	sign_cache_destroy(&cache);
+	sign_cache_destroy(&one_per_shard);
+	if (failed) {
+		printf("Test failed: cached signatures.\n");
+	} else {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
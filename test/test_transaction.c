@@ -0,0 +1,216 @@
+#include "../src/ethereum/transaction.h"
+#include "../src/keccak256/keccak256.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static void from_hex(uint8_t *out, const char *hex) {
+	for (size_t i = 0; hex[2 * i]; i++) {
+		unsigned v;
+		sscanf(hex + 2 * i, "%2x", &v);
+		out[i] = (uint8_t)v;
+	}
+}
+
+/* Writes value big-endian into the last bytes of a 32-byte amount. */
+static void amount(uint8_t *out, uint64_t value) {
+	memset(out, 0, 32);
+	for (int i = 0; i < 8; i++) {
+		out[31 - i] = (uint8_t)(value >> (8 * i));
+	}
+}
+
+/* Signs tx, checking its signing hash, the size bound and either the whole signed encoding
+   (signed_hex) or its Keccak-256 and size. */
+static int check_transaction(
+	const char *name,
+	const transaction *tx,
+	const uint8_t *private_key,
+	const char *hash_hex,
+	const char *signed_hex,
+	const char *tx_hash_hex,
+	size_t signed_size
+) {
+	static uint8_t out[2048], expected_signed[1024];
+	uint8_t hash[32], expected[32];
+	size_t size;
+	int failed = 0;
+
+	from_hex(expected, hash_hex);
+	if (!transaction_signing_hash(hash, tx) || memcmp(hash, expected, 32) != 0) {
+		printf("Test failed: %s signing hash\n", name);
+		failed = 1;
+	}
+	if (signed_hex) {
+		signed_size = strlen(signed_hex) / 2;
+		from_hex(expected_signed, signed_hex);
+	}
+	size = transaction_sign(out, sizeof(out), tx, private_key);
+	if (size != signed_size || (signed_hex && memcmp(out, expected_signed, size) != 0)) {
+		printf("Test failed: %s signed encoding\n", name);
+		failed = 1;
+	}
+	if (tx_hash_hex) {
+		from_hex(expected, tx_hash_hex);
+		keccak256_raw(hash, 32, out, size, 1, 256);
+		if (memcmp(hash, expected, 32) != 0) {
+			printf("Test failed: %s transaction hash\n", name);
+			failed = 1;
+		}
+	}
+	if (transaction_signed_size(tx) < size || transaction_sign(out, size - 1, tx, private_key) != 0 ||
+		transaction_sign(out, transaction_signed_size(tx), tx, private_key) != size) {
+		printf("Test failed: %s output size\n", name);
+		failed = 1;
+	}
+	return failed;
+}
+
+int main() {
+	static uint8_t data[768];
+	uint8_t key[32], other_key[32], to[20], access_address[20], storage_keys[2][32];
+	transaction_access access[2];
+	transaction tx;
+	int failed = 0;
+
+	// The example of EIP-155, and the same transaction without a chain id
+	memset(&tx, 0, sizeof(tx));
+	memset(key, 0x46, 32);
+	memset(to, 0x35, 20);
+	tx.type		 = TRANSACTION_LEGACY;
+	tx.chain_id	 = 1;
+	tx.nonce	 = 9;
+	tx.gas_limit = 21000;
+	tx.to		 = to;
+	amount(tx.gas_price, 20000000000);
+	amount(tx.value, 1000000000000000000);
+	failed |= check_transaction(
+		"EIP-155",
+		&tx,
+		key,
+		"daf5a779ae972f972197303d7b574746c7ef83eadac0f2791ad23db92e4c8e53",
+		"f86c098504a817c800825208943535353535353535353535353535353535353535880de0b6b3a76400008025a028ef61"
+		"340bd939bc2195fe537567866003e1a15d3c71ff63e1590620aa636276a067cbe9d8997f761aecb703304b3800ccf555"
+		"c9f3dc64214b297fb1966a3b6d83",
+		NULL,
+		0
+	);
+	tx.chain_id = 0;
+	failed |= check_transaction(
+		"legacy",
+		&tx,
+		key,
+		"f9e36c28c8cb35adba138005c02ab7aa7fbcd891f3139cb2eeed052a51cd2713",
+		"f86c098504a817c800825208943535353535353535353535353535353535353535880de0b6b3a7640000801ba08383ad"
+		"c8b8ae116f918fb44ca7ff9dfd8012596a5c130c6246a2cc717ba41cdaa053ddfacf5bd4aa7e46d1575acf52636ea659"
+		"b91f29e2fb91c75567a279738f38",
+		NULL,
+		0
+	);
+
+	// EIP-1559 with long data and an access list, including an entry without storage keys
+	from_hex(other_key, "4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318");
+	from_hex(to, "f0109fc8df283027b6285cc889f5aa624eac1f55");
+	from_hex(access_address, "de0b295669a9fd93d5f28d9ec85e40f4cb697bae");
+	amount(storage_keys[0], 3);
+	amount(storage_keys[1], 7);
+	for (int i = 0; i < 768; i++) {
+		data[i] = (uint8_t)i;
+	}
+	access[0].address			= access_address;
+	access[0].storage_keys		= storage_keys[0];
+	access[0].storage_key_count = 2;
+	access[1].address			= to;
+	access[1].storage_keys		= NULL;
+	access[1].storage_key_count = 0;
+	memset(&tx, 0, sizeof(tx));
+	tx.type				 = TRANSACTION_DYNAMIC_FEE;
+	tx.chain_id			 = 1;
+	tx.nonce			 = 7;
+	tx.gas_limit		 = 100000;
+	tx.to				 = to;
+	tx.data				 = data;
+	tx.data_size		 = sizeof(data);
+	tx.access_list		 = access;
+	tx.access_list_count = 2;
+	amount(tx.max_priority_fee_per_gas, 2000000000);
+	amount(tx.max_fee_per_gas, 30000000000);
+	from_hex(tx.value + 22, "029d42b64e76714244cb");
+	failed |= check_transaction(
+		"EIP-1559",
+		&tx,
+		other_key,
+		"8a9e14ab86377ee38a690de7e88f1a72558d67f89bd73c35b8bd02bf46a8127a",
+		NULL,
+		"ed3b5197108e200427de4ee85ae8169df3caeb6c575a276e8b413755025fa99d",
+		1007
+	);
+
+	// EIP-1559 with zero fees, no data and an empty access list
+	memset(&tx, 0, sizeof(tx));
+	tx.type		 = TRANSACTION_DYNAMIC_FEE;
+	tx.chain_id	 = 11155111;
+	tx.gas_limit = 21000;
+	tx.to		 = to;
+	amount(tx.value, 1);
+	failed |= check_transaction(
+		"empty EIP-1559",
+		&tx,
+		other_key,
+		"66eab5f07d1e610cb0de21bc45bf1d67a1ffc8543f67c95e6a0b84a146f0c382",
+		"02f86583aa36a780808082520894f0109fc8df283027b6285cc889f5aa624eac1f550180c080a07c9dc7dd5a48b9c23b"
+		"1285b2439528b852d908eef264cf00306a8d846df621eba01df547578aec274d46f6aa186903899ca8bee653e85f8f7c"
+		"cdb356ae56041607",
+		NULL,
+		0
+	);
+
+	// EIP-2930 contract creation
+	memset(&tx, 0, sizeof(tx));
+	tx.type				 = TRANSACTION_ACCESS_LIST;
+	tx.chain_id			 = 137;
+	tx.gas_limit		 = 60000;
+	tx.data				 = (const uint8_t *)"\x60\x80\x60\x40\x52";
+	tx.data_size		 = 5;
+	tx.access_list		 = access;
+	tx.access_list_count = 1;
+	amount(tx.gas_price, 1);
+	failed |= check_transaction(
+		"EIP-2930",
+		&tx,
+		other_key,
+		"bed8b4e9c6b99faaae8fe84229620f2338b6b6feae7c7d8be24d95ca2c07fea5",
+		"01f8af8189800182ea608080856080604052f85bf85994de0b295669a9fd93d5f28d9ec85e40f4cb697baef842a00000"
+		"000000000000000000000000000000000000000000000000000000000003a00000000000000000000000000000000000"
+		"00000000000000000000000000000780a07268b792a2ee52cf2b0c10989a97c7a52fad51f6ca5b3ac6d043fede5a1ce7"
+		"83a02764e187d6a8f2e681b6fa5f3afedf68e7081bc90899e230b6f4406b4d634dcc",
+		NULL,
+		0
+	);
+
+	// Rejected: an unknown type, an invalid key and a chain id v cannot hold
+	{
+		uint8_t out[512], hash[32], zero[32] = {0};
+		tx.type = (transaction_type)3;
+		if (transaction_signing_hash(hash, &tx) || transaction_sign(out, sizeof(out), &tx, key)) {
+			printf("Test failed: accepted an unknown type\n");
+			failed = 1;
+		}
+		tx.type = TRANSACTION_ACCESS_LIST;
+		if (transaction_sign(out, sizeof(out), &tx, zero)) {
+			printf("Test failed: accepted an invalid key\n");
+			failed = 1;
+		}
+		tx.type		= TRANSACTION_LEGACY;
+		tx.chain_id = UINT64_MAX / 2;
+		if (transaction_sign(out, sizeof(out), &tx, key)) {
+			printf("Test failed: accepted an oversized chain id\n");
+			failed = 1;
+		}
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
@@ -0,0 +1,201 @@
+#include "../src/ethereum/trie.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PAIRS 1000
+
+typedef struct {
+	uint8_t key[32];
+	size_t key_size;
+	uint8_t value[40];
+	size_t value_size;
+} pair;
+
+static pair pairs[PAIRS];
+
+static void from_hex(uint8_t *out, const char *hex) {
+	for (size_t i = 0; hex[2 * i]; i++) {
+		unsigned v;
+		sscanf(hex + 2 * i, "%2x", &v);
+		out[i] = (uint8_t)v;
+	}
+}
+
+static uint32_t next(uint32_t *x) {
+	*x ^= *x << 13;
+	*x ^= *x >> 17;
+	*x ^= *x << 5;
+	return *x;
+}
+
+static size_t random_value(uint8_t *out, uint32_t *x, unsigned i) {
+	size_t size = 1 + next(x) % 40;
+	for (size_t j = 0; j < size; j++) {
+		out[j] = (uint8_t)(i * 7 + j * 13 + (next(x) & 0x80));
+	}
+	return size;
+}
+
+static int compare_pairs(const void *a, const void *b) {
+	const pair *p = a, *q = b;
+	int order	  = memcmp(p->key, q->key, p->key_size < q->key_size ? p->key_size : q->key_size);
+	return order ? order : (int)p->key_size - (int)q->key_size;
+}
+
+/* Adds a pair unless its key is taken already. */
+static size_t add_pair(size_t count, const uint8_t *key, size_t key_size, const uint8_t *value, size_t value_size) {
+	for (size_t i = 0; i < count; i++) {
+		if (pairs[i].key_size == key_size && memcmp(pairs[i].key, key, key_size) == 0) {
+			return count;
+		}
+	}
+	memcpy(pairs[count].key, key, key_size);
+	memcpy(pairs[count].value, value, value_size);
+	pairs[count].key_size	= key_size;
+	pairs[count].value_size = value_size;
+	return count + 1;
+}
+
+/* Computes the root of the first count pairs with 1 and 4 threads, checking both against hex. */
+static int check_root(const char *name, size_t count, const char *hex) {
+	static const uint8_t *keys[PAIRS], *values[PAIRS];
+	static size_t key_sizes[PAIRS], value_sizes[PAIRS];
+	size_t total = 0, max_key = 0, arena_size;
+	uint8_t expected[32], root[32];
+	void *arena;
+	int failed = 0;
+
+	qsort(pairs, count, sizeof(pair), compare_pairs);
+	for (size_t i = 0; i < count; i++) {
+		keys[i]		   = pairs[i].key;
+		key_sizes[i]   = pairs[i].key_size;
+		values[i]	   = pairs[i].value;
+		value_sizes[i] = pairs[i].value_size;
+		total += value_sizes[i];
+		max_key = key_sizes[i] > max_key ? key_sizes[i] : max_key;
+	}
+	from_hex(expected, hex);
+	arena_size = trie_arena_size(count, max_key, total);
+	arena	   = malloc(arena_size);
+	for (unsigned threads = 1; threads <= 4; threads += 3) {
+		memset(root, 0, 32);
+		if (!trie_root(root, keys, key_sizes, values, value_sizes, count, arena, arena_size, threads) ||
+			memcmp(root, expected, 32) != 0) {
+			printf("Test failed: %s root with %u threads\n", name, threads);
+			failed = 1;
+		}
+	}
+	free(arena);
+	return failed;
+}
+
+static int check_ordered_root(const uint8_t *const *values, const size_t *sizes, size_t count, const char *hex) {
+	size_t total = 0, arena_size;
+	uint8_t expected[32], root[32];
+	void *arena;
+	int failed = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		total += sizes[i];
+	}
+	from_hex(expected, hex);
+	arena_size = trie_ordered_arena_size(count, total);
+	arena	   = malloc(arena_size);
+	for (unsigned threads = 1; threads <= 4; threads += 3) {
+		if (!trie_ordered_root(root, values, sizes, count, arena, arena_size, threads) ||
+			memcmp(root, expected, 32) != 0) {
+			printf("Test failed: ordered root of %zu values with %u threads\n", count, threads);
+			failed = 1;
+		}
+	}
+	free(arena);
+	return failed;
+}
+
+int main() {
+	static const uint8_t table[] = {0x00, 0x01, 0x10, 0x7f, 0xff};
+	static const uint8_t *values[300];
+	static size_t value_sizes[300];
+	static uint8_t value_bytes[300][40];
+	uint8_t key[32], value[40], root[32];
+	uint8_t arena[4096];
+	uint32_t x;
+	size_t count, key_size, value_size;
+	int failed = 0;
+
+	// The trie of the Ethereum wiki, and the empty trie
+	count = add_pair(0, (const uint8_t *)"doe", 3, (const uint8_t *)"reindeer", 8);
+	count = add_pair(count, (const uint8_t *)"dog", 3, (const uint8_t *)"puppy", 5);
+	count = add_pair(count, (const uint8_t *)"dogglesworth", 12, (const uint8_t *)"cat", 3);
+	failed |= check_root("wiki", count, "8aad789dff2f538bca5d8ea56e8abe10f4c7ba3a5dea95fea4cd6e7c3a1168d3");
+	failed |= check_root("empty", 0, "56e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421");
+
+	// Short keys over few bytes, for many extensions, embedded nodes and values in branches
+	x = 1;
+	for (unsigned i = count = 0; i < 400; i++) {
+		key_size = 1 + next(&x) % 6;
+		for (size_t j = 0; j < key_size; j++) {
+			key[j] = table[next(&x) % 5];
+		}
+		value_size = random_value(value, &x, i);
+		count	   = add_pair(count, key, key_size, value, value_size);
+	}
+	failed |= check_root("prefixed", count, "c72c3c9716519b37ac3ebb78b682d086af03278337ccea54ac58f384a192be57");
+
+	// Hashed keys, as in the state trie
+	x = 2;
+	for (unsigned i = count = 0; i < PAIRS; i++) {
+		for (size_t j = 0; j < 32; j++) {
+			key[j] = (uint8_t)next(&x);
+		}
+		value_size = random_value(value, &x, i);
+		count	   = add_pair(count, key, 32, value, value_size);
+	}
+	failed |= check_root("hashed", count, "21c89e4138d37762038b7322fd163b32387282c4b6c17ff26fdd87fc2619a436");
+
+	// Transactions roots, across the keys 0x7f, 0x80 and 0x8180
+	x = 3;
+	for (unsigned i = 0; i < 300; i++) {
+		value_sizes[i] = random_value(value_bytes[i], &x, i);
+		values[i]	   = value_bytes[i];
+	}
+	failed |= check_ordered_root(
+		values, value_sizes, 1, "fdfe65601d4be6519617c600d43834aa550a7d017f1d6d9fcd1343943a4777ab"
+	);
+	failed |= check_ordered_root(
+		values, value_sizes, 100, "473e79cd52e3b171fc2142ec473addd3a4494251d619d9f364816c0578384dc1"
+	);
+	failed |= check_ordered_root(
+		values, value_sizes, 300, "457b4bb70c16c7bc6bdaa462245f362ba906873b94c65f9a56038c9a27d12778"
+	);
+
+	// Unsorted or repeated keys, empty values and a short arena
+	{
+		const uint8_t *keys[2] = {(const uint8_t *)"dog", (const uint8_t *)"doe"};
+		size_t key_sizes[2] = {3, 3}, sizes[2] = {1, 1}, empty[2] = {1, 0};
+		if (trie_root(root, keys, key_sizes, values, sizes, 2, arena, sizeof(arena), 1)) {
+			printf("Test failed: accepted unsorted keys\n");
+			failed = 1;
+		}
+		keys[1] = keys[0];
+		if (trie_root(root, keys, key_sizes, values, sizes, 2, arena, sizeof(arena), 1)) {
+			printf("Test failed: accepted repeated keys\n");
+			failed = 1;
+		}
+		keys[1]		 = (const uint8_t *)"dogs";
+		key_sizes[1] = 4;
+		if (trie_root(root, keys, key_sizes, values, empty, 2, arena, sizeof(arena), 1) ||
+			trie_root(root, keys, key_sizes, values, sizes, 2, arena, 64, 1) ||
+			!trie_root(root, keys, key_sizes, values, sizes, 2, arena, sizeof(arena), 1)) {
+			printf("Test failed: empty value or arena size\n");
+			failed = 1;
+		}
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}
@@ -0,0 +1,65 @@
+#include "../src/rfc6979/sign.h"
+#include "../src/rfc6979/verify.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+enum { BATCH = 40, KEYS = 3 };
+
+int main() {
+	uECC_Curve curve = uECC_secp256k1();
+	int failed		 = 0;
+
+	static uint8_t private_keys[KEYS * 32], keys[BATCH * 64], hashes[BATCH * 32], sigs[BATCH * 64];
+	static uint8_t recids[BATCH], valid[BATCH];
+	uint8_t public_key[64];
+
+	for (int k = 0; k < KEYS; k++) {
+		for (int i = 0; i < 32; i++) {
+			private_keys[k * 32 + i] = (uint8_t)(k * 31 + i + 1);
+		}
+		compute_public_key_rfc6979(private_keys + k * 32, public_key, curve);
+		for (int m = k; m < BATCH; m += KEYS) {
+			memcpy(keys + m * 64, public_key, 64);
+		}
+	}
+	for (int m = 0; m < BATCH; m++) {
+		for (int i = 0; i < 32; i++) {
+			hashes[m * 32 + i] = (uint8_t)(m * 13 + i);
+		}
+		sign_rfc6979(private_keys + (m % KEYS) * 32, hashes + m * 32, 32, recids + m, sigs + m * 64, curve);
+	}
+
+	// All valid, with and without recids
+	if (!verify_rfc6979_batch(keys, hashes, 32, sigs, recids, BATCH, valid, curve)) {
+		printf("Test failed: batch rejected valid signatures.\n");
+		failed = 1;
+	}
+	if (!verify_rfc6979_batch(keys, hashes, 32, sigs, 0, BATCH, valid, curve)) {
+		printf("Test failed: batch without recids rejected valid signatures.\n");
+		failed = 1;
+	}
+
+	// A wrong recid only moves the signature to the fallback; broken entries must be named exactly
+	recids[2] ^= 1;
+	hashes[7 * 32] ^= 1;
+	memset(sigs + 20 * 64 + 32, 0, 32);
+	keys[33 * 64 + 5] ^= 1;
+	if (verify_rfc6979_batch(keys, hashes, 32, sigs, recids, BATCH, valid, curve)) {
+		printf("Test failed: batch accepted invalid signatures.\n");
+		failed = 1;
+	}
+	for (int m = 0; m < BATCH; m++) {
+		int expect_valid = m != 7 && m != 20 && m != 33;
+		if (valid[m] != expect_valid ||
+			valid[m] != verify_rfc6979(keys + m * 64, hashes + m * 32, 32, sigs + m * 64, curve)) {
+			printf("Test failed: batch entry %d.\n", m);
+			failed = 1;
+		}
+	}
+
+	if (!failed) {
+		printf("Test passed.\n");
+	}
+	return failed;
+}